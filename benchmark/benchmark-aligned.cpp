@@ -0,0 +1,60 @@
+/**
+ * \file benchmark-aligned.cpp
+ *
+ * \brief Benchmarks arrays of lazy slots that are each written by a
+ *        different thread, comparing cache-aligned slots with packed ones
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "benchmark.hpp"
+
+#include <lazy/Lazy.hpp>
+
+#include <atomic>
+#include <cstdlib>
+
+namespace {
+
+  const auto slot_count = 8;
+
+  using packed_slot  = lazy::Lazy<long,lazy::double_checked>;
+  using aligned_slot = lazy::Lazy<long,lazy::cache_aligned<lazy::double_checked>>;
+
+  //--------------------------------------------------------------------------
+
+  packed_slot  g_packed_slots[slot_count];
+  aligned_slot g_aligned_slots[slot_count];
+
+  std::atomic<int> g_next_slot(0);
+
+  /// Gets the slot of the calling thread; threads started together have
+  /// distinct slots
+  int current_slot()
+  {
+    thread_local const auto slot = g_next_slot++ % slot_count;
+    return slot;
+  }
+
+} // anonymous namespace
+
+int main( int argc, char** argv )
+{
+  const auto iterations = argc > 1 ? std::atol(argv[1]) : 10000000L;
+  const int  threads[]  = {1, 2, 4, 8};
+
+  for( auto thread_count : threads ) {
+    benchmark::report("Lazy<T,double_checked>[]", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        ++*g_packed_slots[current_slot()];
+      }));
+
+    benchmark::report("Lazy<T,cache_aligned<...>>[]", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        ++*g_aligned_slots[current_slot()];
+      }));
+  }
+
+  for( auto i = 0; i < slot_count; ++i ) {
+    benchmark::do_not_optimize(*g_packed_slots[i] + *g_aligned_slots[i]);
+  }
+}
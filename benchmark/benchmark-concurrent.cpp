@@ -0,0 +1,97 @@
+/**
+ * \file benchmark-concurrent.cpp
+ *
+ * \brief Benchmarks access to a lazily-initialized value shared between
+ *        threads, comparing ConcurrentLazy with the alternatives
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "benchmark.hpp"
+
+#include <lazy/Lazy.hpp>
+#include <lazy/RacyLazy.hpp>
+
+#include <cstdlib>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  using table_type = std::vector<int>;
+
+  std::tuple<std::size_t,int> make_table()
+  {
+    return std::make_tuple(std::size_t(1024),1);
+  }
+
+  //--------------------------------------------------------------------------
+
+  lazy::ConcurrentLazy<table_type>             g_concurrent_lazy(&make_table);
+  lazy::Lazy<table_type,lazy::call_once>       g_call_once_lazy(&make_table);
+  lazy::Lazy<table_type,lazy::racy_idempotent> g_racy_lazy(&make_table);
+  lazy::RacyLazy<table_type>                   g_racy_pointer_lazy(&make_table);
+
+  lazy::Lazy<table_type> g_mutex_lazy(&make_table);
+  std::mutex             g_mutex;
+
+  std::once_flag g_once;
+  table_type*    g_once_table;
+
+  const table_type& function_local_static()
+  {
+    static const table_type table(1024,1);
+    return table;
+  }
+
+  const table_type& call_once()
+  {
+    std::call_once(g_once,[](){ g_once_table = new table_type(1024,1); });
+    return *g_once_table;
+  }
+
+} // anonymous namespace
+
+int main( int argc, char** argv )
+{
+  const auto iterations = argc > 1 ? std::atol(argv[1]) : 10000000L;
+  const int  threads[]  = {1, 2, 4, 8};
+
+  for( auto thread_count : threads ) {
+    benchmark::report("ConcurrentLazy<T>", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        benchmark::do_not_optimize(g_concurrent_lazy->size());
+      }));
+
+    benchmark::report("Lazy<T,call_once>", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        benchmark::do_not_optimize(g_call_once_lazy->size());
+      }));
+
+    benchmark::report("Lazy<T,racy_idempotent>", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        benchmark::do_not_optimize(g_racy_lazy->size());
+      }));
+
+    benchmark::report("RacyLazy<T>", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        benchmark::do_not_optimize(g_racy_pointer_lazy->size());
+      }));
+
+    benchmark::report("std::call_once", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        benchmark::do_not_optimize(call_once().size());
+      }));
+
+    benchmark::report("function-local static", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        benchmark::do_not_optimize(function_local_static().size());
+      }));
+
+    benchmark::report("Lazy<T> guarded by std::mutex", thread_count,
+      benchmark::run(thread_count, iterations / 10, [](){
+        std::lock_guard<std::mutex> lock(g_mutex);
+        benchmark::do_not_optimize(g_mutex_lazy->size());
+      }));
+  }
+}
@@ -0,0 +1,86 @@
+/**
+ * \file benchmark-executor.cpp
+ *
+ * \brief Benchmarks bursts of short tasks, comparing a WorkStealingExecutor
+ *        with starting a thread for each task through std::async
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "benchmark.hpp"
+
+#include <lazy/WorkStealingExecutor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  std::atomic<long> g_runs(0);
+
+  void short_task()
+  {
+    g_runs.fetch_add(1,std::memory_order_relaxed);
+  }
+
+  /// \brief Times \p submit, which submits \p tasks tasks, until they have
+  ///        all run
+  ///
+  /// \return the average number of nanoseconds per task
+  template<typename Submit>
+  double time_burst( long tasks, Submit submit )
+  {
+    g_runs = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    submit();
+    while( g_runs.load() < tasks ) {
+      std::this_thread::yield();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double,std::nano>(end - start).count() / tasks;
+  }
+
+} // anonymous namespace
+
+int main( int argc, char** argv )
+{
+  const auto tasks     = argc > 1 ? std::atol(argv[1]) : 1000000L;
+  const int  threads[] = {1, 2, 4, 8};
+
+  for( auto thread_count : threads ) {
+    lazy::WorkStealingExecutor executor(thread_count);
+
+    // Submitted from outside the pool, and spread across the workers
+    benchmark::report("WorkStealingExecutor", thread_count,
+      time_burst(tasks, [&](){
+        for( auto i = 0L; i < tasks; ++i ) {
+          executor.execute(&short_task);
+        }
+      }));
+
+    // Submitted by one worker, and stolen by the others
+    benchmark::report("WorkStealingExecutor (nested)", thread_count,
+      time_burst(tasks, [&](){
+        executor.execute([&](){
+          for( auto i = 0L; i < tasks; ++i ) {
+            executor.execute(&short_task);
+          }
+        });
+      }));
+  }
+
+  // A thread per task is far slower, so fewer tasks are run
+  const auto async_tasks = tasks / 100;
+  benchmark::report("std::async", 1,
+    time_burst(async_tasks, [&](){
+      auto futures = std::vector<std::future<void>>();
+      for( auto i = 0L; i < async_tasks; ++i ) {
+        futures.push_back(std::async(std::launch::async,&short_task));
+      }
+    }));
+}
@@ -0,0 +1,90 @@
+/**
+ * \file benchmark-refreshable.cpp
+ *
+ * \brief Benchmarks reading a value that is periodically rebuilt, comparing
+ *        RefreshableLazy with the alternatives
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "benchmark.hpp"
+
+#include <lazy/Lazy.hpp>
+#include <lazy/RefreshableLazy.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  using table_type = std::vector<int>;
+
+  std::tuple<std::size_t,int> make_table()
+  {
+    return std::make_tuple(std::size_t(1024),1);
+  }
+
+  //--------------------------------------------------------------------------
+
+  lazy::RefreshableLazy<table_type> g_refreshable_lazy(&make_table);
+
+  std::shared_ptr<const table_type> g_shared_table = std::make_shared<table_type>(1024,1);
+
+  std::shared_ptr<const table_type> g_locked_table = std::make_shared<table_type>(1024,1);
+  std::mutex                        g_mutex;
+
+  //--------------------------------------------------------------------------
+
+  /// Rebuilds each table every millisecond until \p done is set
+  void rebuild( const std::atomic<bool>& done )
+  {
+    while( !done ) {
+      g_refreshable_lazy.refresh();
+
+      std::atomic_store(&g_shared_table,
+                        std::shared_ptr<const table_type>(std::make_shared<table_type>(1024,1)));
+      {
+        auto table = std::make_shared<table_type>(1024,1);
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_locked_table = std::move(table);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+} // anonymous namespace
+
+int main( int argc, char** argv )
+{
+  const auto iterations = argc > 1 ? std::atol(argv[1]) : 10000000L;
+  const int  threads[]  = {1, 2, 4, 8};
+
+  std::atomic<bool> done(false);
+  std::thread writer(rebuild, std::cref(done));
+
+  for( auto thread_count : threads ) {
+    benchmark::report("RefreshableLazy<T>", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        benchmark::do_not_optimize(g_refreshable_lazy->size());
+      }));
+
+    benchmark::report("std::atomic_load(shared_ptr)", thread_count,
+      benchmark::run(thread_count, iterations / 10, [](){
+        benchmark::do_not_optimize(std::atomic_load(&g_shared_table)->size());
+      }));
+
+    benchmark::report("shared_ptr guarded by std::mutex", thread_count,
+      benchmark::run(thread_count, iterations / 10, [](){
+        std::lock_guard<std::mutex> lock(g_mutex);
+        benchmark::do_not_optimize(g_locked_table->size());
+      }));
+  }
+
+  done = true;
+  writer.join();
+}
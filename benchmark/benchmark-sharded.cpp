@@ -0,0 +1,54 @@
+/**
+ * \file benchmark-sharded.cpp
+ *
+ * \brief Benchmarks a counter incremented from many threads, comparing a
+ *        ShardedLazy with a single shared ConcurrentLazy
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "benchmark.hpp"
+
+#include <lazy/Lazy.hpp>
+#include <lazy/ShardedLazy.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <tuple>
+
+namespace {
+
+  using counter_type = std::atomic<long>;
+
+  std::tuple<long> make_counter()
+  {
+    return std::make_tuple(0L);
+  }
+
+  //--------------------------------------------------------------------------
+
+  lazy::ShardedLazy<counter_type>    g_sharded_lazy(&make_counter);
+  lazy::ConcurrentLazy<counter_type> g_concurrent_lazy(&make_counter);
+
+} // anonymous namespace
+
+int main( int argc, char** argv )
+{
+  const auto iterations = argc > 1 ? std::atol(argv[1]) : 10000000L;
+  const int  threads[]  = {1, 2, 4, 8};
+
+  for( auto thread_count : threads ) {
+    benchmark::report("ShardedLazy<T>", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        g_sharded_lazy->fetch_add(1,std::memory_order_relaxed);
+      }));
+
+    benchmark::report("ConcurrentLazy<T>", thread_count,
+      benchmark::run(thread_count, iterations, [](){
+        g_concurrent_lazy->fetch_add(1,std::memory_order_relaxed);
+      }));
+  }
+
+  benchmark::do_not_optimize(g_sharded_lazy.combine(0L,[]( long total, counter_type& count ){
+    return total + count.load();
+  }));
+}
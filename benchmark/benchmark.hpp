@@ -0,0 +1,76 @@
+/**
+ * \file benchmark.hpp
+ *
+ * \brief A minimal harness for timing operations from one or more threads
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#ifndef LAZY_BENCHMARK_BENCHMARK_HPP_
+#define LAZY_BENCHMARK_BENCHMARK_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace benchmark{
+
+  /// \brief Prevents the compiler from optimizing away \p value
+  template<typename T>
+  inline void do_not_optimize( const T& value )
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+  }
+
+  /// \brief Times \p iterations calls to \p operation on each of
+  ///        \p threads threads, all starting at once
+  ///
+  /// \return the average number of nanoseconds per call
+  template<typename Operation>
+  inline double run( int threads, long iterations, Operation operation )
+  {
+    std::atomic<int> ready(0);
+    std::atomic<bool> go(false);
+    std::vector<std::thread> workers;
+
+    for( auto i = 0; i < threads; ++i ) {
+      workers.emplace_back([&](){
+        ++ready;
+        while( !go.load() ) {
+          std::this_thread::yield();
+        }
+        for( auto j = 0L; j < iterations; ++j ) {
+          operation();
+        }
+      });
+    }
+    while( ready.load() < threads ) {
+      std::this_thread::yield();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    go = true;
+    for( auto& worker : workers ) {
+      worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto nanoseconds = std::chrono::duration<double,std::nano>(end - start).count();
+    return nanoseconds / iterations;
+  }
+
+  /// \brief Prints the result of a single benchmark
+  inline void report( const char* name, int threads, double nanoseconds )
+  {
+    std::printf("%-32s %4d threads %10.2f ns/op\n", name, threads, nanoseconds);
+  }
+
+} // namespace benchmark
+
+#endif /* LAZY_BENCHMARK_BENCHMARK_HPP_ */
@@ -0,0 +1,338 @@
+/**
+ * \file AsyncLazy.hpp
+ *
+ * \brief This file contains \c lazy::AsyncLazy<T>, a lazy value that is
+ *        constructed in the background on an executor.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \copyright Matthew Rodusek
+ */
+
+#ifndef LAZY_ASYNCLAZY_HPP_
+#define LAZY_ASYNCLAZY_HPP_
+
+#include "Lazy.hpp"
+#include "detail/executor_ref.hpp"
+#include "detail/owned_value.hpp"
+#include "WorkStealingExecutor.hpp"
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if LAZY_HAS_COROUTINES
+# include <coroutine>
+#endif
+
+namespace lazy{
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A lazy-loaded \c T that is constructed in the background, on an
+  ///        executor
+  ///
+  /// The \c T is constructed with the same construction and destruction
+  /// functions as a \c Lazy<T>, but as a task submitted to an executor: any
+  /// object \c e for which \c e.execute(f) runs the nullary function \c f on
+  /// some thread, and \c default_executor() if none is given. Construction
+  /// starts on the first call to \c start,
+  /// \c get_future, or \c get; calling \c start right after construction
+  /// starts it eagerly.
+  ///
+  /// This lets a slow construction function run while the caller does other
+  /// work, which only blocks, in \c get or on the future, at the point where
+  /// the \c T is actually used. Any number of threads may start and wait for
+  /// the \c T at once; it is constructed exactly once.
+  ///
+  /// If the construction function throws, the exception is stored, and is
+  /// rethrown by every \c get; construction is not retried.
+  ///
+  /// Where C++20 coroutines are available (\c LAZY_HAS_COROUTINES), an
+  /// \c AsyncLazy may also be awaited with \c co_await, which suspends the
+  /// coroutine until the \c T is constructed instead of blocking its thread.
+  /// Awaiting an \c AsyncLazy that is ready completes immediately, without
+  /// allocating.
+  ///
+  /// \note \c Lazy and \c ConcurrentLazy are not awaitable: they construct
+  ///       their \c T on the accessing thread, and have no executor to
+  ///       resume a suspended coroutine on, so awaiting one could only block
+  ///       like \c operator*. An \c AsyncLazy is the way to await a lazy
+  ///       value.
+  ///
+  /// \note The executor is referred to, not copied, and must outlive the
+  ///       \c AsyncLazy. Once construction has started, the destructor waits
+  ///       for it to finish, so the executor must eventually run every task
+  ///       it is given.
+  ///
+  /// \tparam T the type of the value
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  class AsyncLazy final
+  {
+    //------------------------------------------------------------------------
+    // Public Member Types
+    //------------------------------------------------------------------------
+  public:
+
+    using this_type = AsyncLazy<T>; ///< Instance of this type
+
+    using value_type  = T;                        ///< The underlying type of this AsyncLazy
+    using pointer     = T*;                       ///< The pointer type of the AsyncLazy
+    using reference   = T&;                       ///< The reference type of the AsyncLazy
+    using future_type = std::shared_future<T&>;   ///< The future of the T
+
+#if LAZY_HAS_COROUTINES
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief The awaiter of an \c AsyncLazy, which resumes the awaiting
+    ///        coroutine once the \c T is constructed
+    ///
+    /// The awaiting coroutine is resumed on the thread that constructed the
+    /// \c T, or immediately if it already has been.
+    ///
+    /// \note The \c AsyncLazy must outlive the coroutines awaiting it
+    //////////////////////////////////////////////////////////////////////////
+    class awaiter
+    {
+    public:
+
+      awaiter( const awaiter& ) = delete;
+      awaiter& operator=( const awaiter& ) = delete;
+
+      /// \brief Checks whether the \c T is already constructed
+      ///
+      /// \return \c true if construction has finished
+      bool await_ready() const noexcept;
+
+      /// \brief Starts construction, unless it has been started, and
+      ///        suspends \p handle until it has finished
+      ///
+      /// \param handle the awaiting coroutine
+      /// \return \c false if construction has already finished, and
+      ///         \p handle should not be suspended
+      bool await_suspend( std::coroutine_handle<> handle );
+
+      /// \brief Gets the \c T
+      ///
+      /// \throw any exception thrown by the construction function
+      /// \return a reference to the \c T
+      reference await_resume() const;
+
+    private:
+
+      explicit awaiter( const this_type& lazy ) noexcept;
+
+      const this_type*        m_lazy;   ///< The AsyncLazy being awaited
+      std::coroutine_handle<> m_handle; ///< The suspended coroutine
+      awaiter*                m_next;   ///< The next suspended awaiter
+
+      friend class AsyncLazy<T>;
+    };
+
+#endif
+
+    //------------------------------------------------------------------------
+    // Construction / Destruction / Assignment
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs an \c AsyncLazy that default-constructs the \c T on
+    ///        the default executor
+    AsyncLazy( );
+
+    /// \brief Constructs an \c AsyncLazy given the \p constructor function,
+    ///        which is invoked on the default executor
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    template<
+      typename Ctor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type
+    >
+    explicit AsyncLazy( Ctor&& constructor );
+
+    /// \brief Constructs an \c AsyncLazy given the \p constructor and
+    ///        \p destructor functions, where \p constructor is invoked on the
+    ///        default executor
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    /// \param destructor  function to use prior to destruction
+    template<
+      typename Ctor,
+      typename Dtor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Dtor>>::value>::type
+    >
+    AsyncLazy( Ctor&& constructor, Dtor&& destructor );
+
+    /// \brief Constructs an \c AsyncLazy that copy-constructs the \c T from
+    ///        \p value on the default executor
+    ///
+    /// \param value the value to copy
+    explicit AsyncLazy( const value_type& value );
+
+    /// \brief Constructs an \c AsyncLazy that default-constructs the \c T on
+    ///        \p executor
+    ///
+    /// \param executor the executor to construct the \c T on
+    template<
+      typename Executor,
+      typename = typename std::enable_if<detail::is_executor<Executor>::value>::type
+    >
+    explicit AsyncLazy( Executor& executor );
+
+    /// \brief Constructs an \c AsyncLazy given the \p constructor function,
+    ///        which is invoked on \p executor
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param executor    the executor to construct the \c T on
+    /// \param constructor function to use for construction
+    template<
+      typename Executor,
+      typename Ctor,
+      typename = typename std::enable_if<detail::is_executor<Executor>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type
+    >
+    AsyncLazy( Executor& executor, Ctor&& constructor );
+
+    /// \brief Constructs an \c AsyncLazy given the \p constructor and
+    ///        \p destructor functions, where \p constructor is invoked on
+    ///        \p executor
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param executor    the executor to construct the \c T on
+    /// \param constructor function to use for construction
+    /// \param destructor  function to use prior to destruction
+    template<
+      typename Executor,
+      typename Ctor,
+      typename Dtor,
+      typename = typename std::enable_if<detail::is_executor<Executor>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Dtor>>::value>::type
+    >
+    AsyncLazy( Executor& executor, Ctor&& constructor, Dtor&& destructor );
+
+    /// \brief Constructs an \c AsyncLazy that copy-constructs the \c T from
+    ///        \p value on \p executor
+    ///
+    /// \param executor the executor to construct the \c T on
+    /// \param value    the value to copy
+    template<
+      typename Executor,
+      typename = typename std::enable_if<detail::is_executor<Executor>::value>::type
+    >
+    AsyncLazy( Executor& executor, const value_type& value );
+
+    AsyncLazy( const this_type& ) = delete;
+    this_type& operator=( const this_type& ) = delete;
+
+    /// \brief Waits for construction to finish, if it has started, and
+    ///        destroys the \c T
+    ~AsyncLazy();
+
+    //------------------------------------------------------------------------
+    // Modifiers
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Submits the construction of the \c T to the executor, unless
+    ///        it has already been started
+    ///
+    /// If the executor throws, its exception is stored as the result of
+    /// construction, and is rethrown by every \c get.
+    void start() const;
+
+    //------------------------------------------------------------------------
+    // Observers
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Checks whether construction has finished, successfully or not
+    ///
+    /// \return \c true if construction has finished
+    bool is_ready() const;
+
+    /// \brief Gets the future of the \c T, starting its construction if
+    ///        necessary
+    ///
+    /// \return the future of the \c T
+    future_type get_future() const;
+
+    /// \brief Gets the \c T, starting its construction if necessary, and
+    ///        waiting for it to finish
+    ///
+    /// \throw any exception thrown by the construction function
+    /// \return a reference to the \c T
+    reference get() const;
+
+#if LAZY_HAS_COROUTINES
+
+    /// \brief Awaits the \c T, starting its construction if necessary
+    ///
+    /// \return the awaiter
+    awaiter operator co_await() const noexcept;
+
+#endif
+
+    //------------------------------------------------------------------------
+    // Private Member Types
+    //------------------------------------------------------------------------
+  private:
+
+    using value_node_type = detail::owned_value<T>;
+
+    //------------------------------------------------------------------------
+    // Private Members
+    //------------------------------------------------------------------------
+  private:
+
+    detail::erased_function<T>               m_function; ///< The functions the T is constructed with
+    detail::executor_ref                     m_executor; ///< The executor to construct the T on
+    mutable std::unique_ptr<value_node_type> m_value;     ///< The T, once constructed
+    mutable std::exception_ptr               m_exception; ///< The exception from construction, if any
+    mutable std::promise<T&>                 m_promise;   ///< Taken by the construction task
+    future_type                              m_future;    ///< The future of the T
+    mutable std::atomic<bool>                m_started;   ///< Whether construction has started
+    mutable std::atomic<void*>               m_awaiters;  ///< The suspended awaiters, or this once ready
+
+    //------------------------------------------------------------------------
+    // Private Member Functions
+    //------------------------------------------------------------------------
+  private:
+
+    /// \brief Constructs the \c T, and fulfils the future of \p self
+    ///
+    /// \param self the \c AsyncLazy to construct
+    static void construct( void* self );
+
+    /// \brief Publishes the result of construction to the future of \p lazy
+    ///        and its awaiters
+    ///
+    /// \param lazy    the \c AsyncLazy that finished construction
+    /// \param promise the promise of \p lazy's future
+    static void finish( this_type* lazy, std::promise<T&> promise );
+
+    /// \brief Gets the value of \c m_awaiters once construction has
+    ///        finished
+    ///
+    /// \return a pointer to this \c AsyncLazy
+    void* ready_state() const noexcept;
+  };
+
+} // namespace lazy
+
+#include "detail/AsyncLazy.inl"
+
+#endif /* LAZY_ASYNCLAZY_HPP_ */
@@ -3,8 +3,11 @@
  *
  * \brief This is the main include file for the \c Lazy library.
  *
- * Including this gives access to \c lazy::Lazy<T> and the utility
- * \c lazy::make_lazy functions.
+ * Including this gives access to \c lazy::Lazy<T>, the thread-safe
+ * \c lazy::ConcurrentLazy<T>, the statically-typed
+ * \c lazy::BasicLazy<T,CtorFunc,DtorFunc,Policy>, and the utility
+ * \c lazy::make_lazy functions. The other lazy types, executors and
+ * algorithms each have their own header under \c lazy/.
  *
  *
  * \author Matthew Rodusek (matthew.rodusek@gmail.com)
@@ -39,46 +42,136 @@
 #ifndef LAZY_LAZY_HPP_
 #define LAZY_LAZY_HPP_
 
+#include "detail/lazy_config.hpp"
 #include "detail/lazy_traits.hpp"
+#include "detail/compressed_pair.hpp"
+#include "detail/lazy_function.hpp"
+#include "detail/lazy_policy.hpp"
+#include "detail/lazy_storage.hpp"
 
 #include <type_traits>
 #include <functional>
 #include <tuple>
+#include <cassert>
 
 namespace lazy{
 
   ////////////////////////////////////////////////////////////////////////////
-  /// \brief Lazy class used for lazy-loading any type
+  /// \brief The default construction function for a \c BasicLazy
+  ///
+  /// This constructs \c T with its default constructor
+  ///
+  /// \tparam T the type being constructed
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  struct default_constructor
+  {
+    /// \brief Returns the (empty) arguments for \c T's default constructor
+    ///
+    /// \return an empty tuple
+    std::tuple<> operator()() const noexcept;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The default destruction function for a \c BasicLazy
+  ///
+  /// This performs no additional work prior to \c T's destructor
+  ///
+  /// \tparam T the type being destructed
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  struct default_destructor
+  {
+    /// \brief Does nothing
+    ///
+    /// \param x the \c T type to be destructed
+    void operator()( T& x ) const noexcept;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief Lazy class used for lazy-loading any type, using statically
+  ///        typed construction and destruction functions
   ///
   /// The stored lazy-loaded class, \c T, will always be instantiated
   /// before being accessed, and destructed when put out of scope.
   ///
-  /// \tparam T the type contained within this \c Lazy
+  /// The construction and destruction functions are stored inline by type,
+  /// which allows the compiler to inline them and avoids any allocations.
+  /// Stateless function objects take up no space in the \c BasicLazy.
+  ///
+  /// If \c T is trivially destructible and \c DtorFunc is the
+  /// \c default_destructor, there is nothing to do on destruction, and the
+  /// \c BasicLazy is itself trivially destructible.
+  ///
+  /// \note The \p CtorFunc function must return a \c std::tuple containing
+  ///       the arguments to pass to \c T's constructor for lazy-construction
+  ///
+  /// The \p Policy controls whether the \c BasicLazy may be initialized
+  /// from multiple threads at once; see \c single_threaded,
+  /// \c double_checked, \c call_once, and \c racy_idempotent.
+  ///
+  /// \tparam T        the type contained within this \c BasicLazy
+  /// \tparam CtorFunc the type of the function to use for construction
+  /// \tparam DtorFunc the type of the function to use prior to destruction
+  /// \tparam Policy   the threading policy to use for initialization
   ////////////////////////////////////////////////////////////////////////////
-  template<typename T>
-  class Lazy final
+  template<
+    typename T,
+    typename CtorFunc = default_constructor<T>,
+    typename DtorFunc = default_destructor<T>,
+    typename Policy   = single_threaded
+  >
+  class BasicLazy final
+    : private detail::lazy_storage_t<T,CtorFunc,DtorFunc,Policy>
   {
     //------------------------------------------------------------------------
     // Public Member Types
     //------------------------------------------------------------------------
   public:
 
-    using this_type = Lazy<T>; ///< Instance of this type
+    using this_type = BasicLazy<T,CtorFunc,DtorFunc,Policy>; ///< Instance of this type
 
     using value_type = T;  ///< The underlying type of this Lazy
     using pointer    = T*; ///< The pointer type of the Lazy
     using reference  = T&; ///< The reference type of the Lazy
 
+    using constructor_type = CtorFunc; ///< The type of the construction function
+    using destructor_type  = DtorFunc; ///< The type of the destruction function
+    using policy_type      = Policy;   ///< The threading policy
+
     //------------------------------------------------------------------------
     // Construction / Destruction / Assignment
     //------------------------------------------------------------------------
   public:
 
     /// \brief Default constructor; no initialization takes place
-    Lazy( );
+    ///
+    /// The construction and destruction functions are default-constructed
+    ///
+    /// \note This is \c constexpr, so a \c BasicLazy (or \c Lazy) at
+    ///       namespace scope is constant-initialized, and costs nothing
+    ///       until it is first used
+    constexpr BasicLazy( );
 
-    /// \brief Constructs a \c Lazy given the \p constructor and \p destructor
-    ///        functions
+    /// \brief Constructs a \c BasicLazy given the \p constructor function
+    ///
+    /// The destruction function is default-constructed
+    ///
+    /// \note This is \c constexpr when \c CtorFunc can be constructed from
+    ///       \p constructor at compile-time, such as for stateless functors
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    template<
+      typename Ctor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type
+    >
+    constexpr explicit BasicLazy( Ctor&& constructor );
+
+    /// \brief Constructs a \c BasicLazy given the \p constructor and
+    ///        \p destructor functions
     ///
     /// \note The \p constructor function must return a \c std::tuple containing
     ///       the arguments to pass to \c T's constructor for lazy-construction
@@ -86,82 +179,99 @@ namespace lazy{
     /// \param constructor function to use for construction
     /// \param destructor  function to use prior to destruction
     template<
-      typename CtorFunc,
-      typename DtorFunc = void(value_type&),
-      typename = typename std::enable_if<detail::is_callable<CtorFunc>::value>::type,
-      typename = typename std::enable_if<detail::is_callable<DtorFunc>::value>::type
+      typename Ctor,
+      typename Dtor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Dtor>>::value>::type
     >
-    explicit Lazy( const CtorFunc& constructor,
-                   const DtorFunc& destructor = default_destructor );
+    constexpr BasicLazy( Ctor&& constructor, Dtor&& destructor );
 
-    /// \brief Constructs a \c Lazy by copying another \c Lazy
+    /// \brief Constructs a \c BasicLazy by copying another \c BasicLazy
     ///
     /// \note If \p rhs is initialized, then this copy will also be initialized
     ///
-    /// \param rhs the \c Lazy to copy
-    Lazy( const Lazy<T>& rhs );
+    /// \param rhs the \c BasicLazy to copy
+    BasicLazy( const this_type& rhs );
 
-    /// \brief Constructs a \c Lazy by moving another \c Lazy
+    /// \brief Constructs a \c BasicLazy by moving another \c BasicLazy
     ///
     /// \note If \p rhs is initialized, then this moved version will
     ///       also be initialized
     ///
-    /// \param rhs the \c Lazy to move
-    Lazy( Lazy<T>&& rhs );
+    /// \note The construction function never refers back to the \c BasicLazy
+    ///       that owns it, so a moved \c BasicLazy will always construct into
+    ///       its own storage. This is \c noexcept whenever moving \c T and
+    ///       the functions is, allowing containers to relocate it by moving.
+    ///
+    /// \param rhs the \c BasicLazy to move
+    BasicLazy( this_type&& rhs )
+      noexcept( std::is_nothrow_move_constructible<T>::value &&
+                std::is_nothrow_move_constructible<CtorFunc>::value &&
+                std::is_nothrow_move_constructible<DtorFunc>::value );
 
-    /// \brief Constructs a \c Lazy by calling \c T's copy constructor
+    /// \brief Constructs a \c BasicLazy by calling \c T's copy constructor
+    ///
+    /// \note This does not initialize the \c BasicLazy. Instead, it stores
+    ///       this value as a copy and move-constructs it later, if necessary
     ///
-    /// \note This does not initialize the \c Lazy. Instead, it stores this value as
-    ///       a copy and move-constructs it later, if necessary
+    /// \note This requires \c CtorFunc to be constructible from a \c T
     ///
     /// \param rhs the \c T to copy
-    explicit Lazy( const value_type& rhs );
+    explicit BasicLazy( const value_type& rhs );
 
-    /// \brief Constructs a \c Lazy from a given rvalue \c T
+    /// \brief Constructs a \c BasicLazy from a given rvalue \c T
     ///
-    /// \note This does not initialize the \c Lazy. Instead, it stores this value as
-    ///       a copy and move-constructs it later, if necessary
+    /// \note This does not initialize the \c BasicLazy. Instead, it stores
+    ///       this value as a copy and move-constructs it later, if necessary
+    ///
+    /// \note This requires \c CtorFunc to be constructible from a \c T
     ///
     /// \param rhs the \c T to move
-    explicit Lazy( value_type&& rhs );
-
-    //------------------------------------------------------------------------
+    explicit BasicLazy( value_type&& rhs );
 
-    /// \brief Destructs this \c Lazy and it's \c T
-    ~Lazy( );
 
     //------------------------------------------------------------------------
 
-    /// \brief Assigns a \c Lazy to this \c Lazy
+    /// \brief Assigns a \c BasicLazy to this \c BasicLazy
     ///
-    /// \note This will construct a new \c T if the \c Lazy is not already
-    ///       initialized, otherwise it will assign
+    /// \note If \p rhs is initialized, this will copy-construct a new \c T if
+    ///       the \c BasicLazy is not already initialized, otherwise it will
+    ///       assign
     ///
-    /// \param rhs the \c Lazy on the right-side of the assignment
+    /// \note This requires \c CtorFunc and \c DtorFunc to be copy-assignable
+    ///
+    /// \param rhs the \c BasicLazy on the right-side of the assignment
     /// \return reference to (*this)
     this_type& operator=( const this_type& rhs );
 
-    /// \brief Assigns a \c Lazy to this \c Lazy
+    /// \brief Assigns a \c BasicLazy to this \c BasicLazy
     ///
-    /// \note This will construct a new \c T if the \c Lazy is not already
-    ///       initialized, otherwise it will assign
+    /// \note If \p rhs is initialized, this will move-construct a new \c T if
+    ///       the \c BasicLazy is not already initialized, otherwise it will
+    ///       assign
     ///
-    /// \param rhs the rvalue \c Lazy on the right-side of the assignment
+    /// \note This requires \c CtorFunc and \c DtorFunc to be move-assignable
+    ///
+    /// \param rhs the rvalue \c BasicLazy on the right-side of the assignment
     /// \return reference to (*this)
-    this_type& operator=( this_type&& rhs );
+    this_type& operator=( this_type&& rhs )
+      noexcept( std::is_nothrow_move_constructible<T>::value &&
+                std::is_nothrow_move_assignable<T>::value &&
+                std::is_nothrow_move_assignable<CtorFunc>::value &&
+                std::is_nothrow_move_assignable<DtorFunc>::value );
 
-    /// \brief Assigns a \c T to this \c Lazy
+    /// \brief Assigns a \c T to this \c BasicLazy
     ///
-    /// \note This will construct a new \c T if the \c Lazy is not already
+    /// \note This will construct a new \c T if the \c BasicLazy is not already
     ///       initialized, otherwise it will assign
     ///
     /// \param rhs the \c T on the right-side of the assignment
     /// \return reference to (\c ptr())
     value_type& operator=( const value_type& rhs );
 
-    /// \brief Assigns an rvalue \c T to this \c Lazy
+    /// \brief Assigns an rvalue \c T to this \c BasicLazy
     ///
-    /// \note This will construct a new \c T if the \c Lazy is not already
+    /// \note This will construct a new \c T if the \c BasicLazy is not already
     ///       initialized, otherwise it will assign
     ///
     /// \param rhs the \c T on the right-side of the assignment
@@ -173,12 +283,12 @@ namespace lazy{
     //------------------------------------------------------------------------
   public:
 
-    /// \brief Converts this \c Lazy into a reference
+    /// \brief Converts this \c BasicLazy into a reference
     ///
     /// \return the reference to the lazy-loaded object
     explicit operator reference() const;
 
-    /// \brief Checks whether this \c Lazy has an instantiated object
+    /// \brief Checks whether this \c BasicLazy has an instantiated object
     ///
     /// \return \c true if this lazy has an instantiated object
     explicit operator bool() const noexcept;
@@ -190,10 +300,14 @@ namespace lazy{
 
     /// \brief Swapperator class for no-exception swapping
     ///
+    /// Initialized values are swapped if both \c BasicLazy objects are
+    /// initialized; otherwise the initialized value (if any) is moved
+    /// into the other \c BasicLazy.
+    ///
     /// \param rhs the rhs to swap
-    void swap(Lazy<T>& rhs) noexcept;
+    void swap(this_type& rhs) noexcept;
 
-    /// \brief Boolean to check if this \c Lazy is initialized.
+    /// \brief Boolean to check if this \c BasicLazy is initialized.
     ///
     /// \return \c true if the underlying type \c T is initialized.
     bool is_initialized() const noexcept;
@@ -205,112 +319,265 @@ namespace lazy{
     /// \return the pointer to the underlying type
     pointer get() const;
 
-    /// \brief Dereferences this \c Lazy object into the lazy-loaded object
+    /// \brief Gets a pointer to the underlying type, without initializing
+    ///        this \c BasicLazy
+    ///
+    /// \return the pointer to the underlying type, or \c nullptr if this
+    ///         \c BasicLazy is not initialized
+    pointer try_get() const noexcept;
+
+    /// \brief Gets a pointer to the underlying type, which must already be
+    ///        initialized
+    ///
+    /// Unlike \c get(), this does not check whether the \c T needs to be
+    /// constructed. This is asserted in debug builds only.
+    ///
+    /// \return the pointer to the underlying type
+    pointer unchecked_get() const noexcept;
+
+    /// \brief Gets a copy of the underlying type if this \c BasicLazy is
+    ///        initialized, otherwise \p fallback, without initializing
+    ///        this \c BasicLazy
+    ///
+    /// \param fallback the value to use if this is not initialized
+    /// \return a copy of the underlying type, or \p fallback
+    template<typename U>
+    value_type value_or( U&& fallback ) const;
+
+    /// \brief Dereferences this \c BasicLazy object into the lazy-loaded object
     ///
     /// \return a constant reference to the lazy-loaded object
     reference operator*() const;
 
-    /// \brief Dereferences this \c Lazy object into the lazy-loaded object
+    /// \brief Dereferences this \c BasicLazy object into the lazy-loaded object
     ///
     /// \return a pointer to the lazy-loaded object
     pointer operator->() const;
 
+    /// \brief Submits the construction of the \c T to \p executor, unless
+    ///        it is already constructed
+    ///
+    /// This starts a slow construction ahead of the first access, for
+    /// example while waiting on I/O. An access made while the submitted
+    /// construction is running waits for it, rather than constructing a
+    /// second \c T (except with the racy policies, where both may run). An
+    /// exception thrown by the submitted construction is discarded, and left
+    /// for the next access to encounter.
+    ///
+    /// \note This requires a thread-safe policy, such as that of
+    ///       \c ConcurrentLazy. The \c BasicLazy must outlive the submitted
+    ///       task.
+    ///
+    /// \param executor any object for which \c executor.execute(f) runs the
+    ///                 nullary function \c f on some thread
+    template<typename Executor>
+    void prefetch( Executor& executor ) const;
+
+    /// \brief Gets the number of bytes of state retained by the construction
+    ///        function, including any arguments captured for it
+    ///
+    /// \note Type-erased construction functions (such as those used by
+    ///       \c Lazy) are released, along with their captured arguments, as
+    ///       soon as the \c T has been constructed; after which this
+    ///       returns \c 0.
+    ///
+    /// \return the number of bytes retained by the construction function
+    std::size_t retained_bytes() const noexcept;
+
     //------------------------------------------------------------------------
     // Private Member Types
     //------------------------------------------------------------------------
   private:
 
-    /// \brief Constructor tag for tag-dispatching VA Arguments
-    struct ctor_va_args_tag{};
+    using base_type = detail::lazy_storage_t<T,CtorFunc,DtorFunc,Policy>;
 
-    using unqualified_pointer = typename std::remove_cv<T>::type*;
-    using ctor_function_type  = std::function<void()>;
-    using dtor_function_type  = std::function<void(T&)>;
+    using typename base_type::unqualified_pointer;
+    using typename base_type::storage_type;
 
-    using storage_type = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The operations that the state of the \p Policy uses to
+    ///        initialize a \c BasicLazy
+    ///
+    /// Policies that construct the \c T exclusively only use \c construct.
+    /// Policies that allow several threads to race on construction instead
+    /// construct a \c T in their own storage with \c construct_at, and then
+    /// either publish it with \c relocate_from, or discard it with
+    /// \c destroy_at.
+    ////////////////////////////////////////////////////////////////////////////
+    class initializer
+    {
+    public:
+
+      /// \brief Storage suitable for constructing a \c T in
+      using storage_type = typename this_type::storage_type;
+
+      /// \brief Constructs an \c initializer for \p lazy
+      ///
+      /// \param lazy the \c BasicLazy being initialized
+      explicit initializer( const this_type& lazy ) noexcept;
+
+      /// \brief Constructs the \c T in the \c BasicLazy
+      ///
+      /// \note This releases the construction function once the \c T has
+      ///       been constructed, so it may only be called by one thread at a
+      ///       time
+      void construct() const;
+
+      /// \brief Constructs a \c T at \p where, without consuming the
+      ///        construction function
+      ///
+      /// \note This may be called from several threads at once, provided
+      ///       the construction function may be
+      ///
+      /// \param where the address to construct the \c T at
+      void construct_at( void* where ) const;
+
+      /// \brief Moves the \c T at \p where into the \c BasicLazy, and
+      ///        destroys it
+      ///
+      /// \param where the address of the \c T constructed by \c construct_at
+      void relocate_from( void* where ) const;
+
+      /// \brief Destroys the \c T at \p where, invoking the destruction
+      ///        function first
+      ///
+      /// \param where the address of the \c T constructed by \c construct_at
+      void destroy_at( void* where ) const;
+
+    private:
+
+      const this_type& m_lazy; ///< The BasicLazy being initialized
+    };
 
     //------------------------------------------------------------------------
     // Private Members
     //------------------------------------------------------------------------
   private:
 
-    mutable storage_type m_storage;        ///< The storage to hold the lazy type
-    mutable bool         m_is_initialized; ///< Is the type initialized?
-    ctor_function_type   m_constructor;    ///< The construction function
-    dtor_function_type   m_destructor;     ///< The destruction function
+    using base_type::m_state;
+    using base_type::m_functions;
 
     //------------------------------------------------------------------------
-    // Private Static Member Functions
+    // Private Member Functions
     //------------------------------------------------------------------------
   private:
 
-    /// \brief A default destructor function for this Lazy object
+    using base_type::ptr;
+    using base_type::destruct;
+
+    /// \brief Initializes the \c BasicLazy, if it is not already initialized
     ///
-    /// \param x the \c T type to be destructed
-    static void default_destructor( value_type& x ) noexcept;
+    /// This is the hot path of every accessor, and is kept to a single
+    /// check of the initialized flag
+    void lazy_construct() const;
 
-    //------------------------------------------------------------------------
-    // Private Constructor
-    //------------------------------------------------------------------------
-  private:
+    /// \brief Forcibly initializes the \c BasicLazy
+    ///
+    /// This is kept out-of-line and marked cold so that the construction
+    /// function is not inlined into (and does not bloat) every accessor
+    LAZY_NOINLINE LAZY_COLD void initialize() const;
 
-    /// \brief Constructs a \c Lazy by constructing it's \c T with its constructor
+    /// \brief Constructs the \c T using a construction function that
+    ///        constructs directly into storage, releasing the function
+    ///        afterwards
     ///
-    /// \param tag  unused tag for dispatching to VA constructor
-    /// \param args arguments to \c T's constructor
-    template<typename...Args>
-    explicit Lazy( ctor_va_args_tag tag, Args&&...args );
+    /// \param tag the tag for tag-dispatching
+    void construct_with_function( std::true_type tag ) const;
 
-    //------------------------------------------------------------------------
-    // Private Member Functions
-    //------------------------------------------------------------------------
-  private:
+    /// \brief Constructs the \c T using a construction function that returns
+    ///        a \c std::tuple of arguments
+    ///
+    /// \param tag the tag for tag-dispatching
+    void construct_with_function( std::false_type tag ) const;
 
-    /// \brief Gets a pointer to the data stored in this \c Laz
+    /// \brief Constructs the \c T with a construction function that
+    ///        constructs directly into storage, releasing the function only
+    ///        if the \c T is not the sentinel value of the policy
     ///
-    /// \return the constant pointer to the object
-    unqualified_pointer ptr() const noexcept;
+    /// \param tag the tag for tag-dispatching
+    void consume_function( std::true_type tag ) const;
 
-    /// \brief Forcibly initializes the \c Lazy
-    void lazy_construct() const;
+    /// \brief Constructs the \c T with a construction function that
+    ///        constructs directly into storage, releasing the function
+    ///        afterwards
+    ///
+    /// \param tag the tag for tag-dispatching
+    void consume_function( std::false_type tag ) const;
+
+    /// \brief Constructs a \c T at \p where, without consuming a
+    ///        construction function that constructs directly into storage
+    ///
+    /// \param where the address to construct the \c T at
+    /// \param tag   the tag for tag-dispatching
+    void construct_with_function( void* where, std::true_type tag ) const;
+
+    /// \brief Constructs a \c T at \p where using a construction function
+    ///        that returns a \c std::tuple of arguments
+    ///
+    /// \param where the address to construct the \c T at
+    /// \param tag   the tag for tag-dispatching
+    void construct_with_function( void* where, std::false_type tag ) const;
+
+    /// \brief Gets the number of bytes retained by a construction function
+    ///        that constructs directly into storage
+    ///
+    /// \param tag the tag for tag-dispatching
+    std::size_t retained_bytes( std::true_type tag ) const noexcept;
+
+    /// \brief Gets the number of bytes retained by a construction function
+    ///        that returns a \c std::tuple of arguments
+    ///
+    /// \param tag the tag for tag-dispatching
+    std::size_t retained_bytes( std::false_type tag ) const noexcept;
 
-    /// \brief Constructs a \c Lazy object using \c T's copy constructor
+    /// \brief Constructs a \c BasicLazy object using \c T's copy constructor
     ///
     /// \param x Instance of \c T to copy.
     void construct( const value_type& x ) const;
 
-    /// \brief Constructs a \c Lazy object using \c T's move constructor
+    /// \brief Constructs a \c BasicLazy object using \c T's move constructor
     ///
     /// \param x Instance of rvalue \c T to copy
     void construct( value_type&& x ) const;
 
-    /// \brief Constructs a \c Lazy object using the arguments for \c T's constructor
+    /// \brief Constructs the \c T from \p x in the storage of a sentinel
+    ///        policy, in place of the sentinel
+    ///
+    /// \param x   the value to construct the \c T from
+    /// \param tag the tag for tag-dispatching
+    template<typename U>
+    void construct_value( U&& x, std::true_type tag ) const;
+
+    /// \brief Constructs the \c T from \p x in storage that holds no object
     ///
-    /// \param tag  tag to dispatch to this VA args constructor
-    /// \param args the arguments to forward to the constructor
-    template<typename...Args>
-    void construct( ctor_va_args_tag tag, Args&&...args ) const;
+    /// \param x   the value to construct the \c T from
+    /// \param tag the tag for tag-dispatching
+    template<typename U>
+    void construct_value( U&& x, std::false_type tag ) const;
+
+    //------------------------------------------------------------------------
 
-    /// \brief Constructs a \c Lazy object using the arguments provided in a
-    ///        \c std::tuple for \c T's constructor
+    /// \brief Releases the construction function, if it supports being
+    ///        released
     ///
-    /// \param tag  the tag for tag-dispatching
-    /// \param args the arguments to forward to the constructor
-    template<typename...Args>
-    void construct( const std::tuple<Args...>& args ) const;
+    /// \param tag the tag for tag-dispatching
+    void release_constructor( std::true_type tag ) const noexcept;
 
-    /// \brief Constructs a \c lazy object by passing all values stored in a
-    ///        \c std::tuple to \c T's constructor
+    /// \brief Releases the construction function, if it supports being
+    ///        released
     ///
-    /// \param unused unused parameter for getting index list
-    template<typename...Args, std::size_t...Is>
-    void tuple_construct( const std::tuple<Args...>& args,
-                          const detail::index_sequence<Is...>& unused ) const noexcept( std::is_nothrow_constructible<T,Args...>::value );
+    /// \param tag the tag for tag-dispatching
+    void release_constructor( std::false_type tag ) const noexcept;
 
     //------------------------------------------------------------------------
 
-    /// \brief Destructs the \c Lazy object
-    void destruct( ) const;
+    /// \brief Moves the initialized value of this \c BasicLazy into the
+    ///        uninitialized \p other, leaving this \c BasicLazy uninitialized
+    ///
+    /// \param other the \c BasicLazy to relocate the value to
+    void relocate( this_type& other ) const noexcept;
 
     //------------------------------------------------------------------------
 
@@ -323,14 +590,69 @@ namespace lazy{
     ///
     /// \param rhs the value to assign
     void assign( value_type&& rhs ) const noexcept( std::is_nothrow_move_assignable<T>::value );
+  };
 
-    //------------------------------------------------------------------------
-    // Friends
-    //------------------------------------------------------------------------
+  //--------------------------------------------------------------------------
+  // Type Aliases
+  //--------------------------------------------------------------------------
 
-    template<typename U,typename...Args>
-    friend Lazy<U> make_lazy( Args&&...args );
-  };
+  /// \brief Lazy class used for lazy-loading any type
+  ///
+  /// The stored lazy-loaded class, \c T, will always be instantiated
+  /// before being accessed, and destructed when put out of scope.
+  ///
+  /// Unlike \c BasicLazy, the construction and destruction functions of a
+  /// \c Lazy are type-erased, so that any \c Lazy<T> may be constructed from
+  /// any construction function, a \c T, or a pack of \c T's constructor
+  /// arguments (through \c make_lazy).
+  ///
+  /// The construction and destruction functions share a single pointer to
+  /// their operations, and are stored along with any arguments captured for
+  /// them in an inline buffer of \c LAZY_DEFAULT_INLINE_BYTES bytes; see
+  /// \c InlineLazy for controlling the size of this buffer.
+  ///
+  /// The \p Policy selects how (and whether) the \c Lazy may be initialized
+  /// from multiple threads at once: \c single_threaded, \c double_checked,
+  /// \c call_once, or \c racy_idempotent.
+  ///
+  /// \tparam T      the type contained within this \c Lazy
+  /// \tparam Policy the threading policy to use for initialization
+  template<typename T, typename Policy = single_threaded>
+  using Lazy = BasicLazy<T,detail::erased_function<T>,detail::erased_function<T>,Policy>;
+
+  /// \brief A \c Lazy that reserves \c InlineBytes bytes for storing its
+  ///        construction function without allocating
+  ///
+  /// Construction functions (including the arguments captured by
+  /// \c make_lazy) that don't fit in \c InlineBytes are allocated on the heap,
+  /// or fail to compile if \c LAZY_NO_HEAP_FALLBACK is defined.
+  ///
+  /// \tparam T           the type contained within this \c InlineLazy
+  /// \tparam InlineBytes the number of bytes to reserve for the construction
+  ///                     function
+  template<typename T, std::size_t InlineBytes>
+  using InlineLazy = BasicLazy<T,detail::erased_function<T,InlineBytes>,detail::erased_function<T,InlineBytes>>;
+
+  /// \brief A \c Lazy that may be accessed from multiple threads at once
+  ///
+  /// Exactly one thread constructs the \c T, while any other threads
+  /// accessing it wait for construction to finish. Once initialized, each
+  /// access costs a single acquire load.
+  ///
+  /// \tparam T the type contained within this \c ConcurrentLazy
+  template<typename T>
+  using ConcurrentLazy = Lazy<T,double_checked>;
+
+  /// \brief An \c InlineLazy with the smallest possible footprint
+  ///
+  /// Only a single pointer's worth of state is kept inline, which holds
+  /// values and functions of up to pointer size (such as a captured
+  /// pointer, or a stored \c int) without allocating. Larger functions are
+  /// allocated on the heap.
+  ///
+  /// \tparam T the type contained within this \c CompactLazy
+  template<typename T>
+  using CompactLazy = InlineLazy<T,sizeof(void*)>;
 
   //--------------------------------------------------------------------------
   // Utilities
@@ -347,12 +669,44 @@ namespace lazy{
   template<typename T, typename...Args>
   Lazy<T> make_lazy( Args&&...args );
 
+  /// \brief Convenience utility to construct an \c InlineLazy object by
+  ///        specifying \c T's constructor signature.
+  ///
+  /// The arguments are stored by copy in an inline buffer of \c InlineBytes
+  /// bytes until the object is constructed, so that no allocations take place
+  /// if they fit.
+  ///
+  /// \param args the arguments to the constructor
+  /// \return an instance of the \c InlineLazy object
+  template<typename T, std::size_t InlineBytes, typename...Args>
+  InlineLazy<T,InlineBytes> make_lazy( Args&&...args );
+
+  /// \brief Convenience utility to construct a \c BasicLazy object from the
+  ///        given construction and destruction functions, deducing their
+  ///        types
+  ///
+  /// \note The \p constructor function must return a \c std::tuple containing
+  ///       the arguments to pass to \c T's constructor for lazy-construction
+  ///
+  /// \param constructor function to use for construction
+  /// \param destructor  function to use prior to destruction
+  /// \return an instance of the \c BasicLazy object
+  template<
+    typename T,
+    typename CtorFunc,
+    typename DtorFunc = default_destructor<T>,
+    typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<CtorFunc>>::value>::type
+  >
+  BasicLazy<T,typename std::decay<CtorFunc>::type,typename std::decay<DtorFunc>::type>
+    make_basic_lazy( CtorFunc&& constructor, DtorFunc&& destructor = DtorFunc() );
+
   /// \brief Implementation of \c swap for custom swapperations using ADL
   ///
-  /// \param lhs the left-hand \c Lazy object
-  /// \param rhs the right-hand \c Lazy object
-  template<typename T>
-  void swap(Lazy<T>& lhs, Lazy<T>& rhs) noexcept;
+  /// \param lhs the left-hand \c BasicLazy object
+  /// \param rhs the right-hand \c BasicLazy object
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  void swap(BasicLazy<T,CtorFunc,DtorFunc,Policy>& lhs,
+            BasicLazy<T,CtorFunc,DtorFunc,Policy>& rhs) noexcept;
 
 } // namespace lazy
 
@@ -0,0 +1,177 @@
+/**
+ * \file RacyLazy.hpp
+ *
+ * \brief This file contains \c lazy::RacyLazy<T>, a lazy value that is
+ *        allocated, and published with a single compare-and-swap.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \copyright Matthew Rodusek
+ */
+
+#ifndef LAZY_RACYLAZY_HPP_
+#define LAZY_RACYLAZY_HPP_
+
+#include "Lazy.hpp"
+#include "detail/owned_value.hpp"
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace lazy{
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A lazy-loaded \c T that is initialized without ever blocking,
+  ///        for construction functions that may safely run more than once
+  ///
+  /// The \c T is allocated on the heap, and published through an atomic
+  /// pointer. Every thread that finds the \c RacyLazy uninitialized
+  /// constructs its own \c T, and tries to publish it with a single
+  /// compare-and-swap; the threads that lose the race destroy theirs and use
+  /// the published \c T. Accessing an initialized \c RacyLazy costs a single
+  /// acquire load, and no thread ever waits for another, even during
+  /// initialization.
+  ///
+  /// Unlike \c Lazy<T,racy_idempotent>, which constructs the \c T in place
+  /// and so must briefly wait for the winning thread to move its \c T into
+  /// place, initialization is wait-free and \c T need not be movable. This
+  /// suits cheap, idempotent construction such as interning descriptors,
+  /// where duplicated work costs less than any blocking.
+  ///
+  /// \note Each thread constructs its \c T from its own copy of the
+  ///       construction and destruction functions, so they may be called
+  ///       from several threads at once.
+  ///
+  /// \tparam T the type of the value
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  class RacyLazy final
+  {
+    //------------------------------------------------------------------------
+    // Public Member Types
+    //------------------------------------------------------------------------
+  public:
+
+    using this_type = RacyLazy<T>; ///< Instance of this type
+
+    using value_type = T;  ///< The underlying type of this RacyLazy
+    using pointer    = T*; ///< The pointer type of the RacyLazy
+    using reference  = T&; ///< The reference type of the RacyLazy
+
+    //------------------------------------------------------------------------
+    // Construction / Destruction / Assignment
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs a \c RacyLazy that default-constructs the \c T
+    ///
+    /// \note This is \c constexpr, allowing a \c RacyLazy to be
+    ///       constant-initialized
+    constexpr RacyLazy( ) noexcept;
+
+    /// \brief Constructs a \c RacyLazy given the \p constructor function
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    template<
+      typename Ctor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type
+    >
+    explicit RacyLazy( Ctor&& constructor );
+
+    /// \brief Constructs a \c RacyLazy given the \p constructor and
+    ///        \p destructor functions
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    /// \param destructor  function to use prior to destruction
+    template<
+      typename Ctor,
+      typename Dtor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Dtor>>::value>::type
+    >
+    RacyLazy( Ctor&& constructor, Dtor&& destructor );
+
+    /// \brief Constructs a \c RacyLazy that copy-constructs the \c T from
+    ///        \p value
+    ///
+    /// \param value the value to copy
+    explicit RacyLazy( const value_type& value );
+
+    RacyLazy( const this_type& ) = delete;
+    this_type& operator=( const this_type& ) = delete;
+
+    /// \brief Destroys the \c T, if it has been constructed
+    ///
+    /// \note No other thread may be accessing this \c RacyLazy
+    ~RacyLazy();
+
+    //------------------------------------------------------------------------
+    // Observers
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Checks whether the \c T has been constructed
+    ///
+    /// \return \c true if the \c T has been constructed
+    bool is_initialized() const noexcept;
+
+    /// \brief Gets the \c T, constructing it if necessary
+    ///
+    /// \return a pointer to the \c T
+    pointer get() const;
+
+    /// \brief Gets the \c T, without constructing it
+    ///
+    /// \return a pointer to the \c T, or \c nullptr if it has not been
+    ///         constructed
+    pointer try_get() const noexcept;
+
+    /// \brief Gets the \c T, constructing it if necessary
+    ///
+    /// \return a reference to the \c T
+    reference operator*() const;
+
+    /// \brief Gets the \c T, constructing it if necessary
+    ///
+    /// \return a pointer to the \c T
+    pointer operator->() const;
+
+    //------------------------------------------------------------------------
+    // Private Member Types
+    //------------------------------------------------------------------------
+  private:
+
+    using value_node_type = detail::owned_value<T>;
+
+    //------------------------------------------------------------------------
+    // Private Members
+    //------------------------------------------------------------------------
+  private:
+
+    detail::erased_function<T>            m_function; ///< The functions each T is constructed with
+    mutable std::atomic<value_node_type*> m_value;    ///< The published T, or nullptr
+
+    //------------------------------------------------------------------------
+    // Private Member Functions
+    //------------------------------------------------------------------------
+  private:
+
+    /// \brief Constructs a \c T, and publishes it unless another thread
+    ///        already has
+    ///
+    /// \return the published \c T
+    LAZY_NOINLINE LAZY_COLD pointer initialize() const;
+  };
+
+} // namespace lazy
+
+#include "detail/RacyLazy.inl"
+
+#endif /* LAZY_RACYLAZY_HPP_ */
@@ -0,0 +1,253 @@
+/**
+ * \file RefreshableLazy.hpp
+ *
+ * \brief This file contains \c lazy::RefreshableLazy<T>, a thread-safe lazy
+ *        value that can be recomputed while other threads are reading it.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \copyright Matthew Rodusek
+ */
+
+#ifndef LAZY_REFRESHABLELAZY_HPP_
+#define LAZY_REFRESHABLELAZY_HPP_
+
+#include "Lazy.hpp"
+#include "detail/epoch_domain.hpp"
+#include "detail/owned_value.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace lazy{
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A thread-safe lazy-loaded \c T, which can be recomputed while
+  ///        other threads are reading it
+  ///
+  /// The \c T is constructed on first access, using the same construction
+  /// and destruction functions as a \c Lazy<T>. \c refresh constructs a new
+  /// \c T with the same functions and publishes it atomically; \c invalidate
+  /// discards the \c T, so that the next access constructs a new one.
+  ///
+  /// Readers access the \c T through a \c snapshot, which keeps the \c T it
+  /// was taken from alive even if it is replaced in the meantime. The old
+  /// \c T is destroyed once every snapshot that could refer to it has been
+  /// released, using epoch-based reclamation. This suits read-mostly
+  /// values that are rebuilt periodically, such as configuration or routing
+  /// tables.
+  ///
+  /// Taking and releasing a snapshot is wait-free, and costs a few loads,
+  /// stores, and a fence on a cache line private to the calling thread.
+  /// \c refresh and \c invalidate block until the readers of the old \c T
+  /// have finished.
+  ///
+  /// \note A thread must not call \c refresh or \c invalidate while it holds
+  ///       a snapshot of any \c RefreshableLazy, since it would wait for
+  ///       itself.
+  ///
+  /// \note Each \c T is constructed from its own copy of the construction
+  ///       and destruction functions, and is only accessible as \c const,
+  ///       since it is shared by every reader.
+  ///
+  /// \tparam T the type of the value
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  class RefreshableLazy final
+  {
+    //------------------------------------------------------------------------
+    // Public Member Types
+    //------------------------------------------------------------------------
+  public:
+
+    using this_type = RefreshableLazy<T>; ///< Instance of this type
+
+    using value_type = T;        ///< The underlying type of this RefreshableLazy
+    using pointer    = const T*; ///< The pointer type of the RefreshableLazy
+    using reference  = const T&; ///< The reference type of the RefreshableLazy
+
+    //////////////////////////////////////////////////////////////////////////
+    /// \brief A reference to the \c T of a \c RefreshableLazy, which keeps
+    ///        it alive until the snapshot is destroyed
+    ///
+    /// \note A snapshot must be destroyed on the thread that took it
+    //////////////////////////////////////////////////////////////////////////
+    class snapshot
+    {
+    public:
+
+      snapshot( snapshot&& other ) noexcept = default;
+      snapshot( const snapshot& ) = delete;
+      snapshot& operator=( const snapshot& ) = delete;
+
+      /// \brief Gets the \c T of this snapshot
+      ///
+      /// \return a pointer to the \c T
+      pointer get() const noexcept
+      {
+        return m_value;
+      }
+
+      /// \brief Gets the \c T of this snapshot
+      ///
+      /// \return a reference to the \c T
+      reference operator*() const noexcept
+      {
+        return *m_value;
+      }
+
+      /// \brief Gets the \c T of this snapshot
+      ///
+      /// \return a pointer to the \c T
+      pointer operator->() const noexcept
+      {
+        return m_value;
+      }
+
+    private:
+
+      snapshot( detail::epoch_guard&& guard, pointer value ) noexcept
+        : m_guard(std::move(guard)),
+          m_value(value)
+      {
+
+      }
+
+      detail::epoch_guard m_guard; ///< Keeps the T alive
+      pointer             m_value; ///< The T
+
+      friend class RefreshableLazy<T>;
+    };
+
+    //------------------------------------------------------------------------
+    // Construction / Destruction / Assignment
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs a \c RefreshableLazy that default-constructs the
+    ///        \c T
+    RefreshableLazy( );
+
+    /// \brief Constructs a \c RefreshableLazy given the \p constructor
+    ///        function
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    template<
+      typename Ctor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type
+    >
+    explicit RefreshableLazy( Ctor&& constructor );
+
+    /// \brief Constructs a \c RefreshableLazy given the \p constructor and
+    ///        \p destructor functions
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    /// \param destructor  function to use prior to destruction
+    template<
+      typename Ctor,
+      typename Dtor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Dtor>>::value>::type
+    >
+    RefreshableLazy( Ctor&& constructor, Dtor&& destructor );
+
+    /// \brief Constructs a \c RefreshableLazy that copy-constructs the \c T
+    ///        from \p value
+    ///
+    /// \param value the value to copy
+    explicit RefreshableLazy( const value_type& value );
+
+    RefreshableLazy( const this_type& ) = delete;
+    this_type& operator=( const this_type& ) = delete;
+
+    /// \brief Destroys the \c T, if it has been constructed
+    ///
+    /// \note No thread may hold a snapshot of this \c RefreshableLazy
+    ~RefreshableLazy();
+
+    //------------------------------------------------------------------------
+    // Modifiers
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs a new \c T, and publishes it in place of the
+    ///        current one
+    ///
+    /// The old \c T is destroyed once no snapshot can refer to it. If
+    /// construction throws, the current \c T is kept.
+    void refresh();
+
+    /// \brief Discards the \c T, so that the next access constructs a new
+    ///        one
+    ///
+    /// The old \c T is destroyed once no snapshot can refer to it.
+    void invalidate();
+
+    //------------------------------------------------------------------------
+    // Observers
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Checks whether the \c T has been constructed
+    ///
+    /// \return \c true if the \c T has been constructed
+    bool is_initialized() const noexcept;
+
+    /// \brief Takes a snapshot of the \c T, constructing it if necessary
+    ///
+    /// \return the snapshot
+    snapshot get() const;
+
+    /// \brief Takes a snapshot of the \c T, constructing it if necessary
+    ///
+    /// The snapshot lives until the end of the full expression, so
+    /// \c lazy->member() is safe even if the \c T is refreshed meanwhile.
+    ///
+    /// \return the snapshot
+    snapshot operator->() const;
+
+    //------------------------------------------------------------------------
+    // Private Member Types
+    //------------------------------------------------------------------------
+  private:
+
+    using value_node_type = detail::owned_value<T>;
+
+    //------------------------------------------------------------------------
+    // Private Members
+    //------------------------------------------------------------------------
+  private:
+
+    detail::erased_function<T>            m_function; ///< The functions each T is constructed with
+    mutable std::atomic<value_node_type*> m_value;    ///< The current T, or nullptr
+    mutable std::mutex                    m_mutex;    ///< Serializes construction on first access
+
+    //------------------------------------------------------------------------
+    // Private Member Functions
+    //------------------------------------------------------------------------
+  private:
+
+    /// \brief Constructs the \c T, unless another thread already has
+    ///
+    /// \return the current \c T
+    LAZY_NOINLINE LAZY_COLD value_node_type* initialize() const;
+
+    /// \brief Destroys \p node once no snapshot can refer to it
+    ///
+    /// \param node the unpublished node
+    static void retire( value_node_type* node ) noexcept;
+  };
+
+} // namespace lazy
+
+#include "detail/RefreshableLazy.inl"
+
+#endif /* LAZY_REFRESHABLELAZY_HPP_ */
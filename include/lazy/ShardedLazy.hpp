@@ -0,0 +1,269 @@
+/**
+ * \file ShardedLazy.hpp
+ *
+ * \brief This file contains \c lazy::ShardedLazy<T>, which lazily constructs
+ *        a separate \c T for each processor.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \copyright Matthew Rodusek
+ */
+
+#ifndef LAZY_SHARDEDLAZY_HPP_
+#define LAZY_SHARDEDLAZY_HPP_
+
+#include "Lazy.hpp"
+#include "detail/current_cpu.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace lazy{
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The number of shards for a \c ShardedLazy to use, passed ahead
+  ///        of its functions
+  ////////////////////////////////////////////////////////////////////////////
+  struct shards
+  {
+    /// \brief Constructs a number of shards
+    ///
+    /// \param count the number of shards, which is rounded up to a power of
+    ///              two
+    constexpr explicit shards( std::size_t count ) noexcept : count(count){}
+
+    std::size_t count; ///< The number of shards
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A lazy-loaded \c T, split into independent shards indexed by the
+  ///        processor of the accessing thread
+  ///
+  /// Each shard is a \c ConcurrentLazy<T> on its own cache line, constructed
+  /// on its first access using the same construction and destruction
+  /// functions as a \c Lazy<T>. Threads running on different processors use
+  /// different shards, so frequently written objects such as counters,
+  /// freelists, or random number generators don't share a cache line between
+  /// processors. \c combine folds over the shards that have been constructed.
+  ///
+  /// By default there is one shard per hardware thread (rounded up to a power
+  /// of two). Another number may be given with \c lazy::shards, such as to
+  /// bound the memory used on machines with many processors. The processor
+  /// is found with \c sched_getcpu where it is available; elsewhere, each
+  /// thread uses a fixed shard.
+  ///
+  /// \note A thread may be moved to another processor at any time, so several
+  ///       threads may still use the same shard at once. The \c T of a shard
+  ///       must therefore be safe to use from multiple threads (such as by
+  ///       being atomic); sharding only makes this rare.
+  ///
+  /// \note Each shard constructs its \c T from its own copy of the
+  ///       construction and destruction functions.
+  ///
+  /// \tparam T the type of each shard
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  class ShardedLazy final
+  {
+    //------------------------------------------------------------------------
+    // Public Member Types
+    //------------------------------------------------------------------------
+  public:
+
+    using this_type = ShardedLazy<T>; ///< Instance of this type
+
+    using value_type = T;  ///< The underlying type of this ShardedLazy
+    using pointer    = T*; ///< The pointer type of the ShardedLazy
+    using reference  = T&; ///< The reference type of the ShardedLazy
+
+    //------------------------------------------------------------------------
+    // Construction / Destruction / Assignment
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs a \c ShardedLazy that default-constructs the \c T
+    ///        of each shard
+    ShardedLazy( );
+
+    /// \brief Constructs a \c ShardedLazy given the \p constructor function
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    template<
+      typename Ctor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type
+    >
+    explicit ShardedLazy( Ctor&& constructor );
+
+    /// \brief Constructs a \c ShardedLazy given the \p constructor and
+    ///        \p destructor functions
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    /// \param destructor  function to use prior to destruction
+    template<
+      typename Ctor,
+      typename Dtor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Dtor>>::value>::type
+    >
+    ShardedLazy( Ctor&& constructor, Dtor&& destructor );
+
+    /// \brief Constructs a \c ShardedLazy that copy-constructs the \c T of
+    ///        each shard from \p value
+    ///
+    /// \param value the value to copy
+    explicit ShardedLazy( const value_type& value );
+
+    /// \brief Constructs a \c ShardedLazy with \p count shards, which
+    ///        default-construct their \c T
+    ///
+    /// \param count the number of shards
+    explicit ShardedLazy( shards count );
+
+    /// \brief Constructs a \c ShardedLazy with \p count shards, given the
+    ///        \p constructor function
+    ///
+    /// \param count       the number of shards
+    /// \param constructor function to use for construction
+    template<
+      typename Ctor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type
+    >
+    ShardedLazy( shards count, Ctor&& constructor );
+
+    /// \brief Constructs a \c ShardedLazy with \p count shards, given the
+    ///        \p constructor and \p destructor functions
+    ///
+    /// \param count       the number of shards
+    /// \param constructor function to use for construction
+    /// \param destructor  function to use prior to destruction
+    template<
+      typename Ctor,
+      typename Dtor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Dtor>>::value>::type
+    >
+    ShardedLazy( shards count, Ctor&& constructor, Dtor&& destructor );
+
+    /// \brief Constructs a \c ShardedLazy with \p count shards, which
+    ///        copy-construct their \c T from \p value
+    ///
+    /// \param count the number of shards
+    /// \param value the value to copy
+    ShardedLazy( shards count, const value_type& value );
+
+    ShardedLazy( const this_type& ) = delete;
+    this_type& operator=( const this_type& ) = delete;
+
+    /// \brief Destroys the \c T of every shard that has been constructed
+    ~ShardedLazy();
+
+    //------------------------------------------------------------------------
+    // Observers
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Gets the \c T of the shard for the calling thread's processor,
+    ///        constructing it if necessary
+    ///
+    /// \return a pointer to the \c T of the shard
+    pointer get() const;
+
+    /// \brief Gets the \c T of the shard for the calling thread's processor,
+    ///        constructing it if necessary
+    ///
+    /// \return a reference to the \c T of the shard
+    reference operator*() const;
+
+    /// \brief Gets the \c T of the shard for the calling thread's processor,
+    ///        constructing it if necessary
+    ///
+    /// \return a pointer to the \c T of the shard
+    pointer operator->() const;
+
+    /// \brief Gets the number of shards
+    ///
+    /// \return the number of shards
+    std::size_t shard_count() const noexcept;
+
+    //------------------------------------------------------------------------
+
+    /// \brief Combines the \c T of every shard that has been constructed,
+    ///        without constructing any others
+    ///
+    /// This behaves like \c std::accumulate, calling
+    /// \c result=function(std::move(result),shard) for each constructed
+    /// shard in turn.
+    ///
+    /// \note Other threads may be using the shards at the same time, so any
+    ///       state read from them must be synchronized (such as by being
+    ///       atomic).
+    ///
+    /// \param init     the initial value of the result
+    /// \param function the function combining the result with a \c T
+    /// \return the combined result
+    template<typename U, typename Function>
+    U combine( U init, Function&& function ) const;
+
+    //------------------------------------------------------------------------
+    // Private Member Types
+    //------------------------------------------------------------------------
+  private:
+
+    /// \brief A single shard, which occupies whole cache lines
+    struct alignas(LAZY_CACHE_LINE_SIZE) shard_type
+    {
+      explicit shard_type( const detail::erased_function<T>& function )
+        : lazy(function)
+      {
+
+      }
+
+      ConcurrentLazy<T> lazy;
+    };
+
+    //------------------------------------------------------------------------
+    // Private Members
+    //------------------------------------------------------------------------
+  private:
+
+    void*       m_buffer; ///< The allocation holding the shards
+    shard_type* m_shards; ///< The shards, aligned within m_buffer
+    std::size_t m_mask;   ///< The number of shards, minus one
+
+    //------------------------------------------------------------------------
+    // Private Member Functions
+    //------------------------------------------------------------------------
+  private:
+
+    /// \brief Gets the number of shards to use by default
+    ///
+    /// \return the number of hardware threads
+    static shards default_shard_count() noexcept;
+
+    /// \brief Allocates \p count shards (rounded up to a power of two), each
+    ///        with a copy of \p function
+    ///
+    /// \param count    the number of shards
+    /// \param function the construction and destruction functions
+    void create_shards( shards count, const detail::erased_function<T>& function );
+
+    /// \brief Destroys the first \p count shards, and frees their storage
+    ///
+    /// \param count the number of shards to destroy
+    void destroy_shards( std::size_t count ) noexcept;
+  };
+
+} // namespace lazy
+
+#include "detail/ShardedLazy.inl"
+
+#endif /* LAZY_SHARDEDLAZY_HPP_ */
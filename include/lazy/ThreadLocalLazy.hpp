@@ -0,0 +1,221 @@
+/**
+ * \file ThreadLocalLazy.hpp
+ *
+ * \brief This file contains \c lazy::ThreadLocalLazy<T>, which lazily
+ *        constructs a separate \c T for each thread that accesses it.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \copyright Matthew Rodusek
+ */
+
+#ifndef LAZY_THREADLOCALLAZY_HPP_
+#define LAZY_THREADLOCALLAZY_HPP_
+
+#include "Lazy.hpp"
+#include "detail/owned_value.hpp"
+#include "detail/thread_local_registry.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace lazy{
+
+  namespace detail{
+
+    /// \brief The instance of a \c ThreadLocalLazy<T> belonging to one thread
+    ///
+    /// The \c T is constructed along with the node, from a copy of the
+    /// functions of the \c ThreadLocalLazy.
+    template<typename T>
+    class thread_local_value final : public thread_local_node
+    {
+    public:
+
+      explicit thread_local_value( const erased_function<T>& function )
+        : m_value(function)
+      {
+
+      }
+
+      typename std::remove_cv<T>::type* get() noexcept
+      {
+        return m_value.get();
+      }
+
+    private:
+
+      owned_value<T> m_value; ///< This thread's T, and its copy of the functions
+    };
+
+  } // namespace detail
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A lazy-loaded \c T, with a separate instance for each thread
+  ///
+  /// Each thread that accesses a \c ThreadLocalLazy constructs its own \c T
+  /// on first access, using the same construction and destruction functions
+  /// as a \c Lazy<T>. Threads that never access it construct (and allocate)
+  /// nothing. Each instance is destroyed when its thread exits, and any
+  /// remaining instances are destroyed along with the \c ThreadLocalLazy.
+  ///
+  /// Unlike a \c thread_local \c Lazy<T>, a \c ThreadLocalLazy may be a
+  /// member of an object, and the instances of every thread can be visited
+  /// with \c for_each_instance, such as for merging per-thread statistics.
+  ///
+  /// Accessing the instance of the calling thread, once constructed, takes no
+  /// locks; constructing it, thread exit, and \c for_each_instance take a
+  /// process-wide lock.
+  ///
+  /// \note Each thread constructs its \c T from its own copy of the
+  ///       construction and destruction functions, which are stored in the
+  ///       same way as those of a \c Lazy<T>.
+  ///
+  /// \note The destructor of \c T may access other \c ThreadLocalLazy
+  ///       objects. If the exiting thread has already destroyed its instance
+  ///       of one, a new instance is constructed, and destroyed in turn.
+  ///
+  /// \tparam T the type of each thread's instance
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  class ThreadLocalLazy final
+  {
+    //------------------------------------------------------------------------
+    // Public Member Types
+    //------------------------------------------------------------------------
+  public:
+
+    using this_type = ThreadLocalLazy<T>; ///< Instance of this type
+
+    using value_type = T;  ///< The underlying type of this ThreadLocalLazy
+    using pointer    = T*; ///< The pointer type of the ThreadLocalLazy
+    using reference  = T&; ///< The reference type of the ThreadLocalLazy
+
+    //------------------------------------------------------------------------
+    // Construction / Destruction / Assignment
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs a \c ThreadLocalLazy that default-constructs each
+    ///        thread's \c T
+    ThreadLocalLazy( );
+
+    /// \brief Constructs a \c ThreadLocalLazy given the \p constructor
+    ///        function
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    template<
+      typename Ctor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type
+    >
+    explicit ThreadLocalLazy( Ctor&& constructor );
+
+    /// \brief Constructs a \c ThreadLocalLazy given the \p constructor and
+    ///        \p destructor functions
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    /// \param destructor  function to use prior to destruction
+    template<
+      typename Ctor,
+      typename Dtor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Dtor>>::value>::type
+    >
+    ThreadLocalLazy( Ctor&& constructor, Dtor&& destructor );
+
+    /// \brief Constructs a \c ThreadLocalLazy that copy-constructs each
+    ///        thread's \c T from \p value
+    ///
+    /// \param value the value to copy
+    explicit ThreadLocalLazy( const value_type& value );
+
+    ThreadLocalLazy( const this_type& ) = delete;
+    this_type& operator=( const this_type& ) = delete;
+
+    /// \brief Destroys the instance of every thread
+    ///
+    /// \note No other thread may be accessing this \c ThreadLocalLazy
+    ~ThreadLocalLazy() = default;
+
+    //------------------------------------------------------------------------
+    // Observers
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Checks whether the calling thread has constructed its \c T
+    ///
+    /// \return \c true if the calling thread's \c T has been constructed
+    bool is_initialized() const;
+
+    /// \brief Gets the calling thread's \c T, constructing it if necessary
+    ///
+    /// \return a pointer to the calling thread's \c T
+    pointer get() const;
+
+    /// \brief Gets the calling thread's \c T, without constructing it
+    ///
+    /// \return a pointer to the calling thread's \c T, or \c nullptr if it
+    ///         has not been constructed
+    pointer try_get() const;
+
+    /// \brief Gets the calling thread's \c T, constructing it if necessary
+    ///
+    /// \return a reference to the calling thread's \c T
+    reference operator*() const;
+
+    /// \brief Gets the calling thread's \c T, constructing it if necessary
+    ///
+    /// \return a pointer to the calling thread's \c T
+    pointer operator->() const;
+
+    //------------------------------------------------------------------------
+
+    /// \brief Invokes \p function on the \c T of every thread that has
+    ///        constructed one
+    ///
+    /// Threads can neither construct nor destroy their \c T during the
+    /// enumeration. The \c T of other threads may still be used by them, so
+    /// any state read from it must be synchronized (such as by being
+    /// atomic).
+    ///
+    /// \param function the function to invoke with a \c T&
+    template<typename Function>
+    void for_each_instance( Function&& function ) const;
+
+    //------------------------------------------------------------------------
+    // Private Member Types
+    //------------------------------------------------------------------------
+  private:
+
+    using value_node_type = detail::thread_local_value<T>;
+
+    //------------------------------------------------------------------------
+    // Private Members
+    //------------------------------------------------------------------------
+  private:
+
+    detail::erased_function<T>         m_function; ///< The functions each thread's instance is constructed with
+    mutable detail::thread_local_owner m_owner;    ///< The instances of every thread
+
+    //------------------------------------------------------------------------
+    // Private Member Functions
+    //------------------------------------------------------------------------
+  private:
+
+    /// \brief Constructs the calling thread's \c T
+    ///
+    /// \return a pointer to the calling thread's \c T
+    LAZY_NOINLINE LAZY_COLD pointer initialize() const;
+  };
+
+} // namespace lazy
+
+#include "detail/ThreadLocalLazy.inl"
+
+#endif /* LAZY_THREADLOCALLAZY_HPP_ */
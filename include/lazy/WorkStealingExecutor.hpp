@@ -0,0 +1,209 @@
+/**
+ * \file WorkStealingExecutor.hpp
+ *
+ * \brief This file contains \c lazy::WorkStealingExecutor, the thread pool
+ *        that asynchronous lazy objects construct their values on by default.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \copyright Matthew Rodusek
+ */
+
+#ifndef LAZY_WORKSTEALINGEXECUTOR_HPP_
+#define LAZY_WORKSTEALINGEXECUTOR_HPP_
+
+#include "detail/lazy_config.hpp"
+#include "detail/executor_ref.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lazy{
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A fixed-size thread pool, in which idle threads steal work from
+  ///        busy ones
+  ///
+  /// Each worker thread has its own queues of tasks. A task submitted from a
+  /// worker goes to that worker's queues, and is run by it in last-in,
+  /// first-out order, so that a task that submits more tasks keeps them on
+  /// a warm cache. Tasks submitted from any other thread are spread across
+  /// the workers. A worker with nothing to do steals the oldest task of
+  /// another worker, chosen at random, so bursts of work submitted to one
+  /// worker are quickly shared by all of them. Idle workers spin briefly
+  /// (\c LAZY_SPIN_COUNT attempts) before sleeping, which suits the short,
+  /// bursty tasks of lazy initialization.
+  ///
+  /// A task may be submitted with \c priority::high, in which case it is run
+  /// before any task of normal priority that has not yet started.
+  ///
+  /// This satisfies the executor concept used throughout this library: any
+  /// object \c e for which \c e.execute(f) runs the nullary function \c f on
+  /// some thread. \c default_executor returns a process-wide instance, which
+  /// is used by asynchronous lazy objects that are not given an executor.
+  ///
+  /// \note Tasks must not throw; an exception escaping a task calls
+  ///       \c std::terminate.
+  ////////////////////////////////////////////////////////////////////////////
+  class WorkStealingExecutor final
+  {
+    //------------------------------------------------------------------------
+    // Public Member Types
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief The priority of a task
+    enum class priority
+    {
+      normal, ///< The priority of tasks submitted without one
+      high,   ///< Run before any task of normal priority that has not started
+    };
+
+    //------------------------------------------------------------------------
+    // Construction / Destruction / Assignment
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Constructs a \c WorkStealingExecutor with one worker thread per
+    ///        hardware thread
+    WorkStealingExecutor();
+
+    /// \brief Constructs a \c WorkStealingExecutor with \p thread_count
+    ///        worker threads
+    ///
+    /// \param thread_count the number of worker threads; at least one is
+    ///                     always started
+    explicit WorkStealingExecutor( std::size_t thread_count );
+
+    WorkStealingExecutor( const WorkStealingExecutor& ) = delete;
+    WorkStealingExecutor& operator=( const WorkStealingExecutor& ) = delete;
+
+    /// \brief Runs every task that has been submitted, and joins the worker
+    ///        threads
+    ~WorkStealingExecutor();
+
+    //------------------------------------------------------------------------
+    // Execution
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Submits \p function to be run on a worker thread
+    ///
+    /// \param function the nullary function to run
+    template<typename Function>
+    void execute( Function&& function );
+
+    /// \brief Submits \p function to be run on a worker thread, with the
+    ///        priority \p task_priority
+    ///
+    /// \param function      the nullary function to run
+    /// \param task_priority the priority of the task
+    template<typename Function>
+    void execute( Function&& function, priority task_priority );
+
+    //------------------------------------------------------------------------
+    // Observers
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Gets the number of worker threads
+    ///
+    /// \return the number of worker threads
+    std::size_t thread_count() const noexcept;
+
+    //------------------------------------------------------------------------
+    // Private Member Types
+    //------------------------------------------------------------------------
+  private:
+
+    using task_type = std::function<void()>;
+
+    /// \brief The queues of a worker thread, one for each priority
+    struct worker
+    {
+      std::mutex            mutex;
+      std::deque<task_type> tasks[2];
+    };
+
+    //------------------------------------------------------------------------
+    // Private Members
+    //------------------------------------------------------------------------
+  private:
+
+    std::vector<std::unique_ptr<worker>> m_workers;  ///< The queues of each worker
+    std::vector<std::thread>             m_threads;  ///< The worker threads
+    std::atomic<std::size_t>             m_pending;  ///< The number of tasks not yet started
+    std::atomic<std::size_t>             m_next;     ///< The worker for the next external task
+    std::atomic<int>                     m_sleeping; ///< The number of sleeping workers
+    std::atomic<bool>                    m_stopping; ///< Whether the executor is being destroyed
+    std::mutex                           m_mutex;    ///< Guards sleeping
+    std::condition_variable              m_wakeup;   ///< Wakes sleeping workers
+
+    //------------------------------------------------------------------------
+    // Private Member Functions
+    //------------------------------------------------------------------------
+  private:
+
+    /// \brief Queues \p task, and wakes a worker to run it if they are all
+    ///        sleeping
+    ///
+    /// \param task          the task
+    /// \param task_priority the priority of the task
+    void submit( task_type task, priority task_priority );
+
+    /// \brief Takes the next task for worker \p index: its own newest task,
+    ///        or else the oldest task of another worker, for the highest
+    ///        priority that has any
+    ///
+    /// \param index the index of the worker
+    /// \param seed  the state of the worker's random number generator
+    /// \param task  the task that was taken
+    /// \return \c true if a task was taken
+    bool take( std::size_t index, std::uint32_t& seed, task_type& task );
+
+    /// \brief Runs the tasks of worker \p index until the executor is
+    ///        destroyed
+    ///
+    /// \param index the index of the worker
+    void run( std::size_t index ) noexcept;
+
+    /// \brief Gets the index of the calling thread's worker in this
+    ///        executor
+    ///
+    /// \return the index, or \c thread_count() if the calling thread is not
+    ///         a worker of this executor
+    std::size_t current_worker() const noexcept;
+
+    /// \brief Gets the executor and worker index of the calling thread
+    ///
+    /// \return a reference to the calling thread's executor and index
+    static std::pair<const WorkStealingExecutor*,std::size_t>& current() noexcept;
+  };
+
+  //--------------------------------------------------------------------------
+  // Free Functions
+  //--------------------------------------------------------------------------
+
+  /// \brief Gets the process-wide \c WorkStealingExecutor, with one worker
+  ///        thread per hardware thread
+  ///
+  /// This is the executor used by asynchronous lazy objects when none is
+  /// given. It is started on first use, and never destroyed, so that static
+  /// lazy objects may use it until the end of the program.
+  ///
+  /// \return a reference to the executor
+  WorkStealingExecutor& default_executor();
+
+} // namespace lazy
+
+#include "detail/WorkStealingExecutor.inl"
+
+#endif /* LAZY_WORKSTEALINGEXECUTOR_HPP_ */
@@ -0,0 +1,284 @@
+namespace lazy{
+
+  //--------------------------------------------------------------------------
+  // Constructors / Destructor / Assignment
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline AsyncLazy<T>::AsyncLazy()
+    : AsyncLazy(default_executor())
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename>
+  inline AsyncLazy<T>::AsyncLazy( Ctor&& constructor )
+    : AsyncLazy(default_executor(),std::forward<Ctor>(constructor))
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename Dtor, typename, typename>
+  inline AsyncLazy<T>::AsyncLazy( Ctor&& constructor, Dtor&& destructor )
+    : AsyncLazy(default_executor(),std::forward<Ctor>(constructor),std::forward<Dtor>(destructor))
+  {
+
+  }
+
+  template<typename T>
+  inline AsyncLazy<T>::AsyncLazy( const value_type& value )
+    : AsyncLazy(default_executor(),value)
+  {
+
+  }
+
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  template<typename Executor, typename>
+  inline AsyncLazy<T>::AsyncLazy( Executor& executor )
+    : m_function(),
+      m_executor(executor),
+      m_value(),
+      m_exception(),
+      m_promise(),
+      m_future(m_promise.get_future()),
+      m_started(false),
+      m_awaiters(nullptr)
+  {
+
+  }
+
+  template<typename T>
+  template<typename Executor, typename Ctor, typename, typename>
+  inline AsyncLazy<T>::AsyncLazy( Executor& executor, Ctor&& constructor )
+    : m_function(std::forward<Ctor>(constructor)),
+      m_executor(executor),
+      m_value(),
+      m_exception(),
+      m_promise(),
+      m_future(m_promise.get_future()),
+      m_started(false),
+      m_awaiters(nullptr)
+  {
+
+  }
+
+  template<typename T>
+  template<typename Executor, typename Ctor, typename Dtor, typename, typename, typename>
+  inline AsyncLazy<T>::AsyncLazy( Executor& executor,
+                                  Ctor&& constructor,
+                                  Dtor&& destructor )
+    : m_function(std::forward<Ctor>(constructor),std::forward<Dtor>(destructor)),
+      m_executor(executor),
+      m_value(),
+      m_exception(),
+      m_promise(),
+      m_future(m_promise.get_future()),
+      m_started(false),
+      m_awaiters(nullptr)
+  {
+
+  }
+
+  template<typename T>
+  template<typename Executor, typename>
+  inline AsyncLazy<T>::AsyncLazy( Executor& executor, const value_type& value )
+    : m_function(value),
+      m_executor(executor),
+      m_value(),
+      m_exception(),
+      m_promise(),
+      m_future(m_promise.get_future()),
+      m_started(false),
+      m_awaiters(nullptr)
+  {
+
+  }
+
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline AsyncLazy<T>::~AsyncLazy()
+  {
+    if( m_started.load(std::memory_order_acquire) ) {
+      m_future.wait();
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Modifiers
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline void AsyncLazy<T>::start()
+    const
+  {
+    if( m_started.load(std::memory_order_acquire) ) return;
+    if( m_started.exchange(true, std::memory_order_acq_rel) ) return;
+
+    auto self = const_cast<this_type*>(this);
+    try {
+      m_executor.execute(&construct, self);
+    } catch( ... ) {
+      // Other threads may already be waiting on the future, so the
+      // executor's exception becomes the result of construction
+      m_exception = std::current_exception();
+      finish(self, std::move(m_promise));
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Observers
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline bool AsyncLazy<T>::is_ready()
+    const
+  {
+    return m_awaiters.load(std::memory_order_acquire) == ready_state();
+  }
+
+  template<typename T>
+  inline typename AsyncLazy<T>::future_type
+    AsyncLazy<T>::get_future()
+    const
+  {
+    start();
+
+    return m_future;
+  }
+
+  template<typename T>
+  inline typename AsyncLazy<T>::reference
+    AsyncLazy<T>::get()
+    const
+  {
+    start();
+
+    return m_future.get();
+  }
+
+#if LAZY_HAS_COROUTINES
+
+  template<typename T>
+  inline typename AsyncLazy<T>::awaiter
+    AsyncLazy<T>::operator co_await()
+    const noexcept
+  {
+    return awaiter(*this);
+  }
+
+  //--------------------------------------------------------------------------
+  // Awaiter
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline AsyncLazy<T>::awaiter::awaiter( const this_type& lazy )
+    noexcept
+    : m_lazy(&lazy),
+      m_handle(),
+      m_next(nullptr)
+  {
+
+  }
+
+  template<typename T>
+  inline bool AsyncLazy<T>::awaiter::await_ready()
+    const noexcept
+  {
+    return m_lazy->is_ready();
+  }
+
+  template<typename T>
+  inline bool AsyncLazy<T>::awaiter::await_suspend( std::coroutine_handle<> handle )
+  {
+    m_handle = handle;
+    m_lazy->start();
+
+    auto ready = m_lazy->ready_state();
+    auto head  = m_lazy->m_awaiters.load(std::memory_order_acquire);
+    do {
+      // Construction finished while suspending; continue without waiting
+      if( head == ready ) return false;
+
+      m_next = static_cast<awaiter*>(head);
+    } while( !m_lazy->m_awaiters.compare_exchange_weak(head, this,
+                                                       std::memory_order_release,
+                                                       std::memory_order_acquire) );
+    return true;
+  }
+
+  template<typename T>
+  inline typename AsyncLazy<T>::reference
+    AsyncLazy<T>::awaiter::await_resume()
+    const
+  {
+    if( m_lazy->m_exception ) {
+      std::rethrow_exception(m_lazy->m_exception);
+    }
+    return *m_lazy->m_value->get();
+  }
+
+#endif
+
+  //--------------------------------------------------------------------------
+  // Private Member Functions
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  void AsyncLazy<T>::construct( void* self )
+  {
+    auto lazy = static_cast<this_type*>(self);
+
+    // The promise is owned by this task, so that the AsyncLazy may be
+    // destroyed as soon as the future is ready
+    auto promise = std::move(lazy->m_promise);
+
+    try {
+      lazy->m_value.reset(new value_node_type(lazy->m_function));
+    } catch( ... ) {
+      lazy->m_exception = std::current_exception();
+    }
+
+    finish(lazy, std::move(promise));
+  }
+
+  template<typename T>
+  void AsyncLazy<T>::finish( this_type* lazy, std::promise<T&> promise )
+  {
+    auto awaiters = lazy->m_awaiters.exchange(lazy->ready_state(), std::memory_order_acq_rel);
+
+    if( lazy->m_exception ) {
+      promise.set_exception(lazy->m_exception);
+    } else {
+      promise.set_value(*lazy->m_value->get());
+    }
+
+    // The AsyncLazy may be destroyed as soon as the future is ready, so only
+    // the awaiters may be touched from here on
+
+#if LAZY_HAS_COROUTINES
+    // Each awaiter lives in its coroutine, so it must not be touched once
+    // the coroutine is resumed
+    auto current = static_cast<awaiter*>(awaiters);
+    while( current ) {
+      auto next = current->m_next;
+      current->m_handle.resume();
+      current = next;
+    }
+#else
+    (void) awaiters;
+#endif
+  }
+
+  template<typename T>
+  inline void* AsyncLazy<T>::ready_state()
+    const noexcept
+  {
+    return const_cast<this_type*>(this);
+  }
+
+} // namespace lazy
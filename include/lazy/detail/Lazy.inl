@@ -1,134 +1,152 @@
 namespace lazy{
 
   //--------------------------------------------------------------------------
-  // Constructors / Destructor / Assignment
+  // Default Functions
   //--------------------------------------------------------------------------
 
   template<typename T>
-  inline Lazy<T>::Lazy()
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor([this](){this->construct(ctor_va_args_tag());}),
-      m_destructor(default_destructor)
+  inline std::tuple<> default_constructor<T>::operator()()
+    const noexcept
   {
     static_assert(std::is_default_constructible<T>::value,"No matching default constructor for type T");
+
+    return std::tuple<>();
   }
 
   template<typename T>
-  template<typename CtorFunc,typename DtorFunc,typename,typename>
-  inline Lazy<T>::Lazy( const CtorFunc& constructor,
-                        const DtorFunc& destructor )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor([this,constructor](){this->construct(constructor());}),
-      m_destructor(destructor)
+  inline void default_destructor<T>::operator()( T& )
+    const noexcept
   {
-    using return_type = typename detail::function_traits<CtorFunc>::result_type;
 
-    static_assert(detail::is_tuple<return_type>::value,"Lazy-construction functions must return tuples containing constructor arguments");
-    static_assert(detail::is_tuple_constructible<T,return_type>::value, "No matching constructor for type T with given arguments");
   }
 
-  template<typename T>
-  inline Lazy<T>::Lazy( const this_type& rhs )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor(rhs.m_constructor),
-      m_destructor(rhs.m_destructor)
+  //--------------------------------------------------------------------------
+  // Constructors / Destructor / Assignment
+  //--------------------------------------------------------------------------
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline constexpr BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy()
+    : base_type()
+  {
+
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename Ctor, typename>
+  inline constexpr BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( Ctor&& constructor )
+    : base_type(static_cast<Ctor&&>(constructor))
+  {
+
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename Ctor, typename Dtor, typename, typename>
+  inline constexpr BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( Ctor&& constructor,
+                                                              Dtor&& destructor )
+    : base_type(static_cast<Ctor&&>(constructor),static_cast<Dtor&&>(destructor))
+  {
+
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( const this_type& rhs )
+    : base_type(rhs.m_functions)
   {
     static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
 
-    if(rhs.m_is_initialized)
+    if(rhs.m_state.is_initialized())
     {
       construct(*rhs);
     }
   }
 
-  template<typename T>
-  inline Lazy<T>::Lazy( this_type&& rhs )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor(std::move(rhs.m_constructor)),
-      m_destructor(std::move(rhs.m_destructor))
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( this_type&& rhs )
+    noexcept( std::is_nothrow_move_constructible<T>::value &&
+              std::is_nothrow_move_constructible<CtorFunc>::value &&
+              std::is_nothrow_move_constructible<DtorFunc>::value )
+    : base_type(std::move(rhs.m_functions))
   {
     static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
 
-    if(rhs.m_is_initialized)
+    if(rhs.m_state.is_initialized())
     {
       construct(std::move(*rhs));
     }
-    rhs.m_constructor = nullptr;
-    rhs.m_destructor = nullptr;
   }
 
-  template<typename T>
-  inline Lazy<T>::Lazy( const value_type& rhs )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor([this,rhs](){this->construct(std::move(rhs));}),
-      m_destructor(default_destructor)
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( const value_type& rhs )
+    : base_type(CtorFunc(rhs))
   {
     static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
   }
 
-  template<typename T>
-  inline Lazy<T>::Lazy( value_type&& rhs )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor([this,rhs](){this->construct(std::move(rhs));}),
-      m_destructor(default_destructor)
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( value_type&& rhs )
+    : base_type(CtorFunc(std::move(rhs)))
   {
     static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
+    static_assert(std::is_copy_constructible<T>::value || !detail::races_construction<Policy>::value,
+                  "Racing to construct T from a stored value requires T to be copy-constructible");
   }
 
-  //--------------------------------------------------------------------------
-
-  template<typename T>
-  inline Lazy<T>::~Lazy()
-  {
-    destruct();
-  }
 
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  inline Lazy<T>& Lazy<T>::operator=( const this_type& rhs )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::this_type&
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator=( const this_type& rhs )
   {
     static_assert(std::is_copy_assignable<T>::value,"No matching copy assignment operator for type T");
     static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
 
-    if(rhs.m_is_initialized) {
-      lazy_construct();
-      assign(*rhs);
-    } else {
-      m_constructor = rhs.m_constructor;
+    if(rhs.m_state.is_initialized()) {
+      if(m_state.is_initialized()) {
+        assign(*rhs);
+      } else {
+        construct(*rhs);
+      }
+    }
+    m_functions = rhs.m_functions;
+
+    if(m_state.is_initialized()) {
+      release_constructor( detail::is_storage_constructor<CtorFunc>() );
     }
-    m_destructor  = rhs.m_destructor;
 
     return (*this);
   }
 
-  template<typename T>
-  inline typename Lazy<T>::this_type& Lazy<T>::operator=( this_type&& rhs )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::this_type&
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator=( this_type&& rhs )
+    noexcept( std::is_nothrow_move_constructible<T>::value &&
+              std::is_nothrow_move_assignable<T>::value &&
+              std::is_nothrow_move_assignable<CtorFunc>::value &&
+              std::is_nothrow_move_assignable<DtorFunc>::value )
   {
     static_assert(std::is_move_assignable<T>::value,"No matching move assignment operator for type T");
     static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
 
-    if(rhs.m_is_initialized) {
-      lazy_construct();
-      assign(std::move(*rhs));
-    } else {
-      m_constructor = std::move(rhs.m_constructor);
-      rhs.m_constructor = nullptr;
+    if(rhs.m_state.is_initialized()) {
+      if(m_state.is_initialized()) {
+        assign(std::move(*rhs.ptr()));
+      } else {
+        construct(std::move(*rhs.ptr()));
+      }
+    }
+    m_functions = std::move(rhs.m_functions);
+
+    if(m_state.is_initialized()) {
+      release_constructor( detail::is_storage_constructor<CtorFunc>() );
     }
-    m_destructor = std::move(rhs.m_destructor);
-    rhs.m_destructor = nullptr;
 
     return (*this);
   }
 
-  template<typename T>
-  inline typename Lazy<T>::value_type& Lazy<T>::operator=( const value_type& rhs )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::value_type&
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator=( const value_type& rhs )
   {
     static_assert(std::is_copy_assignable<T>::value,"No matching copy assignment operator for type T");
 
@@ -138,9 +156,10 @@ namespace lazy{
     return *ptr();
   }
 
-  template<typename T>
-  inline typename Lazy<T>::value_type& Lazy<T>::operator=( value_type&& rhs )
- {
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::value_type&
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator=( value_type&& rhs )
+  {
     static_assert(std::is_move_assignable<T>::value,"No matching move assignment operator for type T");
 
     lazy_construct();
@@ -153,184 +172,344 @@ namespace lazy{
   // Casting
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  inline Lazy<T>::operator reference()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator reference()
     const
   {
     lazy_construct();
     return *ptr();
   }
 
-  template<typename T>
-  inline Lazy<T>::operator bool()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator bool()
     const noexcept
   {
-    return m_is_initialized;
+    return m_state.is_initialized();
   }
 
   //--------------------------------------------------------------------------
   // Operators
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  inline void Lazy<T>::swap(Lazy<T>& rhs)
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::swap(this_type& rhs)
     noexcept
   {
     using std::swap; // for ADL
 
-    swap(m_constructor,rhs.m_constructor);
-    swap(m_destructor,rhs.m_destructor);
-    swap(m_is_initialized,rhs.m_is_initialized);
-    swap((*ptr()),(*rhs.ptr())); // Swap the values of the T types
+    m_functions.swap(rhs.m_functions);
+
+    if( m_state.is_initialized() && rhs.m_state.is_initialized() ) {
+      swap((*ptr()),(*rhs.ptr())); // Swap the values of the T types
+    } else if( m_state.is_initialized() ) {
+      relocate(rhs);
+    } else if( rhs.m_state.is_initialized() ) {
+      rhs.relocate(*this);
+    }
   }
 
-  template<typename T>
-  inline bool Lazy<T>::is_initialized()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline bool BasicLazy<T,CtorFunc,DtorFunc,Policy>::is_initialized()
     const noexcept
   {
-    return m_is_initialized;
+    return m_state.is_initialized();
   }
 
-  template<typename T>
-  inline typename Lazy<T>::pointer Lazy<T>::get()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::pointer
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::get()
     const
   {
     lazy_construct();
     return ptr();
   }
 
-  template<typename T>
-  inline typename Lazy<T>::reference Lazy<T>::operator*()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::pointer
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::try_get()
+    const noexcept
+  {
+    return m_state.is_initialized() ? ptr() : nullptr;
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::pointer
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::unchecked_get()
+    const noexcept
+  {
+    assert(m_state.is_initialized() && "unchecked_get() called on an uninitialized lazy");
+    return ptr();
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename U>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::value_type
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::value_or( U&& fallback )
+    const
+  {
+    static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
+    static_assert(std::is_convertible<U&&,T>::value,"Fallback value is not convertible to type T");
+
+    return m_state.is_initialized() ? *ptr() : static_cast<value_type>(std::forward<U>(fallback));
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::reference
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator*()
     const
   {
     lazy_construct();
     return *ptr();
   }
 
-  template<typename T>
-  inline typename Lazy<T>::pointer Lazy<T>::operator->()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::pointer
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator->()
     const
   {
     lazy_construct();
     return ptr();
   }
 
-  //--------------------------------------------------------------------------
-  // Private Static Member Functions
-  //--------------------------------------------------------------------------
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename Executor>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::prefetch( Executor& executor )
+    const
+  {
+    static_assert(detail::is_thread_safe_policy<Policy>::value,"prefetch requires a thread-safe policy");
 
-  template<typename T>
-  inline void Lazy<T>::default_destructor(value_type&) noexcept{}
+    if( m_state.is_initialized() ) return;
+
+    executor.execute([this](){
+      try {
+        lazy_construct();
+      } catch( ... ) {
+        // The next access retries, or rethrows a cached failure
+      }
+    });
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline std::size_t BasicLazy<T,CtorFunc,DtorFunc,Policy>::retained_bytes()
+    const noexcept
+  {
+    return retained_bytes( detail::is_storage_constructor<CtorFunc>() );
+  }
 
   //--------------------------------------------------------------------------
-  // Private Constructors
+  // Initializer
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  template<typename...Args>
-  inline Lazy<T>::Lazy( ctor_va_args_tag, Args&&...args )
-    : m_is_initialized(false),
-      m_constructor([this,args...](){this->construct(ctor_va_args_tag(), std::move(args)...);}),
-      m_destructor(default_destructor)
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::initializer( const this_type& lazy )
+    noexcept
+    : m_lazy(lazy)
+  {
+
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::construct( )
+    const
   {
-    static_assert(std::is_constructible<T,Args...>::value, "No matching constructor for type T with given arguments");
+    m_lazy.construct_with_function( detail::is_storage_constructor<CtorFunc>() );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::construct_at( void* where )
+    const
+  {
+    m_lazy.construct_with_function( where, detail::is_storage_constructor<CtorFunc>() );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::relocate_from( void* where )
+    const
+  {
+    static_assert(std::is_move_constructible<T>::value,"Racing to construct T requires T to be move-constructible");
+
+    auto& source = *static_cast<unqualified_pointer>(where);
+
+    new (m_lazy.ptr()) value_type( std::move(source) );
+    source.~T();
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::destroy_at( void* where )
+    const
+  {
+    auto& source = *static_cast<unqualified_pointer>(where);
+
+    m_lazy.m_functions.second()( source );
+    source.~T();
   }
 
   //--------------------------------------------------------------------------
   // Private Member Functions
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  inline typename Lazy<T>::unqualified_pointer Lazy<T>::ptr()
-    const noexcept
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::lazy_construct( )
+    const
   {
-    // address-of idiom (https://en.wikibooks.org/wiki/More_C%2B%2B_Idioms/Address_Of)
-    return reinterpret_cast<unqualified_pointer>(& const_cast<char&>(reinterpret_cast<const volatile char &>(m_storage)));
+    if( LAZY_UNLIKELY(!m_state.is_initialized()) )
+    {
+      initialize();
+    }
   }
 
-  template<typename T>
-  inline void Lazy<T>::lazy_construct( )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initialize( )
+    const
+  {
+    m_state.initialize( initializer(*this) );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_with_function( std::true_type )
     const
   {
-    if( !m_is_initialized )
+    consume_function( detail::is_sentinel_policy<Policy>() );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::consume_function( std::true_type )
+    const
+  {
+    // A T constructed as the sentinel leaves the BasicLazy uninitialized, so
+    // the arguments are kept for the next attempt
+    m_functions.first().construct( ptr() );
+    if( m_state.is_initialized() )
     {
-      m_constructor();
-      m_is_initialized = true;
+      release_constructor( std::true_type() );
     }
   }
 
-  template<typename T>
-  inline void Lazy<T>::construct( const value_type& x )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::consume_function( std::false_type )
     const
   {
-    destruct();
-    new (ptr()) value_type( x );
-    m_is_initialized = true;
+    // The arguments are no longer needed once the T is constructed
+    m_functions.first().consume( ptr() );
   }
 
-  template<typename T>
-  inline void Lazy<T>::construct( value_type&& x )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_with_function( std::false_type )
     const
   {
-    destruct();
-    new (ptr()) value_type( std::forward<value_type>(x) );
-    m_is_initialized = true;
+    detail::construct_from_function<T>( ptr(), m_functions.first() );
   }
 
-  template<typename T>
-  template<typename...Args>
-  inline void Lazy<T>::construct( ctor_va_args_tag, Args&&...args )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_with_function( void* where, std::true_type )
+    const
+  {
+    // The stored function is shared with any other threads constructing
+    // concurrently, so it is only read from, and never consumed
+    m_functions.first().construct( where );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_with_function( void* where, std::false_type )
+    const
+  {
+    detail::construct_from_function<T>( where, m_functions.first() );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline std::size_t BasicLazy<T,CtorFunc,DtorFunc,Policy>::retained_bytes( std::true_type )
+    const noexcept
+  {
+    return m_functions.first().retained_bytes();
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline std::size_t BasicLazy<T,CtorFunc,DtorFunc,Policy>::retained_bytes( std::false_type )
+    const noexcept
+  {
+    return std::is_empty<CtorFunc>::value ? 0 : sizeof(CtorFunc);
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct( const value_type& x )
     const
   {
     destruct();
-    new (ptr()) value_type( std::forward<Args>(args)... );
-    m_is_initialized = true;
+    construct_value( x, detail::is_sentinel_policy<Policy>() );
+    m_state.set_initialized(true);
   }
 
-  template<typename T>
-  template<typename...Args>
-  inline void Lazy<T>::construct( const std::tuple<Args...>& args )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct( value_type&& x )
     const
   {
     destruct();
-    tuple_construct(args,detail::index_sequence_for<Args...>());
-    m_is_initialized = true;
+    construct_value( std::forward<value_type>(x), detail::is_sentinel_policy<Policy>() );
+    m_state.set_initialized(true);
   }
 
-  template<typename T>
-  template<typename...Args, std::size_t...Ints>
-  inline void Lazy<T>::tuple_construct(const std::tuple<Args...>& args,
-                                       const detail::index_sequence<Ints...>& )
-    const noexcept( std::is_nothrow_constructible<T,Args...>::value )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename U>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_value( U&& x, std::true_type )
+    const
   {
-    static_assert(std::is_constructible<T,Args...>::value,"No matching constructor for type T with given arguments");
+    // The sentinel is destroyed before the T takes its place, and is put
+    // back if constructing the T throws
+    m_state.clear();
+    try {
+      new (ptr()) value_type( std::forward<U>(x) );
+    } catch( ... ) {
+      m_state.set_initialized(false);
+      throw;
+    }
+  }
 
-    new (ptr()) T( std::get<Ints>(args)... );
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename U>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_value( U&& x, std::false_type )
+    const
+  {
+    new (ptr()) value_type( std::forward<U>(x) );
   }
 
-  template<typename T>
-  inline void Lazy<T>::destruct( ) const
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::release_constructor( std::true_type )
+    const noexcept
   {
-    if( m_is_initialized )
-    {
-      if( m_destructor )
-      {
-        m_destructor(*ptr());
-      }
-      ptr()->~T();
-      m_is_initialized = false;
-    }
+    m_functions.first().release();
   }
 
-  template<typename T>
-  inline void Lazy<T>::assign( const value_type& rhs )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::release_constructor( std::false_type )
+    const noexcept
+  {
+
+  }
+
+  //--------------------------------------------------------------------------
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::relocate( this_type& other )
+    const noexcept
+  {
+    other.construct_value( std::move(*ptr()), detail::is_sentinel_policy<Policy>() );
+    other.m_state.set_initialized(true);
+
+    // The value now belongs to 'other', so only the moved-from T is
+    // destroyed here; the destruction function must not run on it
+    ptr()->~T();
+    m_state.set_initialized(false);
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::assign( const value_type& rhs )
     const noexcept( std::is_nothrow_copy_assignable<T>::value )
   {
     (*ptr()) = rhs;
   }
 
-  template<typename T>
-  inline void Lazy<T>::assign( value_type&& rhs )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::assign( value_type&& rhs )
     const noexcept( std::is_nothrow_move_assignable<T>::value )
   {
     (*ptr()) = std::forward<value_type>(rhs);
@@ -343,11 +522,29 @@ namespace lazy{
   template<typename T, typename...Args>
   Lazy<T> make_lazy(Args&&...args)
   {
-    return Lazy<T>(typename Lazy<T>::ctor_va_args_tag(), std::forward<Args>(args)...);
+    return Lazy<T>(detail::erased_function<T>(detail::ctor_va_args_tag(), std::forward<Args>(args)...));
   }
 
-  template<typename T>
-  void swap(Lazy<T>& lhs, Lazy<T>& rhs) noexcept
+  template<typename T, std::size_t InlineBytes, typename...Args>
+  InlineLazy<T,InlineBytes> make_lazy(Args&&...args)
+  {
+    using constructor_type = detail::erased_function<T,InlineBytes>;
+
+    return InlineLazy<T,InlineBytes>(constructor_type(detail::ctor_va_args_tag(), std::forward<Args>(args)...));
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename>
+  BasicLazy<T,typename std::decay<CtorFunc>::type,typename std::decay<DtorFunc>::type>
+    make_basic_lazy( CtorFunc&& constructor, DtorFunc&& destructor )
+  {
+    using result_type = BasicLazy<T,typename std::decay<CtorFunc>::type,typename std::decay<DtorFunc>::type>;
+
+    return result_type(std::forward<CtorFunc>(constructor),std::forward<DtorFunc>(destructor));
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  void swap(BasicLazy<T,CtorFunc,DtorFunc,Policy>& lhs,
+            BasicLazy<T,CtorFunc,DtorFunc,Policy>& rhs) noexcept
   {
     lhs.swap(rhs);
   }
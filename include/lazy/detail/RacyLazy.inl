@@ -0,0 +1,121 @@
+namespace lazy{
+
+  //--------------------------------------------------------------------------
+  // Constructors / Destructor / Assignment
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline constexpr RacyLazy<T>::RacyLazy()
+    noexcept
+    : m_function(),
+      m_value(nullptr)
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename>
+  inline RacyLazy<T>::RacyLazy( Ctor&& constructor )
+    : m_function(std::forward<Ctor>(constructor)),
+      m_value(nullptr)
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename Dtor, typename, typename>
+  inline RacyLazy<T>::RacyLazy( Ctor&& constructor,
+                                Dtor&& destructor )
+    : m_function(std::forward<Ctor>(constructor),std::forward<Dtor>(destructor)),
+      m_value(nullptr)
+  {
+
+  }
+
+  template<typename T>
+  inline RacyLazy<T>::RacyLazy( const value_type& value )
+    : m_function(value),
+      m_value(nullptr)
+  {
+
+  }
+
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline RacyLazy<T>::~RacyLazy()
+  {
+    delete m_value.load(std::memory_order_acquire);
+  }
+
+  //--------------------------------------------------------------------------
+  // Observers
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline bool RacyLazy<T>::is_initialized()
+    const noexcept
+  {
+    return m_value.load(std::memory_order_acquire) != nullptr;
+  }
+
+  template<typename T>
+  inline typename RacyLazy<T>::pointer
+    RacyLazy<T>::get()
+    const
+  {
+    auto node = m_value.load(std::memory_order_acquire);
+
+    if( LAZY_UNLIKELY(!node) ) return initialize();
+
+    return node->get();
+  }
+
+  template<typename T>
+  inline typename RacyLazy<T>::pointer
+    RacyLazy<T>::try_get()
+    const noexcept
+  {
+    auto node = m_value.load(std::memory_order_acquire);
+
+    return node ? node->get() : nullptr;
+  }
+
+  template<typename T>
+  inline typename RacyLazy<T>::reference
+    RacyLazy<T>::operator*()
+    const
+  {
+    return *get();
+  }
+
+  template<typename T>
+  inline typename RacyLazy<T>::pointer
+    RacyLazy<T>::operator->()
+    const
+  {
+    return get();
+  }
+
+  //--------------------------------------------------------------------------
+  // Private Member Functions
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  typename RacyLazy<T>::pointer
+    RacyLazy<T>::initialize()
+    const
+  {
+    auto node     = std::unique_ptr<value_node_type>(new value_node_type(m_function));
+    auto expected = static_cast<value_node_type*>(nullptr);
+
+    if( !m_value.compare_exchange_strong(expected, node.get(),
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire) ) {
+      // Another thread won the race; its T is used, and this one destroyed
+      return expected->get();
+    }
+    return node.release()->get();
+  }
+
+} // namespace lazy
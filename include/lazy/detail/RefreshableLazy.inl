@@ -0,0 +1,139 @@
+namespace lazy{
+
+  //--------------------------------------------------------------------------
+  // Constructors / Destructor / Assignment
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline RefreshableLazy<T>::RefreshableLazy()
+    : m_function(),
+      m_value(nullptr),
+      m_mutex()
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename>
+  inline RefreshableLazy<T>::RefreshableLazy( Ctor&& constructor )
+    : m_function(std::forward<Ctor>(constructor)),
+      m_value(nullptr),
+      m_mutex()
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename Dtor, typename, typename>
+  inline RefreshableLazy<T>::RefreshableLazy( Ctor&& constructor,
+                                              Dtor&& destructor )
+    : m_function(std::forward<Ctor>(constructor),std::forward<Dtor>(destructor)),
+      m_value(nullptr),
+      m_mutex()
+  {
+
+  }
+
+  template<typename T>
+  inline RefreshableLazy<T>::RefreshableLazy( const value_type& value )
+    : m_function(value),
+      m_value(nullptr),
+      m_mutex()
+  {
+
+  }
+
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline RefreshableLazy<T>::~RefreshableLazy()
+  {
+    delete m_value.load(std::memory_order_acquire);
+  }
+
+  //--------------------------------------------------------------------------
+  // Modifiers
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline void RefreshableLazy<T>::refresh()
+  {
+    auto node = new value_node_type(m_function);
+
+    retire( m_value.exchange(node, std::memory_order_acq_rel) );
+  }
+
+  template<typename T>
+  inline void RefreshableLazy<T>::invalidate()
+  {
+    retire( m_value.exchange(nullptr, std::memory_order_acq_rel) );
+  }
+
+  //--------------------------------------------------------------------------
+  // Observers
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline bool RefreshableLazy<T>::is_initialized()
+    const noexcept
+  {
+    return m_value.load(std::memory_order_acquire) != nullptr;
+  }
+
+  template<typename T>
+  inline typename RefreshableLazy<T>::snapshot
+    RefreshableLazy<T>::get()
+    const
+  {
+    auto guard = detail::epoch_guard();
+    auto node  = m_value.load(std::memory_order_acquire);
+
+    if( LAZY_UNLIKELY(!node) ) node = initialize();
+
+    return snapshot(std::move(guard), node->get());
+  }
+
+  template<typename T>
+  inline typename RefreshableLazy<T>::snapshot
+    RefreshableLazy<T>::operator->()
+    const
+  {
+    return get();
+  }
+
+  //--------------------------------------------------------------------------
+  // Private Member Functions
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  typename RefreshableLazy<T>::value_node_type*
+    RefreshableLazy<T>::initialize()
+    const
+  {
+    // The lock only keeps concurrent first accesses from each constructing a
+    // T; it is never held while waiting for readers, so readers may take it
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto node = m_value.load(std::memory_order_acquire);
+    if( node ) return node;
+
+    auto result = std::unique_ptr<value_node_type>(new value_node_type(m_function));
+
+    // A concurrent refresh may have published a T in the meantime
+    if( !m_value.compare_exchange_strong(node, result.get(), std::memory_order_acq_rel) ) {
+      return node;
+    }
+    return result.release();
+  }
+
+  template<typename T>
+  inline void RefreshableLazy<T>::retire( value_node_type* node )
+    noexcept
+  {
+    if( !node ) return;
+
+    detail::epoch_domain::instance().synchronize();
+    delete node;
+  }
+
+} // namespace lazy
@@ -0,0 +1,185 @@
+namespace lazy{
+
+  //--------------------------------------------------------------------------
+  // Constructors / Destructor / Assignment
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline ShardedLazy<T>::ShardedLazy()
+    : ShardedLazy(default_shard_count())
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename>
+  inline ShardedLazy<T>::ShardedLazy( Ctor&& constructor )
+    : ShardedLazy(default_shard_count(),std::forward<Ctor>(constructor))
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename Dtor, typename, typename>
+  inline ShardedLazy<T>::ShardedLazy( Ctor&& constructor,
+                                      Dtor&& destructor )
+    : ShardedLazy(default_shard_count(),std::forward<Ctor>(constructor),std::forward<Dtor>(destructor))
+  {
+
+  }
+
+  template<typename T>
+  inline ShardedLazy<T>::ShardedLazy( const value_type& value )
+    : ShardedLazy(default_shard_count(),value)
+  {
+
+  }
+
+  template<typename T>
+  inline ShardedLazy<T>::ShardedLazy( shards count )
+    : m_buffer(nullptr),
+      m_shards(nullptr),
+      m_mask(0)
+  {
+    create_shards( count, detail::erased_function<T>() );
+  }
+
+  template<typename T>
+  template<typename Ctor, typename>
+  inline ShardedLazy<T>::ShardedLazy( shards count, Ctor&& constructor )
+    : m_buffer(nullptr),
+      m_shards(nullptr),
+      m_mask(0)
+  {
+    create_shards( count, detail::erased_function<T>(std::forward<Ctor>(constructor)) );
+  }
+
+  template<typename T>
+  template<typename Ctor, typename Dtor, typename, typename>
+  inline ShardedLazy<T>::ShardedLazy( shards count,
+                                      Ctor&& constructor,
+                                      Dtor&& destructor )
+    : m_buffer(nullptr),
+      m_shards(nullptr),
+      m_mask(0)
+  {
+    create_shards( count, detail::erased_function<T>(std::forward<Ctor>(constructor),
+                                                     std::forward<Dtor>(destructor)) );
+  }
+
+  template<typename T>
+  inline ShardedLazy<T>::ShardedLazy( shards count, const value_type& value )
+    : m_buffer(nullptr),
+      m_shards(nullptr),
+      m_mask(0)
+  {
+    create_shards( count, detail::erased_function<T>(value) );
+  }
+
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline ShardedLazy<T>::~ShardedLazy()
+  {
+    destroy_shards( shard_count() );
+  }
+
+  //--------------------------------------------------------------------------
+  // Observers
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline typename ShardedLazy<T>::pointer
+    ShardedLazy<T>::get()
+    const
+  {
+    return m_shards[detail::current_cpu() & m_mask].lazy.get();
+  }
+
+  template<typename T>
+  inline typename ShardedLazy<T>::reference
+    ShardedLazy<T>::operator*()
+    const
+  {
+    return *get();
+  }
+
+  template<typename T>
+  inline typename ShardedLazy<T>::pointer
+    ShardedLazy<T>::operator->()
+    const
+  {
+    return get();
+  }
+
+  template<typename T>
+  inline std::size_t ShardedLazy<T>::shard_count()
+    const noexcept
+  {
+    return m_mask + 1;
+  }
+
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  template<typename U, typename Function>
+  inline U ShardedLazy<T>::combine( U init, Function&& function )
+    const
+  {
+    for( auto i = std::size_t(0); i < shard_count(); ++i ) {
+      if( auto shard = m_shards[i].lazy.try_get() ) {
+        init = function( std::move(init), *shard );
+      }
+    }
+    return init;
+  }
+
+  //--------------------------------------------------------------------------
+  // Private Member Functions
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline shards ShardedLazy<T>::default_shard_count()
+    noexcept
+  {
+    return shards( std::thread::hardware_concurrency() );
+  }
+
+  template<typename T>
+  inline void ShardedLazy<T>::create_shards( shards requested,
+                                             const detail::erased_function<T>& function )
+  {
+    auto count = std::size_t(1);
+    while( count < requested.count ) count <<= 1;
+
+    // Heap allocations are not guaranteed to honour alignas before C++17,
+    // so the shards are aligned by hand
+    auto space  = count * sizeof(shard_type) + alignof(shard_type);
+    m_buffer    = ::operator new(space);
+    auto aligned = m_buffer;
+    std::align( alignof(shard_type), count * sizeof(shard_type), aligned, space );
+    m_shards    = static_cast<shard_type*>(aligned);
+
+    auto i = std::size_t(0);
+    try {
+      for( ; i < count; ++i ) {
+        new (&m_shards[i]) shard_type(function);
+      }
+    } catch( ... ) {
+      destroy_shards( i );
+      throw;
+    }
+    m_mask = count - 1;
+  }
+
+  template<typename T>
+  inline void ShardedLazy<T>::destroy_shards( std::size_t count )
+    noexcept
+  {
+    while( count != 0 ) {
+      m_shards[--count].~shard_type();
+    }
+    ::operator delete(m_buffer);
+  }
+
+} // namespace lazy
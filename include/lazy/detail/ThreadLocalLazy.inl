@@ -0,0 +1,123 @@
+namespace lazy{
+
+  //--------------------------------------------------------------------------
+  // Constructors / Destructor / Assignment
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline ThreadLocalLazy<T>::ThreadLocalLazy()
+    : m_function(),
+      m_owner()
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename>
+  inline ThreadLocalLazy<T>::ThreadLocalLazy( Ctor&& constructor )
+    : m_function(std::forward<Ctor>(constructor)),
+      m_owner()
+  {
+
+  }
+
+  template<typename T>
+  template<typename Ctor, typename Dtor, typename, typename>
+  inline ThreadLocalLazy<T>::ThreadLocalLazy( Ctor&& constructor,
+                                              Dtor&& destructor )
+    : m_function(std::forward<Ctor>(constructor),std::forward<Dtor>(destructor)),
+      m_owner()
+  {
+
+  }
+
+  template<typename T>
+  inline ThreadLocalLazy<T>::ThreadLocalLazy( const value_type& value )
+    : m_function(value),
+      m_owner()
+  {
+
+  }
+
+  //--------------------------------------------------------------------------
+  // Observers
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline bool ThreadLocalLazy<T>::is_initialized()
+    const
+  {
+    return m_owner.find() != nullptr;
+  }
+
+  template<typename T>
+  inline typename ThreadLocalLazy<T>::pointer
+    ThreadLocalLazy<T>::get()
+    const
+  {
+    auto node = m_owner.find();
+
+    if( LAZY_UNLIKELY(!node) ) return initialize();
+
+    return static_cast<value_node_type*>(node)->get();
+  }
+
+  template<typename T>
+  inline typename ThreadLocalLazy<T>::pointer
+    ThreadLocalLazy<T>::try_get()
+    const
+  {
+    auto node = m_owner.find();
+
+    return node ? static_cast<value_node_type*>(node)->get() : nullptr;
+  }
+
+  template<typename T>
+  inline typename ThreadLocalLazy<T>::reference
+    ThreadLocalLazy<T>::operator*()
+    const
+  {
+    return *get();
+  }
+
+  template<typename T>
+  inline typename ThreadLocalLazy<T>::pointer
+    ThreadLocalLazy<T>::operator->()
+    const
+  {
+    return get();
+  }
+
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  template<typename Function>
+  inline void ThreadLocalLazy<T>::for_each_instance( Function&& function )
+    const
+  {
+    m_owner.for_each([&function]( detail::thread_local_node& node ){
+      function( *static_cast<value_node_type&>(node).get() );
+    });
+  }
+
+  //--------------------------------------------------------------------------
+  // Private Member Functions
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  typename ThreadLocalLazy<T>::pointer
+    ThreadLocalLazy<T>::initialize()
+    const
+  {
+    // The T is constructed before taking the registry's lock, so that
+    // construction may access other ThreadLocalLazy objects, and is not
+    // serialized with the construction of other threads
+    auto node = std::unique_ptr<value_node_type>(new value_node_type(m_function));
+    auto result = node->get();
+
+    m_owner.insert(node.release());
+
+    return result;
+  }
+
+} // namespace lazy
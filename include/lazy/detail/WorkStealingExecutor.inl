@@ -0,0 +1,208 @@
+namespace lazy{
+
+  //--------------------------------------------------------------------------
+  // Constructors / Destructor / Assignment
+  //--------------------------------------------------------------------------
+
+  inline WorkStealingExecutor::WorkStealingExecutor()
+    : WorkStealingExecutor(std::thread::hardware_concurrency())
+  {
+
+  }
+
+  inline WorkStealingExecutor::WorkStealingExecutor( std::size_t thread_count )
+    : m_workers(),
+      m_threads(),
+      m_pending(0),
+      m_next(0),
+      m_sleeping(0),
+      m_stopping(false),
+      m_mutex(),
+      m_wakeup()
+  {
+    if( thread_count == 0 ) thread_count = 1;
+
+    // Every worker's queues exist before any thread can steal from them
+    for( auto i = std::size_t(0); i < thread_count; ++i ) {
+      m_workers.emplace_back(new worker());
+    }
+    for( auto i = std::size_t(0); i < thread_count; ++i ) {
+      m_threads.emplace_back(&WorkStealingExecutor::run, this, i);
+    }
+  }
+
+  //--------------------------------------------------------------------------
+
+  inline WorkStealingExecutor::~WorkStealingExecutor()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping.store(true);
+    }
+    m_wakeup.notify_all();
+
+    for( auto& thread : m_threads ) {
+      thread.join();
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // Execution
+  //--------------------------------------------------------------------------
+
+  template<typename Function>
+  inline void WorkStealingExecutor::execute( Function&& function )
+  {
+    submit( task_type(std::forward<Function>(function)), priority::normal );
+  }
+
+  template<typename Function>
+  inline void WorkStealingExecutor::execute( Function&& function,
+                                             priority task_priority )
+  {
+    submit( task_type(std::forward<Function>(function)), task_priority );
+  }
+
+  //--------------------------------------------------------------------------
+  // Observers
+  //--------------------------------------------------------------------------
+
+  inline std::size_t WorkStealingExecutor::thread_count()
+    const noexcept
+  {
+    return m_workers.size();
+  }
+
+  //--------------------------------------------------------------------------
+  // Private Member Functions
+  //--------------------------------------------------------------------------
+
+  inline void WorkStealingExecutor::submit( task_type task, priority task_priority )
+  {
+    auto index = current_worker();
+    if( index == thread_count() ) {
+      index = m_next.fetch_add(1, std::memory_order_relaxed) % thread_count();
+    }
+
+    // Counted before it is queued, so that taking it never finds the count
+    // at zero. This pairs with the increment of m_sleeping in run, so that
+    // either this sees the sleeping worker, or the worker sees the task
+    m_pending.fetch_add(1);
+    {
+      auto& target = *m_workers[index];
+      std::lock_guard<std::mutex> lock(target.mutex);
+      target.tasks[static_cast<int>(task_priority)].push_back(std::move(task));
+    }
+
+    if( m_sleeping.load() > 0 ) {
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+      }
+      m_wakeup.notify_one();
+    }
+  }
+
+  inline bool WorkStealingExecutor::take( std::size_t index,
+                                          std::uint32_t& seed,
+                                          task_type& task )
+  {
+    const auto count = thread_count();
+
+    // xorshift32, to pick where to start looking for a victim
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    const auto start = static_cast<std::size_t>(seed % count);
+
+    for( auto level = 2; level-- > 0; ) {
+      {
+        auto& own = *m_workers[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        auto& tasks = own.tasks[level];
+        if( !tasks.empty() ) {
+          task = std::move(tasks.back());
+          tasks.pop_back();
+          return true;
+        }
+      }
+      for( auto i = std::size_t(0); i < count; ++i ) {
+        const auto victim_index = (start + i) % count;
+        if( victim_index == index ) continue;
+
+        auto& victim = *m_workers[victim_index];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        auto& tasks = victim.tasks[level];
+        if( !tasks.empty() ) {
+          task = std::move(tasks.front());
+          tasks.pop_front();
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  inline void WorkStealingExecutor::run( std::size_t index )
+    noexcept
+  {
+    current() = std::make_pair(this, index);
+
+    auto seed = static_cast<std::uint32_t>(index) * 2654435761u + 1u;
+    auto task = task_type();
+
+    while( true ) {
+      auto found = false;
+      for( auto spin = 0; !found && spin <= LAZY_SPIN_COUNT; ++spin ) {
+        if( spin > 0 ) std::this_thread::yield();
+        found = take(index, seed, task);
+      }
+
+      if( found ) {
+        m_pending.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        task = nullptr;
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_sleeping.fetch_add(1);
+      m_wakeup.wait(lock, [this](){
+        return m_pending.load() > 0 || m_stopping.load();
+      });
+      m_sleeping.fetch_sub(1);
+
+      if( m_stopping.load() && m_pending.load() == 0 ) break;
+    }
+
+    current() = std::make_pair(nullptr, std::size_t(0));
+  }
+
+  inline std::size_t WorkStealingExecutor::current_worker()
+    const noexcept
+  {
+    const auto& context = current();
+
+    return context.first == this ? context.second : thread_count();
+  }
+
+  inline std::pair<const WorkStealingExecutor*,std::size_t>&
+    WorkStealingExecutor::current()
+    noexcept
+  {
+    static thread_local std::pair<const WorkStealingExecutor*,std::size_t> context(nullptr, 0);
+
+    return context;
+  }
+
+  //--------------------------------------------------------------------------
+  // Free Functions
+  //--------------------------------------------------------------------------
+
+  inline WorkStealingExecutor& default_executor()
+  {
+    // Never destroyed, so that it outlives every static lazy object
+    static auto* executor = new WorkStealingExecutor();
+    return *executor;
+  }
+
+} // namespace lazy
@@ -0,0 +1,120 @@
+/**
+ * \file atomic_wait.hpp
+ *
+ * \brief This file contains the primitives used to park a thread until an
+ *        atomic state word changes.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_ATOMIC_WAIT_HPP_
+#define LAZY_DETAIL_ATOMIC_WAIT_HPP_
+
+#include "lazy_config.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+/// \def LAZY_ATOMIC_WAIT_STD
+///
+/// \brief Whether threads are parked with \c std::atomic::wait
+///
+/// \def LAZY_ATOMIC_WAIT_FUTEX
+///
+/// \brief Whether threads are parked with a Linux futex
+///
+/// When neither is available, parked threads yield in a loop instead.
+#ifndef LAZY_ATOMIC_WAIT_STD
+# if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+#  define LAZY_ATOMIC_WAIT_STD 1
+# else
+#  define LAZY_ATOMIC_WAIT_STD 0
+# endif
+#endif
+#ifndef LAZY_ATOMIC_WAIT_FUTEX
+# if !LAZY_ATOMIC_WAIT_STD && defined(__linux__)
+#  define LAZY_ATOMIC_WAIT_FUTEX 1
+# else
+#  define LAZY_ATOMIC_WAIT_FUTEX 0
+# endif
+#endif
+
+#if LAZY_ATOMIC_WAIT_FUTEX
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# include <climits>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+# include <intrin.h>
+#endif
+
+namespace lazy{
+  namespace detail{
+
+    /// \brief The type of an atomic state word that threads can wait on
+    using atomic_wait_type = std::atomic<std::uint32_t>;
+
+    /// \brief Hints to the processor that the calling thread is spinning
+    inline void cpu_relax() noexcept
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+      __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+      asm volatile("yield" ::: "memory");
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+      _mm_pause();
+#endif
+    }
+
+    /// \brief Blocks the calling thread while \p state holds \p old
+    ///
+    /// This may return spuriously, so callers must re-check \p state.
+    ///
+    /// \param state the state word to wait on
+    /// \param old   the value to wait for \p state to change from
+    inline void atomic_wait( const atomic_wait_type& state, std::uint32_t old ) noexcept
+    {
+#if LAZY_ATOMIC_WAIT_STD
+      state.wait(old,std::memory_order_acquire);
+#elif LAZY_ATOMIC_WAIT_FUTEX
+      static_assert(sizeof(atomic_wait_type)==sizeof(std::uint32_t),
+                    "futex requires a 32-bit state word");
+
+      ::syscall(SYS_futex,
+                const_cast<atomic_wait_type*>(&state),
+                FUTEX_WAIT_PRIVATE,
+                old,
+                nullptr, nullptr, 0);
+#else
+      if( state.load(std::memory_order_acquire) == old ) {
+        std::this_thread::yield();
+      }
+#endif
+    }
+
+    /// \brief Wakes all threads blocked in \c atomic_wait on \p state
+    ///
+    /// \param state the state word being waited on
+    inline void atomic_notify_all( atomic_wait_type& state ) noexcept
+    {
+#if LAZY_ATOMIC_WAIT_STD
+      state.notify_all();
+#elif LAZY_ATOMIC_WAIT_FUTEX
+      ::syscall(SYS_futex,
+                &state,
+                FUTEX_WAKE_PRIVATE,
+                INT_MAX,
+                nullptr, nullptr, 0);
+#else
+      (void) state;
+#endif
+    }
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_ATOMIC_WAIT_HPP_ */
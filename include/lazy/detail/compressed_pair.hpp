@@ -0,0 +1,104 @@
+/**
+ * \file compressed_pair.hpp
+ *
+ * \brief This file contains a pair type that applies the empty-base
+ *        optimization to its members.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_COMPRESSED_PAIR_HPP_
+#define LAZY_DETAIL_COMPRESSED_PAIR_HPP_
+
+#include "lazy_traits.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace lazy{
+  namespace detail{
+
+    /// \brief Storage for a single member of a \c compressed_pair
+    ///
+    /// Empty, non-final class types are inherited from so that they occupy
+    /// no storage; everything else is stored as a regular member.
+    ///
+    /// \tparam T     the type being stored
+    /// \tparam Index the index of the member in the pair (to allow two
+    ///               members of the same type)
+    ///
+    /// \note \c static_cast is used in place of \c std::forward, which is not
+    ///       \c constexpr until C++14
+    template<typename T, std::size_t Index, bool = is_ebo_candidate<T>::value>
+    class ebo_storage
+    {
+    public:
+
+      constexpr ebo_storage() : m_value(){}
+
+      template<typename U>
+      constexpr explicit ebo_storage( U&& value ) : m_value(static_cast<U&&>(value)){}
+
+      T& get() noexcept{ return m_value; }
+      const T& get() const noexcept{ return m_value; }
+
+    private:
+
+      T m_value;
+    };
+
+    template<typename T, std::size_t Index>
+    class ebo_storage<T,Index,true> : private T
+    {
+    public:
+
+      constexpr ebo_storage() : T(){}
+
+      template<typename U>
+      constexpr explicit ebo_storage( U&& value ) : T(static_cast<U&&>(value)){}
+
+      T& get() noexcept{ return *this; }
+      const T& get() const noexcept{ return *this; }
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief A pair that takes no storage for empty member types
+    ///
+    /// This is used to store the construction and destruction functions of
+    /// a \c BasicLazy so that stateless functors (such as captureless
+    /// lambdas) don't contribute to the size of the \c BasicLazy.
+    ///
+    /// \tparam T0 the first type
+    /// \tparam T1 the second type
+    template<typename T0, typename T1>
+    class compressed_pair : private ebo_storage<T0,0>,
+                            private ebo_storage<T1,1>
+    {
+      using first_base  = ebo_storage<T0,0>;
+      using second_base = ebo_storage<T1,1>;
+
+    public:
+
+      constexpr compressed_pair() : first_base(), second_base(){}
+
+      template<typename U0, typename U1>
+      constexpr compressed_pair( U0&& first, U1&& second )
+        : first_base(static_cast<U0&&>(first)),
+          second_base(static_cast<U1&&>(second))
+      {
+
+      }
+
+      T0& first() noexcept{ return first_base::get(); }
+      const T0& first() const noexcept{ return first_base::get(); }
+
+      T1& second() noexcept{ return second_base::get(); }
+      const T1& second() const noexcept{ return second_base::get(); }
+    };
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_COMPRESSED_PAIR_HPP_ */
@@ -0,0 +1,74 @@
+/**
+ * \file current_cpu.hpp
+ *
+ * \brief This file contains the lookup of the processor that the calling
+ *        thread is running on.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_CURRENT_CPU_HPP_
+#define LAZY_DETAIL_CURRENT_CPU_HPP_
+
+#include <atomic>
+#include <cstddef>
+
+/// \def LAZY_HAS_SCHED_GETCPU
+///
+/// \brief Whether \c sched_getcpu is available to find the processor of the
+///        calling thread
+///
+/// When it is not, each thread is instead assigned a fixed index, in the
+/// order of their first lookup.
+#ifndef LAZY_HAS_SCHED_GETCPU
+# if defined(__linux__) && defined(_GNU_SOURCE)
+#  define LAZY_HAS_SCHED_GETCPU 1
+# else
+#  define LAZY_HAS_SCHED_GETCPU 0
+# endif
+#endif
+
+#if LAZY_HAS_SCHED_GETCPU
+# include <sched.h>
+#endif
+
+namespace lazy{
+  namespace detail{
+
+    /// \brief Gets a fixed index for the calling thread
+    ///
+    /// Indices are handed out consecutively, so that their low bits spread
+    /// threads evenly over a power-of-two number of shards. (The hash of a
+    /// \c std::thread::id may be an aligned address, with its low bits
+    /// always zero.)
+    ///
+    /// \return the index
+    inline std::size_t current_thread_index()
+    {
+      static std::atomic<std::size_t> next_index(0);
+
+      thread_local const auto index = next_index.fetch_add(1, std::memory_order_relaxed);
+      return index;
+    }
+
+    /// \brief Gets the index of the processor the calling thread is running
+    ///        on
+    ///
+    /// The thread may be moved to another processor at any time, so this is
+    /// only a hint, suitable for spreading threads over shards.
+    ///
+    /// \return the index of the processor
+    inline std::size_t current_cpu()
+    {
+#if LAZY_HAS_SCHED_GETCPU
+      const auto cpu = ::sched_getcpu();
+      if( cpu >= 0 ) return static_cast<std::size_t>(cpu);
+#endif
+      return current_thread_index();
+    }
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_CURRENT_CPU_HPP_ */
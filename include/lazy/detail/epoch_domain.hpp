@@ -0,0 +1,211 @@
+/**
+ * \file epoch_domain.hpp
+ *
+ * \brief This file contains the epoch-based reclamation used to destroy
+ *        values that threads may still be reading.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_EPOCH_DOMAIN_HPP_
+#define LAZY_DETAIL_EPOCH_DOMAIN_HPP_
+
+#include "lazy_config.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace lazy{
+  namespace detail{
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The epoch announced by one thread
+    ///
+    /// Records are never freed; a record is handed to another thread once the
+    /// thread owning it exits.
+    ////////////////////////////////////////////////////////////////////////////
+    struct epoch_record
+    {
+      std::atomic<std::uint64_t> epoch{0};     ///< The epoch being read in, or 0 if none
+      std::atomic<bool>          in_use{true}; ///< Whether a thread owns this record
+      epoch_record*              next = nullptr; ///< The next record of the domain
+      unsigned                   depth = 0;    ///< The number of guards held by the owner
+
+      /// Keeps the epoch of each thread on its own cache line
+      char padding[LAZY_CACHE_LINE_SIZE];
+    };
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The process-wide epoch, and the record of every thread
+    ///
+    /// A thread reading a shared object announces the current epoch in its
+    /// record for as long as it reads. A writer that has unpublished an
+    /// object advances the epoch, and waits until every thread has either
+    /// stopped reading or announced a later epoch; no thread can then still
+    /// reference the object, and it can be destroyed.
+    ///
+    /// Entering and leaving a read are wait-free: a load, a store, and a
+    /// fence on the calling thread's own record.
+    ////////////////////////////////////////////////////////////////////////////
+    class epoch_domain
+    {
+    public:
+
+      /// \brief Gets the domain
+      ///
+      /// \note The domain is never destroyed, so that threads exiting during
+      ///       static destruction can still use it
+      ///
+      /// \return the domain
+      static epoch_domain& instance()
+      {
+        static auto* domain = new epoch_domain();
+        return *domain;
+      }
+
+      /// \brief Gets the record of the calling thread
+      ///
+      /// \return the record
+      epoch_record& current_record()
+      {
+        thread_local const record_owner owner(*this);
+        return *owner.record;
+      }
+
+      /// \brief Announces that the calling thread has started reading
+      ///
+      /// \param record the record of the calling thread
+      void enter( epoch_record& record ) noexcept
+      {
+        if( record.depth++ != 0 ) return;
+
+        // The acquire pairs with the advance in synchronize, so that a reader
+        // announcing the new epoch also sees everything unpublished before it
+        record.epoch.store( m_epoch.load(std::memory_order_acquire), std::memory_order_relaxed );
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+      }
+
+      /// \brief Announces that the calling thread has stopped reading
+      ///
+      /// \param record the record of the calling thread
+      void exit( epoch_record& record ) noexcept
+      {
+        if( --record.depth != 0 ) return;
+
+        record.epoch.store( 0, std::memory_order_release );
+      }
+
+      /// \brief Waits until no thread can still be reading anything that was
+      ///        unpublished before this call
+      ///
+      /// \note The calling thread must not be reading
+      void synchronize() noexcept
+      {
+        // Pairs with the fence in enter: either the reader sees what was
+        // unpublished, or this sees the reader's epoch
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const auto target = m_epoch.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+        for( auto record = m_records.load(std::memory_order_acquire); record; record = record->next ) {
+          for( ;; ) {
+            const auto epoch = record->epoch.load(std::memory_order_acquire);
+            if( epoch == 0 || epoch >= target ) break;
+
+            std::this_thread::yield();
+          }
+        }
+      }
+
+    private:
+
+      /// \brief Holds the record of one thread until it exits
+      struct record_owner
+      {
+        explicit record_owner( epoch_domain& domain )
+          : record(domain.acquire_record())
+        {
+
+        }
+
+        ~record_owner()
+        {
+          record->in_use.store(false, std::memory_order_release);
+        }
+
+        epoch_record* record;
+      };
+
+      epoch_domain() = default;
+
+      /// \brief Takes a record that no thread owns, or creates one
+      ///
+      /// \return the record
+      epoch_record* acquire_record()
+      {
+        for( auto record = m_records.load(std::memory_order_acquire); record; record = record->next ) {
+          auto in_use = false;
+          if( !record->in_use.load(std::memory_order_relaxed) &&
+              record->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire) ) {
+            return record;
+          }
+        }
+
+        auto record = new epoch_record();
+        record->next = m_records.load(std::memory_order_relaxed);
+        while( !m_records.compare_exchange_weak(record->next, record,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed) ) {}
+        return record;
+      }
+
+      std::atomic<std::uint64_t> m_epoch{1};         ///< The current epoch
+      std::atomic<epoch_record*> m_records{nullptr}; ///< The record of every thread
+    };
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief Announces that the calling thread is reading for the lifetime
+    ///        of this guard
+    ///
+    /// Guards may be nested, but must be destroyed on the thread that created
+    /// them.
+    ////////////////////////////////////////////////////////////////////////////
+    class epoch_guard
+    {
+    public:
+
+      epoch_guard()
+        : m_record(&epoch_domain::instance().current_record())
+      {
+        epoch_domain::instance().enter(*m_record);
+      }
+
+      epoch_guard( epoch_guard&& other ) noexcept
+        : m_record(other.m_record)
+      {
+        other.m_record = nullptr;
+      }
+
+      epoch_guard( const epoch_guard& ) = delete;
+      epoch_guard& operator=( const epoch_guard& ) = delete;
+
+      ~epoch_guard()
+      {
+        if( m_record ) epoch_domain::instance().exit(*m_record);
+      }
+
+    private:
+
+      epoch_record* m_record; ///< The record of the owning thread
+    };
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_EPOCH_DOMAIN_HPP_ */
@@ -0,0 +1,90 @@
+/**
+ * \file executor_ref.hpp
+ *
+ * \brief This file contains a non-owning, type-erased reference to an
+ *        executor.
+ *
+ * An executor is any object \c e for which \c e.execute(f) runs the nullary
+ * function \c f, now or later, on some thread.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_EXECUTOR_REF_HPP_
+#define LAZY_DETAIL_EXECUTOR_REF_HPP_
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace lazy{
+  namespace detail{
+
+    /// \brief A nullary function, for checking whether a type is an executor
+    struct executor_probe
+    {
+      void operator()() const{}
+    };
+
+    /// \brief Type trait to determine whether \c T is an executor: an object
+    ///        \c e for which \c e.execute(f) runs the nullary function \c f
+    ///
+    /// The result is aliased as \c ::value
+    template<typename T, typename = void>
+    struct is_executor : std::false_type{};
+
+    template<typename T>
+    struct is_executor<T,decltype(void(std::declval<T&>().execute(executor_probe())))>
+      : std::true_type{};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief A reference to an executor of any type, which submits tasks
+    ///        without allocating
+    ///
+    /// A task is a function pointer and the context it is called with, which
+    /// is submitted to the executor as a small function object.
+    ///
+    /// \note The executor must outlive every \c executor_ref to it
+    ////////////////////////////////////////////////////////////////////////////
+    class executor_ref final
+    {
+    public:
+
+      using task_function = void(*)(void*);
+
+      template<typename Executor>
+      explicit executor_ref( Executor& executor ) noexcept
+        : m_executor(const_cast<void*>(static_cast<const void*>(std::addressof(executor)))),
+          m_execute(&execute_with<Executor>)
+      {
+
+      }
+
+      /// \brief Submits \p task, to be called with \p context
+      ///
+      /// \param task    the function to call
+      /// \param context the argument to call \p task with
+      void execute( task_function task, void* context ) const
+      {
+        m_execute(m_executor, task, context);
+      }
+
+    private:
+
+      template<typename Executor>
+      static void execute_with( void* executor, task_function task, void* context )
+      {
+        static_cast<Executor*>(executor)->execute([task,context](){
+          task(context);
+        });
+      }
+
+      void* m_executor;                                 ///< The executor
+      void (*m_execute)(void*, task_function, void*);   ///< Submits to the executor
+    };
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_EXECUTOR_REF_HPP_ */
@@ -0,0 +1,153 @@
+/**
+ * \file function_buffer.hpp
+ *
+ * \brief This file contains a small-buffer used for storing type-erased
+ *        function objects without allocating.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_FUNCTION_BUFFER_HPP_
+#define LAZY_DETAIL_FUNCTION_BUFFER_HPP_
+
+#include "lazy_config.hpp"
+#include "lazy_traits.hpp"
+
+#include <type_traits>
+#include <utility>
+#include <new>
+
+namespace lazy{
+  namespace detail{
+
+    /// \brief Storage for a type-erased function object
+    ///
+    /// Function objects are stored inline in \c data when they fit, and are
+    /// otherwise allocated and referenced by \c heap. The buffer is always
+    /// large enough to hold a pointer.
+    ///
+    /// \tparam Size the number of bytes to reserve for inline storage
+    template<std::size_t Size>
+    union function_buffer
+    {
+      static constexpr std::size_t size = (Size < sizeof(void*)) ? sizeof(void*) : Size;
+
+      void* heap; ///< The allocated function, if not stored inline
+      typename std::aligned_storage<size,alignof(void*)>::type data; ///< The inline storage
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief Type trait to determine whether the function object \c F may be
+    ///        stored inline in a \c function_buffer<Size>
+    ///
+    /// The result is aliased as \c ::value
+    template<typename F, std::size_t Size>
+    struct is_inline_storable : boolean_constant<
+      sizeof(F) <= function_buffer<Size>::size &&
+      alignof(F) <= alignof(function_buffer<Size>) &&
+      std::is_nothrow_move_constructible<F>::value
+    >{};
+
+    //------------------------------------------------------------------------
+
+    /// \brief Operations for managing a function object of type \c F stored
+    ///        in a \c function_buffer<Size>
+    ///
+    /// This primary template manages function objects stored inline
+    ///
+    /// \tparam F    the type of the function object
+    /// \tparam Size the size of the buffer
+    template<typename F, std::size_t Size, bool = is_inline_storable<F,Size>::value>
+    struct function_storage
+    {
+      using buffer_type = function_buffer<Size>;
+
+      /// \brief Retrieves the function object stored in \p buffer
+      static F& get( buffer_type& buffer ) noexcept
+      {
+        return *static_cast<F*>(static_cast<void*>(&buffer.data));
+      }
+
+      /// \brief Retrieves the function object stored in \p buffer
+      static const F& get( const buffer_type& buffer ) noexcept
+      {
+        return *static_cast<const F*>(static_cast<const void*>(&buffer.data));
+      }
+
+      /// \brief Constructs the function object in \p buffer from \p args
+      template<typename...Args>
+      static void create( buffer_type& buffer, Args&&...args )
+      {
+        new (&buffer.data) F( std::forward<Args>(args)... );
+      }
+
+      /// \brief Copies the function object in \p source into \p destination
+      static void copy( const buffer_type& source, buffer_type& destination )
+      {
+        create( destination, get(source) );
+      }
+
+      /// \brief Moves the function object in \p source into \p destination,
+      ///        leaving \p source empty
+      static void move( buffer_type& source, buffer_type& destination ) noexcept
+      {
+        create( destination, std::move(get(source)) );
+        destroy( source );
+      }
+
+      /// \brief Destroys the function object in \p buffer
+      static void destroy( buffer_type& buffer ) noexcept
+      {
+        get(buffer).~F();
+      }
+    };
+
+    /// \brief Operations for managing a function object of type \c F that is
+    ///        too large to store inline in a \c function_buffer<Size>
+    template<typename F, std::size_t Size>
+    struct function_storage<F,Size,false>
+    {
+      using buffer_type = function_buffer<Size>;
+
+      static F& get( buffer_type& buffer ) noexcept
+      {
+        return *static_cast<F*>(buffer.heap);
+      }
+
+      static const F& get( const buffer_type& buffer ) noexcept
+      {
+        return *static_cast<const F*>(buffer.heap);
+      }
+
+      template<typename...Args>
+      static void create( buffer_type& buffer, Args&&...args )
+      {
+        static_assert(LAZY_HEAP_FALLBACK_ENABLED || is_inline_storable<F,Size>::value,
+                      "Construction function does not fit in the inline buffer, and LAZY_NO_HEAP_FALLBACK is defined");
+
+        buffer.heap = new F( std::forward<Args>(args)... );
+      }
+
+      static void copy( const buffer_type& source, buffer_type& destination )
+      {
+        create( destination, get(source) );
+      }
+
+      static void move( buffer_type& source, buffer_type& destination ) noexcept
+      {
+        destination.heap = source.heap;
+        source.heap = nullptr;
+      }
+
+      static void destroy( buffer_type& buffer ) noexcept
+      {
+        delete static_cast<F*>(buffer.heap);
+      }
+    };
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_FUNCTION_BUFFER_HPP_ */
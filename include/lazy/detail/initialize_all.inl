@@ -0,0 +1,174 @@
+namespace lazy{
+  namespace detail{
+
+    /// \brief The visitor that initializes a lazy object
+    struct initialize_visitor
+    {
+      template<typename Lazy>
+      void operator()( Lazy& lazy ) const
+      {
+        lazy.get();
+      }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The state shared by the threads of an \c initialize_all
+    ///
+    /// The state is shared with the submitted tasks, since a task may only
+    /// start once every element has been visited and the caller has
+    /// returned; such a task finds nothing left, and touches no element.
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename Element, typename Visitor>
+    class bulk_initialization final
+    {
+    public:
+
+      bulk_initialization( std::vector<Element*> elements, Visitor visitor )
+        : m_elements(std::move(elements)),
+          m_visitor(std::move(visitor)),
+          m_next(0),
+          m_mutex(),
+          m_finished(),
+          m_visited(0),
+          m_errors(m_elements.size())
+      {
+
+      }
+
+      /// \brief Visits the next element until none remain
+      ///
+      /// \note This allocates nothing: the exception of each element is kept
+      ///       in storage sized up front, so that a task can't fail and leave
+      ///       \c wait() blocked forever
+      void run() noexcept
+      {
+        auto visited = std::size_t(0);
+
+        while( true ) {
+          const auto index = m_next.fetch_add(1, std::memory_order_relaxed);
+          if( index >= m_elements.size() ) break;
+
+          try {
+            m_visitor(*m_elements[index]);
+          } catch( ... ) {
+            m_errors[index] = std::current_exception();
+          }
+          ++visited;
+        }
+        if( visited == 0 ) return;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_visited += visited;
+        if( m_visited == m_elements.size() ) m_finished.notify_all();
+      }
+
+      /// \brief Waits until every element has been visited
+      ///
+      /// \throw initialization_error if any visit threw
+      void wait()
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_finished.wait(lock, [this](){
+          return m_visited == m_elements.size();
+        });
+
+        m_errors.erase( std::remove(m_errors.begin(), m_errors.end(), nullptr),
+                        m_errors.end() );
+        if( !m_errors.empty() ) throw initialization_error(std::move(m_errors));
+      }
+
+    private:
+
+      std::vector<Element*>           m_elements; ///< The elements to visit
+      Visitor                         m_visitor;  ///< Initializes each element
+      std::atomic<std::size_t>        m_next;     ///< The next element to visit
+      std::mutex                      m_mutex;    ///< Guards the members below
+      std::condition_variable         m_finished; ///< Notified once all are visited
+      std::size_t                     m_visited;  ///< The number of elements visited
+      std::vector<std::exception_ptr> m_errors;   ///< The exception thrown by each visit, if any
+    };
+
+    /// \brief Gets the number of threads of \p executor: its
+    ///        \c thread_count(), if it has one, or else the number of
+    ///        hardware threads
+    template<typename Executor>
+    auto executor_concurrency( const Executor& executor, int )
+      -> decltype(std::size_t(executor.thread_count()))
+    {
+      return executor.thread_count();
+    }
+
+    template<typename Executor>
+    std::size_t executor_concurrency( const Executor&, long )
+    {
+      return std::thread::hardware_concurrency();
+    }
+
+    /// \brief Visits each element of \p elements with \p visitor, in
+    ///        parallel on \p executor and the calling thread
+    template<typename Element, typename Executor, typename Visitor>
+    void visit_all( std::vector<Element*> elements,
+                    Executor& executor,
+                    Visitor visitor )
+    {
+      if( elements.empty() ) return;
+
+      using state_type = bulk_initialization<Element,Visitor>;
+
+      // The calling thread takes one share of the elements
+      const auto threads = std::max<std::size_t>(executor_concurrency(executor, 0), 1);
+      const auto tasks   = std::min(threads, elements.size()) - 1;
+
+      auto state = std::make_shared<state_type>(std::move(elements), std::move(visitor));
+      for( auto i = std::size_t(0); i < tasks; ++i ) {
+        executor.execute([state](){
+          state->run();
+        });
+      }
+      state->run();
+      state->wait();
+    }
+
+  } // namespace detail
+
+  //--------------------------------------------------------------------------
+  // Free Functions
+  //--------------------------------------------------------------------------
+
+  template<typename Range>
+  inline void initialize_all( Range&& range )
+  {
+    initialize_all( std::forward<Range>(range), default_executor() );
+  }
+
+  template<typename Range, typename Executor, typename>
+  inline void initialize_all( Range&& range, Executor& executor )
+  {
+    using std::begin;
+    using std::end;
+    using element_type = typename std::remove_reference<decltype(*begin(range))>::type;
+
+    auto elements = std::vector<element_type*>();
+    for( auto it = begin(range); it != end(range); ++it ) {
+      if( !(*it).is_initialized() ) elements.push_back(std::addressof(*it));
+    }
+
+    detail::visit_all( std::move(elements), executor, detail::initialize_visitor() );
+  }
+
+  template<typename Range, typename Executor, typename Visitor, typename>
+  inline void initialize_all( Range&& range, Executor& executor, Visitor visitor )
+  {
+    using std::begin;
+    using std::end;
+    using element_type = typename std::remove_reference<decltype(*begin(range))>::type;
+
+    auto elements = std::vector<element_type*>();
+    for( auto it = begin(range); it != end(range); ++it ) {
+      elements.push_back(std::addressof(*it));
+    }
+
+    detail::visit_all( std::move(elements), executor, std::move(visitor) );
+  }
+
+} // namespace lazy
@@ -0,0 +1,151 @@
+/**
+ * \file lazy_config.hpp
+ *
+ * \brief This file contains the configurable preprocessor definitions used
+ *        throughout the \c Lazy library.
+ *
+ * Each of these may be defined prior to including \c Lazy.hpp in order to
+ * override the default behavior.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_LAZY_CONFIG_HPP_
+#define LAZY_DETAIL_LAZY_CONFIG_HPP_
+
+/// \def LAZY_DEFAULT_INLINE_BYTES
+///
+/// \brief The number of bytes a \c Lazy reserves for storing its construction
+///        function (and any arguments captured by it) without allocating
+///
+/// Construction functions that don't fit in this many bytes are allocated on
+/// the heap, unless \c LAZY_NO_HEAP_FALLBACK is defined.
+#ifndef LAZY_DEFAULT_INLINE_BYTES
+# define LAZY_DEFAULT_INLINE_BYTES (4 * sizeof(void*))
+#endif
+
+/// \def LAZY_NO_HEAP_FALLBACK
+///
+/// \brief When defined, construction functions that don't fit in the inline
+///        buffer of a \c Lazy fail to compile rather than being allocated on
+///        the heap
+#ifdef LAZY_NO_HEAP_FALLBACK
+# define LAZY_HEAP_FALLBACK_ENABLED 0
+#else
+# define LAZY_HEAP_FALLBACK_ENABLED 1
+#endif
+
+/// \def LAZY_SPIN_COUNT
+///
+/// \brief The number of times a thread waiting for another thread to
+///        initialize a \c ConcurrentLazy checks on it before parking
+///
+/// Spinning avoids the cost of parking when construction is quick, while
+/// parking keeps many waiting threads from burning cores when it is not.
+#ifndef LAZY_SPIN_COUNT
+# define LAZY_SPIN_COUNT 100
+#endif
+
+/// \def LAZY_CACHE_LINE_SIZE
+///
+/// \brief The size of a cache line, in bytes
+///
+/// Objects that are written from different threads (such as the shards of a
+/// \c ShardedLazy) are aligned to this, so that no two share a cache line.
+#ifndef LAZY_CACHE_LINE_SIZE
+# define LAZY_CACHE_LINE_SIZE 64
+#endif
+
+/// \def LAZY_LIKELY(x)
+///
+/// \brief Hints to the compiler that the condition \p x is usually \c true
+///
+/// \def LAZY_UNLIKELY(x)
+///
+/// \brief Hints to the compiler that the condition \p x is usually \c false
+#if defined(__GNUC__) || defined(__clang__)
+# define LAZY_LIKELY(x)   __builtin_expect(!!(x),1)
+# define LAZY_UNLIKELY(x) __builtin_expect(!!(x),0)
+#else
+# define LAZY_LIKELY(x)   (x)
+# define LAZY_UNLIKELY(x) (x)
+#endif
+
+/// \def LAZY_NOINLINE
+///
+/// \brief Prevents a function from being inlined into its callers
+///
+/// \def LAZY_COLD
+///
+/// \brief Marks a function as rarely called, so that it is optimized for
+///        size and placed away from frequently executed code
+#if defined(__GNUC__) || defined(__clang__)
+# define LAZY_NOINLINE __attribute__((noinline))
+# define LAZY_COLD     __attribute__((cold))
+#elif defined(_MSC_VER)
+# define LAZY_NOINLINE __declspec(noinline)
+# define LAZY_COLD
+#else
+# define LAZY_NOINLINE
+# define LAZY_COLD
+#endif
+
+/// \def LAZY_CONSTINIT
+///
+/// \brief Requires a variable at namespace scope to be constant-initialized
+///
+/// This expands to \c constinit when it is available, or to an equivalent
+/// attribute where one exists, and otherwise to nothing. A \c Lazy marked
+/// with this is guaranteed not to add a dynamic initializer:
+///
+/// \code
+/// LAZY_CONSTINIT lazy::Lazy<Config> g_config;
+/// \endcode
+#ifndef LAZY_CONSTINIT
+# if defined(__cpp_constinit)
+#  define LAZY_CONSTINIT constinit
+# elif defined(__has_cpp_attribute)
+#  if __has_cpp_attribute(clang::require_constant_initialization)
+#   define LAZY_CONSTINIT [[clang::require_constant_initialization]]
+#  endif
+# endif
+#endif
+#ifndef LAZY_CONSTINIT
+# define LAZY_CONSTINIT
+#endif
+
+/// \def LAZY_NO_UNIQUE_ADDRESS
+///
+/// \brief Allows an empty data member to share the address of another
+///        member, so that it takes no space
+///
+/// This expands to \c [[no_unique_address]] under C++20, and otherwise to
+/// nothing.
+#ifndef LAZY_NO_UNIQUE_ADDRESS
+# if __cplusplus > 201703L && defined(__has_cpp_attribute)
+#  if __has_cpp_attribute(no_unique_address)
+#   define LAZY_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#  endif
+# endif
+#endif
+#ifndef LAZY_NO_UNIQUE_ADDRESS
+# define LAZY_NO_UNIQUE_ADDRESS
+#endif
+
+/// \def LAZY_HAS_COROUTINES
+///
+/// \brief Defined to \c 1 if C++20 coroutines are available, so that
+///        \c co_await may be used on an \c AsyncLazy, and to \c 0 otherwise
+#ifndef LAZY_HAS_COROUTINES
+# if defined(__cpp_impl_coroutine) && defined(__has_include)
+#  if __has_include(<coroutine>)
+#   define LAZY_HAS_COROUTINES 1
+#  endif
+# endif
+#endif
+#ifndef LAZY_HAS_COROUTINES
+# define LAZY_HAS_COROUTINES 0
+#endif
+
+#endif /* LAZY_DETAIL_LAZY_CONFIG_HPP_ */
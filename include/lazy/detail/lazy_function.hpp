@@ -0,0 +1,996 @@
+/**
+ * \file lazy_function.hpp
+ *
+ * \brief This file contains the type-erased construction and destruction
+ *        functions used by \c Lazy, along with helpers for invoking the
+ *        construction functions of a \c BasicLazy.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_LAZY_FUNCTION_HPP_
+#define LAZY_DETAIL_LAZY_FUNCTION_HPP_
+
+#include "lazy_config.hpp"
+#include "lazy_traits.hpp"
+#include "compressed_pair.hpp"
+#include "function_buffer.hpp"
+
+#include <type_traits>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <utility>
+#include <tuple>
+#include <new>
+
+namespace lazy{
+
+  template<typename T> struct default_destructor;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief Exception thrown when copying a \c Lazy whose construction
+  ///        function can't be copied
+  ///
+  /// This happens when copying a \c Lazy that was created by \c make_lazy
+  /// with move-only arguments, before it has been initialized
+  ////////////////////////////////////////////////////////////////////////////
+  class bad_lazy_copy : public std::logic_error
+  {
+  public:
+
+    bad_lazy_copy()
+      : std::logic_error("lazy: construction function is not copyable")
+    {
+
+    }
+  };
+
+  namespace detail{
+
+    /// \brief Constructor tag for tag-dispatching VA Arguments
+    struct ctor_va_args_tag{};
+
+    //------------------------------------------------------------------------
+
+    /// \brief Constructs a \c T at the address \p where by passing all
+    ///        values stored in a \c std::tuple to \c T's constructor
+    ///
+    /// \param where  the address to construct the \c T at
+    /// \param args   the tuple of arguments
+    /// \param unused unused parameter for getting index list
+    template<typename T, typename Tuple, std::size_t...Is>
+    inline void tuple_construct( void* where, Tuple&& args,
+                                 const index_sequence<Is...>& )
+    {
+      new (where) T( std::get<Is>(std::forward<Tuple>(args))... );
+    }
+
+    /// \brief Constructs a \c T at the address \p where by invoking the
+    ///        tuple-returning function \p constructor
+    ///
+    /// \param where       the address to construct the \c T at
+    /// \param constructor the function returning the constructor arguments
+    template<typename T, typename CtorFunc>
+    inline void construct_from_function( void* where, CtorFunc& constructor )
+    {
+      using return_type = remove_cvref_t<decltype(constructor())>;
+
+      static_assert(is_tuple<return_type>::value,"Lazy-construction functions must return tuples containing constructor arguments");
+      static_assert(is_tuple_constructible<T,return_type>::value, "No matching constructor for type T with given arguments");
+
+      tuple_construct<T>( where, constructor(),
+                          make_index_sequence<std::tuple_size<return_type>::value>() );
+    }
+
+    //------------------------------------------------------------------------
+
+    /// \brief A construction function that default-constructs a \c T
+    template<typename T>
+    struct default_construct_function
+    {
+      void operator()( void* where ) const
+      {
+        new (where) T();
+      }
+    };
+
+    /// \brief A construction function that constructs a \c T with the
+    ///        arguments returned from a tuple-returning function
+    template<typename T, typename CtorFunc>
+    struct tuple_construct_function
+    {
+      CtorFunc constructor;
+
+      void operator()( void* where )
+      {
+        construct_from_function<T>( where, constructor );
+      }
+    };
+
+    /// \brief A construction function that constructs a \c T from a stored
+    ///        copy of a \c T
+    ///
+    /// The stored copy is only moved from by \c consume, and only if \c T's
+    /// move constructor does not throw, since the function is released after
+    /// that construction. A move-only \c T is always moved from.
+    template<typename T>
+    struct value_construct_function
+    {
+      typename std::remove_cv<T>::type value;
+
+      void operator()( void* where )
+      {
+        construct( where, std::is_copy_constructible<T>() );
+      }
+
+      void consume( void* where )
+      {
+        new (where) T( std::move_if_noexcept(value) );
+      }
+
+    private:
+
+      void construct( void* where, std::true_type )
+      {
+        new (where) T( static_cast<const T&>(value) );
+      }
+
+      void construct( void* where, std::false_type )
+      {
+        new (where) T( std::move(value) );
+      }
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief A copy of an array argument
+    ///
+    /// Unlike a raw array, this can be stored in a \c std::tuple
+    template<typename T, std::size_t N>
+    struct array_argument
+    {
+      T value[N];
+
+      array_argument( const T (&array)[N] )
+      {
+        std::copy( array, array + N, value );
+      }
+    };
+
+    /// \brief The type used to store an argument of type \c Arg until
+    ///        construction
+    template<typename Arg, typename U = typename std::remove_reference<Arg>::type>
+    struct stored_argument
+    {
+      using type = typename std::decay<Arg>::type;
+    };
+
+    template<typename Arg, typename T, std::size_t N>
+    struct stored_argument<Arg,T[N]>
+    {
+      using type = array_argument<typename std::remove_cv<T>::type,N>;
+    };
+
+    /// \brief Passes a stored argument on to the constructor, copying it
+    ///
+    /// \param argument the stored argument
+    template<typename Arg>
+    inline const Arg& unwrap_argument( const Arg& argument )
+    {
+      return argument;
+    }
+
+    /// \brief Passes a stored array argument on to the constructor
+    ///
+    /// \param argument the stored array argument
+    template<typename T, std::size_t N>
+    inline const T (&unwrap_argument( const array_argument<T,N>& argument ))[N]
+    {
+      return argument.value;
+    }
+
+    /// \brief Passes a stored argument on to the constructor, moving it
+    ///
+    /// \param argument the stored argument
+    template<typename Arg>
+    inline Arg&& move_argument( Arg& argument )
+    {
+      return std::move(argument);
+    }
+
+    /// \brief Passes a stored array argument on to the constructor
+    ///
+    /// \param argument the stored array argument
+    template<typename T, std::size_t N>
+    inline const T (&move_argument( array_argument<T,N>& argument ))[N]
+    {
+      return argument.value;
+    }
+
+    /// \brief The type a stored argument of type \c Arg is passed on to the
+    ///        constructor as when it is copied
+    template<typename Arg>
+    using copied_argument_t = decltype(unwrap_argument(std::declval<const Arg&>()));
+
+    /// \brief The type a stored argument of type \c Arg is passed on to the
+    ///        constructor as when it is moved
+    template<typename Arg>
+    using moved_argument_t = decltype(move_argument(std::declval<Arg&>()));
+
+    /// \brief A construction function that constructs a \c T from stored
+    ///        arguments
+    ///
+    /// The arguments are moved into \c T's constructor by \c consume, since
+    /// the function is released after that construction, so each argument
+    /// is only ever copied or moved once into storage, and once into the
+    /// \c T. Otherwise they are copied, unless they can only be moved.
+    ///
+    /// \note If \c T's constructor throws, the arguments it has moved from
+    ///       stay moved-from for the next attempt
+    template<typename T, typename...Args>
+    struct arguments_construct_function
+    {
+      /// Whether T can be constructed from copies of the arguments
+      using is_copyable = std::is_constructible<T,copied_argument_t<Args>...>;
+
+      std::tuple<Args...> arguments;
+
+      template<typename...UArgs>
+      explicit arguments_construct_function( ctor_va_args_tag, UArgs&&...args )
+        : arguments(std::forward<UArgs>(args)...)
+      {
+
+      }
+
+      void operator()( void* where )
+      {
+        construct( where, is_copyable() );
+      }
+
+      void consume( void* where )
+      {
+        move_construct( where, make_index_sequence<sizeof...(Args)>() );
+      }
+
+    private:
+
+      void construct( void* where, std::true_type )
+      {
+        copy_construct( where, make_index_sequence<sizeof...(Args)>() );
+      }
+
+      void construct( void* where, std::false_type )
+      {
+        move_construct( where, make_index_sequence<sizeof...(Args)>() );
+      }
+
+      template<std::size_t...Is>
+      void copy_construct( void* where, const index_sequence<Is...>& )
+      {
+        const auto& args = arguments;
+
+        new (where) T( unwrap_argument(std::get<Is>(args))... );
+      }
+
+      template<std::size_t...Is>
+      void move_construct( void* where, const index_sequence<Is...>& )
+      {
+        new (where) T( move_argument(std::get<Is>(arguments))... );
+      }
+    };
+
+    /// \brief The construction function left behind once an
+    ///        \c erased_function has been released
+    struct released_construct_function
+    {
+      void operator()( void* ) const
+      {
+        throw std::bad_function_call();
+      }
+    };
+
+    /// \brief Constructs a \c T at the address \p where with the
+    ///        construction function \p function, which is released
+    ///        afterwards, and so may give up its state to the \c T
+    ///
+    /// \param function the construction function
+    /// \param where    the address to construct the \c T at
+    template<typename CtorFunc>
+    inline auto consume_construct( CtorFunc& function, void* where, int )
+      -> decltype(function.consume(where))
+    {
+      function.consume(where);
+    }
+
+    template<typename CtorFunc>
+    inline void consume_construct( CtorFunc& function, void* where, long )
+    {
+      function(where);
+    }
+
+    //------------------------------------------------------------------------
+
+    /// \brief The table of operations for the state stored in an
+    ///        \c erased_function<T,InlineBytes>
+    template<typename T, std::size_t InlineBytes>
+    struct erased_vtable
+    {
+      using buffer_type = function_buffer<InlineBytes>;
+
+      void (*construct)( buffer_type&, void* );
+      const erased_vtable* (*consume)( buffer_type&, void* );
+      void (*destruct)( buffer_type&, T& );
+      const erased_vtable* (*release)( buffer_type& );
+      void (*copy)( const buffer_type&, buffer_type& );
+      void (*move)( buffer_type&, buffer_type& );
+      void (*destroy)( buffer_type& );
+      bool is_allocated;
+      std::size_t size;
+    };
+
+    /// \brief The operations for an \c erased_function storing the
+    ///        construction function \c CtorFunc and destruction function
+    ///        \c DtorFunc together as a single \c compressed_pair
+    ///
+    /// \tparam T           the type being constructed
+    /// \tparam InlineBytes the size of the buffer
+    /// \tparam CtorFunc    the type of the construction function
+    /// \tparam DtorFunc    the type of the destruction function
+    template<typename T, std::size_t InlineBytes, typename CtorFunc, typename DtorFunc>
+    struct erased_operations
+    {
+      using state_type    = compressed_pair<CtorFunc,DtorFunc>;
+      using storage_type  = function_storage<state_type,InlineBytes>;
+      using buffer_type   = function_buffer<InlineBytes>;
+      using vtable_type   = erased_vtable<T,InlineBytes>;
+      using released_type = erased_operations<T,InlineBytes,released_construct_function,DtorFunc>;
+
+      /// \brief Whether the construction function may be released without
+      ///        allocating
+      using is_releasable = boolean_constant<
+        !std::is_same<CtorFunc,released_construct_function>::value &&
+        is_inline_storable<typename released_type::state_type,InlineBytes>::value
+      >;
+
+      static const vtable_type value;
+
+      static void construct( buffer_type& buffer, void* where )
+      {
+        storage_type::get(buffer).first()( where );
+      }
+
+      static const vtable_type* consume( buffer_type& buffer, void* where )
+      {
+        return consume( buffer, where, is_releasable() );
+      }
+
+      static const vtable_type* consume( buffer_type& buffer, void* where, std::true_type )
+      {
+        consume_construct( storage_type::get(buffer).first(), where, 0 );
+        return release( buffer, std::true_type() );
+      }
+
+      // The function is kept, so its state must be kept intact as well
+      static const vtable_type* consume( buffer_type& buffer, void* where, std::false_type )
+      {
+        construct( buffer, where );
+        return &value;
+      }
+
+      static void destruct( buffer_type& buffer, T& x )
+      {
+        storage_type::get(buffer).second()( x );
+      }
+
+      static const vtable_type* release( buffer_type& buffer )
+      {
+        return release( buffer, is_releasable() );
+      }
+
+      static const vtable_type* release( buffer_type& buffer, std::true_type )
+      {
+        DtorFunc destructor( std::move(storage_type::get(buffer).second()) );
+
+        storage_type::destroy( buffer );
+        released_type::storage_type::create( buffer, released_construct_function(), std::move(destructor) );
+        return &released_type::value;
+      }
+
+      static const vtable_type* release( buffer_type&, std::false_type )
+      {
+        return &value;
+      }
+
+      static void copy( const buffer_type& source, buffer_type& destination )
+      {
+        copy( source, destination, std::is_copy_constructible<state_type>() );
+      }
+
+      static void copy( const buffer_type& source, buffer_type& destination, std::true_type )
+      {
+        storage_type::copy( source, destination );
+      }
+
+      static void copy( const buffer_type&, buffer_type&, std::false_type )
+      {
+        throw bad_lazy_copy();
+      }
+    };
+
+    template<typename T, std::size_t InlineBytes, typename CtorFunc, typename DtorFunc>
+    const erased_vtable<T,InlineBytes> erased_operations<T,InlineBytes,CtorFunc,DtorFunc>::value = {
+      static_cast<void(*)(buffer_type&,void*)>(&erased_operations::construct),
+      static_cast<const vtable_type*(*)(buffer_type&,void*)>(&erased_operations::consume),
+      &erased_operations::destruct,
+      static_cast<const vtable_type*(*)(buffer_type&)>(&erased_operations::release),
+      static_cast<void(*)(const buffer_type&,buffer_type&)>(&erased_operations::copy),
+      &storage_type::move,
+      &storage_type::destroy,
+      !is_inline_storable<state_type,InlineBytes>::value,
+      std::is_empty<state_type>::value ? 0 : sizeof(state_type)
+    };
+
+    /// \brief The operations for an \c erased_function that default-constructs
+    ///        the \c T, and does nothing prior to destruction
+    ///
+    /// Nothing is stored in the buffer for these operations, which allows a
+    /// default-constructed \c erased_function to be constant-initialized.
+    ///
+    /// \tparam T           the type being constructed
+    /// \tparam InlineBytes the size of the buffer
+    template<typename T, std::size_t InlineBytes>
+    struct default_operations
+    {
+      using buffer_type = function_buffer<InlineBytes>;
+      using vtable_type = erased_vtable<T,InlineBytes>;
+
+      static const vtable_type value;
+
+      static void construct( buffer_type&, void* where )
+      {
+        new (where) T();
+      }
+
+      static const vtable_type* consume( buffer_type& buffer, void* where )
+      {
+        construct( buffer, where );
+        return &value;
+      }
+
+      static void destruct( buffer_type&, T& ){}
+
+      // There is no state to release, so the operations are kept as-is
+      static const vtable_type* release( buffer_type& ){ return &value; }
+
+      static void copy( const buffer_type&, buffer_type& ){}
+      static void move( buffer_type&, buffer_type& ){}
+      static void destroy( buffer_type& ){}
+    };
+
+    template<typename T, std::size_t InlineBytes>
+    const erased_vtable<T,InlineBytes> default_operations<T,InlineBytes>::value = {
+      &default_operations::construct,
+      &default_operations::consume,
+      &default_operations::destruct,
+      &default_operations::release,
+      &default_operations::copy,
+      &default_operations::move,
+      &default_operations::destroy,
+      false,
+      0
+    };
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief A type-erased construction and destruction function for a \c T
+    ///
+    /// Unlike user-supplied construction functions, which return a
+    /// \c std::tuple of arguments, an \c erased_function constructs the
+    /// \c T directly into the storage that it is supplied with. This allows
+    /// construction from values and argument packs to be stored behind the
+    /// same type.
+    ///
+    /// The construction and destruction functions share a single table of
+    /// operations and a single buffer, so that a \c Lazy pays for one
+    /// pointer of bookkeeping rather than one per function. The functions,
+    /// along with any arguments they have captured, are stored in an inline
+    /// buffer of \c InlineBytes bytes. Functions that do not fit are
+    /// allocated on the heap, unless \c LAZY_NO_HEAP_FALLBACK is defined.
+    ///
+    /// \tparam T           the type being constructed
+    /// \tparam InlineBytes the number of bytes to store functions in without
+    ///                     allocating
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename T, std::size_t InlineBytes = LAZY_DEFAULT_INLINE_BYTES>
+    class erased_function
+    {
+    public:
+
+      /// \brief Constructs an \c erased_function that will default-construct
+      ///        the \c T
+      ///
+      /// \note This is \c constexpr, allowing a default-constructed \c Lazy
+      ///       to be constant-initialized
+      constexpr erased_function() noexcept;
+
+      /// \brief Constructs an \c erased_function from a function returning
+      ///        a \c std::tuple of arguments to \c T's constructor
+      ///
+      /// \param constructor the construction function
+      template<
+        typename CtorFunc,
+        typename = typename std::enable_if<is_callable<CtorFunc>::value &&
+                                           !std::is_same<CtorFunc,erased_function>::value>::type
+      >
+      erased_function( const CtorFunc& constructor );
+
+      /// \brief Constructs an \c erased_function from a function returning
+      ///        a \c std::tuple of arguments to \c T's constructor, and a
+      ///        function to invoke prior to destruction
+      ///
+      /// \param constructor the construction function
+      /// \param destructor  the destruction function
+      template<
+        typename CtorFunc,
+        typename DtorFunc,
+        typename = typename std::enable_if<is_callable<CtorFunc>::value &&
+                                           is_callable<DtorFunc>::value>::type
+      >
+      erased_function( const CtorFunc& constructor, const DtorFunc& destructor );
+
+      /// \brief Constructs an \c erased_function that copy-constructs
+      ///        the \c T from \p value
+      ///
+      /// \param value the value to copy
+      explicit erased_function( const T& value );
+
+      /// \brief Constructs an \c erased_function that move-constructs
+      ///        the \c T from \p value
+      ///
+      /// \param value the value to move
+      explicit erased_function( T&& value );
+
+      /// \brief Constructs an \c erased_function that constructs the \c T
+      ///        from \p args
+      ///
+      /// The arguments are copied or moved into this \c erased_function, and
+      /// moved into \c T's constructor by \c consume
+      ///
+      /// \param tag  unused tag for dispatching to VA constructor
+      /// \param args arguments to \c T's constructor
+      template<typename...Args>
+      erased_function( ctor_va_args_tag tag, Args&&...args );
+
+      /// \brief Copy-constructs an \c erased_function
+      ///
+      /// \throw bad_lazy_copy if the stored functions can't be copied
+      ///
+      /// \param rhs the \c erased_function to copy
+      erased_function( const erased_function& rhs );
+
+      /// \brief Move-constructs an \c erased_function
+      ///
+      /// \note \p rhs is left empty
+      ///
+      /// \param rhs the \c erased_function to move
+      erased_function( erased_function&& rhs ) noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Destroys the stored functions
+      ~erased_function();
+
+      //----------------------------------------------------------------------
+
+      /// \brief Copy-assigns an \c erased_function
+      ///
+      /// \param rhs the \c erased_function to copy
+      /// \return reference to (*this)
+      erased_function& operator=( const erased_function& rhs );
+
+      /// \brief Move-assigns an \c erased_function
+      ///
+      /// \note \p rhs is left empty
+      ///
+      /// \param rhs the \c erased_function to move
+      /// \return reference to (*this)
+      erased_function& operator=( erased_function&& rhs ) noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Constructs the \c T at the address \p where
+      ///
+      /// The stored arguments are copied into the \c T, unless they can only
+      /// be moved, so construction may be repeated.
+      ///
+      /// \throw std::bad_function_call if this \c erased_function is empty,
+      ///        or has been released
+      ///
+      /// \param where the address to construct the \c T at
+      void construct( void* where );
+
+      /// \brief Constructs the \c T at the address \p where, and then
+      ///        releases the construction function as if by \c release
+      ///
+      /// The stored arguments are moved into the \c T, since they are not
+      /// needed again.
+      ///
+      /// \throw std::bad_function_call if this \c erased_function is empty,
+      ///        or has been released
+      ///
+      /// \param where the address to construct the \c T at
+      void consume( void* where );
+
+      /// \brief Invokes the destruction function on \p x
+      ///
+      /// \param x the \c T to be destructed
+      void operator()( T& x );
+
+      /// \brief Destroys the stored construction function, along with any
+      ///        arguments it has captured, keeping only the destruction
+      ///        function
+      ///
+      /// \note The construction function is kept if the destruction
+      ///       function could not be kept inline without allocating
+      void release() noexcept;
+
+      /// \brief Checks whether the stored functions were allocated on the
+      ///        heap
+      ///
+      /// \return \c true if the functions are not stored inline
+      bool is_allocated() const noexcept;
+
+      /// \brief Gets the number of bytes of state retained by the stored
+      ///        functions
+      ///
+      /// \return the size of the stored functions, or \c 0 if stateless
+      std::size_t retained_bytes() const noexcept;
+
+    private:
+
+      using buffer_type = function_buffer<InlineBytes>;
+      using vtable_type = erased_vtable<T,InlineBytes>;
+
+      const vtable_type* m_vtable; ///< The operations for the stored functions
+      buffer_type        m_buffer; ///< The storage of the stored functions
+
+      /// \brief Stores the functions \c CtorFunc and \c DtorFunc constructed
+      ///        from \p constructor and \p destructor
+      ///
+      /// \param constructor the construction function
+      /// \param destructor  the destruction function
+      template<typename CtorFunc, typename DtorFunc, typename Ctor, typename Dtor>
+      void store( Ctor&& constructor, Dtor&& destructor );
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief Type trait to determine whether the construction function
+    ///        \c CtorFunc constructs into supplied storage, rather than
+    ///        returning a \c std::tuple of arguments
+    ///
+    /// The result is aliased as \c ::value
+    template<typename CtorFunc>
+    struct is_storage_constructor : std::false_type{};
+
+    template<typename T, std::size_t InlineBytes>
+    struct is_storage_constructor<erased_function<T,InlineBytes>> : std::true_type{};
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The construction and destruction functions of a \c BasicLazy
+    ///
+    /// This stores both functions in a \c compressed_pair so that stateless
+    /// functions take up no space. If both functions are the same
+    /// \c erased_function, only a single one is stored and serves as both.
+    ///
+    /// \tparam CtorFunc the type of the construction function
+    /// \tparam DtorFunc the type of the destruction function
+    ////////////////////////////////////////////////////////////////////////////
+    template<
+      typename CtorFunc,
+      typename DtorFunc,
+      bool = std::is_same<CtorFunc,DtorFunc>::value && is_storage_constructor<CtorFunc>::value
+    >
+    class function_pair
+    {
+    public:
+
+      constexpr function_pair() : m_pair(){}
+
+      template<
+        typename Ctor,
+        typename = typename std::enable_if<!std::is_same<remove_cvref_t<Ctor>,function_pair>::value>::type
+      >
+      constexpr explicit function_pair( Ctor&& constructor )
+        : m_pair(static_cast<Ctor&&>(constructor),DtorFunc())
+      {
+
+      }
+
+      template<typename Ctor, typename Dtor>
+      constexpr function_pair( Ctor&& constructor, Dtor&& destructor )
+        : m_pair(static_cast<Ctor&&>(constructor),static_cast<Dtor&&>(destructor))
+      {
+
+      }
+
+      CtorFunc& first() noexcept{ return m_pair.first(); }
+      const CtorFunc& first() const noexcept{ return m_pair.first(); }
+
+      DtorFunc& second() noexcept{ return m_pair.second(); }
+      const DtorFunc& second() const noexcept{ return m_pair.second(); }
+
+      void swap( function_pair& rhs ) noexcept
+      {
+        using std::swap; // for ADL
+
+        swap(first(),rhs.first());
+        swap(second(),rhs.second());
+      }
+
+    private:
+
+      LAZY_NO_UNIQUE_ADDRESS compressed_pair<CtorFunc,DtorFunc> m_pair;
+    };
+
+    template<typename Function>
+    class function_pair<Function,Function,true>
+    {
+    public:
+
+      constexpr function_pair() : m_function(){}
+
+      template<
+        typename Ctor,
+        typename = typename std::enable_if<!std::is_same<remove_cvref_t<Ctor>,function_pair>::value>::type
+      >
+      constexpr explicit function_pair( Ctor&& constructor )
+        : m_function(static_cast<Ctor&&>(constructor))
+      {
+
+      }
+
+      template<typename Ctor, typename Dtor>
+      constexpr function_pair( Ctor&& constructor, Dtor&& destructor )
+        : m_function(static_cast<Ctor&&>(constructor),static_cast<Dtor&&>(destructor))
+      {
+
+      }
+
+      Function& first() noexcept{ return m_function; }
+      const Function& first() const noexcept{ return m_function; }
+
+      Function& second() noexcept{ return m_function; }
+      const Function& second() const noexcept{ return m_function; }
+
+      void swap( function_pair& rhs ) noexcept
+      {
+        using std::swap; // for ADL
+
+        swap(m_function,rhs.m_function);
+      }
+
+    private:
+
+      LAZY_NO_UNIQUE_ADDRESS Function m_function;
+    };
+
+    //------------------------------------------------------------------------
+    // erased_function
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    inline constexpr erased_function<T,InlineBytes>::erased_function()
+      noexcept
+      : m_vtable(&default_operations<T,InlineBytes>::value),
+        m_buffer()
+    {
+      static_assert(std::is_default_constructible<T>::value,"No matching default constructor for type T");
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    template<typename CtorFunc, typename>
+    inline erased_function<T,InlineBytes>::erased_function( const CtorFunc& constructor )
+      : erased_function(constructor,default_destructor<T>())
+    {
+
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    template<typename CtorFunc, typename DtorFunc, typename>
+    inline erased_function<T,InlineBytes>::erased_function( const CtorFunc& constructor,
+                                                            const DtorFunc& destructor )
+      : m_vtable(nullptr)
+    {
+      using return_type = typename function_traits<CtorFunc>::result_type;
+
+      static_assert(is_tuple<return_type>::value,"Lazy-construction functions must return tuples containing constructor arguments");
+      static_assert(is_tuple_constructible<T,return_type>::value, "No matching constructor for type T with given arguments");
+
+      using function_type = tuple_construct_function<T,typename std::decay<CtorFunc>::type>;
+
+      store<function_type,typename std::decay<DtorFunc>::type>( function_type{constructor}, destructor );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::erased_function( const T& value )
+      : m_vtable(nullptr)
+    {
+      static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
+
+      store<value_construct_function<T>,default_destructor<T>>( value_construct_function<T>{value},
+                                                                default_destructor<T>() );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::erased_function( T&& value )
+      : m_vtable(nullptr)
+    {
+      static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
+
+      store<value_construct_function<T>,default_destructor<T>>( value_construct_function<T>{std::move(value)},
+                                                                default_destructor<T>() );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    template<typename...Args>
+    inline erased_function<T,InlineBytes>::erased_function( ctor_va_args_tag,
+                                                            Args&&...args )
+      : m_vtable(nullptr)
+    {
+      static_assert(std::is_constructible<T,moved_argument_t<typename stored_argument<Args>::type>...>::value,
+                    "No matching constructor for type T with given arguments");
+
+      using function_type = arguments_construct_function<T,typename stored_argument<Args>::type...>;
+
+      store<function_type,default_destructor<T>>( function_type(ctor_va_args_tag(),std::forward<Args>(args)...),
+                                                  default_destructor<T>() );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::erased_function( const erased_function& rhs )
+      : m_vtable(nullptr)
+    {
+      if( rhs.m_vtable )
+      {
+        rhs.m_vtable->copy( rhs.m_buffer, m_buffer );
+        m_vtable = rhs.m_vtable;
+      }
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::erased_function( erased_function&& rhs )
+      noexcept
+      : m_vtable(rhs.m_vtable)
+    {
+      if( m_vtable )
+      {
+        m_vtable->move( rhs.m_buffer, m_buffer );
+        rhs.m_vtable = nullptr;
+      }
+    }
+
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::~erased_function()
+    {
+      if( m_vtable )
+      {
+        m_vtable->destroy( m_buffer );
+      }
+    }
+
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>&
+      erased_function<T,InlineBytes>::operator=( const erased_function& rhs )
+    {
+      if( this != &rhs )
+      {
+        (*this) = erased_function(rhs);
+      }
+      return (*this);
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>&
+      erased_function<T,InlineBytes>::operator=( erased_function&& rhs )
+      noexcept
+    {
+      if( this != &rhs )
+      {
+        if( m_vtable )
+        {
+          m_vtable->destroy( m_buffer );
+        }
+        m_vtable = rhs.m_vtable;
+        if( m_vtable )
+        {
+          m_vtable->move( rhs.m_buffer, m_buffer );
+          rhs.m_vtable = nullptr;
+        }
+      }
+      return (*this);
+    }
+
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    inline void erased_function<T,InlineBytes>::construct( void* where )
+    {
+      if( !m_vtable )
+      {
+        throw std::bad_function_call();
+      }
+      m_vtable->construct( m_buffer, where );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline void erased_function<T,InlineBytes>::consume( void* where )
+    {
+      if( !m_vtable )
+      {
+        throw std::bad_function_call();
+      }
+      m_vtable = m_vtable->consume( m_buffer, where );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline void erased_function<T,InlineBytes>::operator()( T& x )
+    {
+      if( m_vtable )
+      {
+        m_vtable->destruct( m_buffer, x );
+      }
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline void erased_function<T,InlineBytes>::release()
+      noexcept
+    {
+      if( m_vtable )
+      {
+        m_vtable = m_vtable->release( m_buffer );
+      }
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline bool erased_function<T,InlineBytes>::is_allocated()
+      const noexcept
+    {
+      return m_vtable && m_vtable->is_allocated;
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline std::size_t erased_function<T,InlineBytes>::retained_bytes()
+      const noexcept
+    {
+      return m_vtable ? m_vtable->size : 0;
+    }
+
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    template<typename CtorFunc, typename DtorFunc, typename Ctor, typename Dtor>
+    inline void erased_function<T,InlineBytes>::store( Ctor&& constructor,
+                                                       Dtor&& destructor )
+    {
+      using operations_type = erased_operations<T,InlineBytes,CtorFunc,DtorFunc>;
+
+      operations_type::storage_type::create( m_buffer,
+                                             std::forward<Ctor>(constructor),
+                                             std::forward<Dtor>(destructor) );
+      m_vtable = &operations_type::value;
+    }
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_LAZY_FUNCTION_HPP_ */
@@ -0,0 +1,872 @@
+/**
+ * \file lazy_policy.hpp
+ *
+ * \brief This file contains the threading policies that control how a
+ *        \c BasicLazy is initialized.
+ *
+ * A threading policy is a type with a nested \c state_type, which a
+ * \c BasicLazy stores in place of its initialized flag. The \c state_type
+ * must be \c constexpr default-constructible, and provide:
+ *
+ * - \c is_initialized(), which checks whether the \c T has been constructed,
+ * - \c initialize(init), which constructs the \c T if it has not been
+ *   constructed, using the operations of the \c BasicLazy::initializer
+ *   \c init, and
+ * - \c set_initialized(bool), which records a change made while there is no
+ *   concurrent access to the \c BasicLazy (such as on assignment).
+ *
+ * Policies that encode the initialized state in the value itself (such as
+ * \c sentinel) instead have a nested template \c value_state<T>, which holds
+ * the \c T in place of the storage, provides the same operations, and also
+ * provides \c ptr() to get the \c T.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_LAZY_POLICY_HPP_
+#define LAZY_DETAIL_LAZY_POLICY_HPP_
+
+#include "lazy_config.hpp"
+#include "atomic_wait.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace lazy{
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that is only ever
+  ///        accessed from one thread at a time
+  ///
+  /// The initialized state is a plain \c bool, so accessing the \c BasicLazy
+  /// costs nothing beyond a check of the flag. Accessing the same
+  /// uninitialized \c BasicLazy from multiple threads is a data race.
+  ////////////////////////////////////////////////////////////////////////////
+  struct single_threaded
+  {
+    class state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : m_is_initialized(false){}
+
+      /// \brief Checks whether the \c T has been constructed
+      ///
+      /// \return \c true if the \c T has been constructed
+      bool is_initialized() const noexcept
+      {
+        return m_is_initialized;
+      }
+
+      /// \brief Constructs the \c T with \p init, unless it has already
+      ///        been constructed
+      ///
+      /// \param init the operations for constructing the \c T
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        if( !m_is_initialized )
+        {
+          init.construct();
+          m_is_initialized = true;
+        }
+      }
+
+      /// \brief Sets whether the \c T has been constructed
+      ///
+      /// \note This is only used outside of \c initialize, while there is no
+      ///       concurrent access to the \c BasicLazy
+      ///
+      /// \param is_initialized whether the \c T has been constructed
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        m_is_initialized = is_initialized;
+      }
+
+    private:
+
+      bool m_is_initialized;
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that may be accessed
+  ///        from many threads at once
+  ///
+  /// The initialized state is an atomic state word. Accessing an initialized
+  /// \c BasicLazy costs a single acquire load; if it is not initialized,
+  /// exactly one thread constructs the \c T while any others wait for it to
+  /// finish.
+  ///
+  /// Waiting threads check the state word \p SpinCount times, and then park
+  /// until the constructing thread wakes them (with \c std::atomic::wait, or
+  /// a futex on Linux). The constructing thread only pays for the wake-up if
+  /// some thread actually parked.
+  ///
+  /// If the construction function throws, the \c BasicLazy is left
+  /// uninitialized, and one of the waiting threads (if any) tries again.
+  ///
+  /// \note Only initialization is synchronized; assigning, swapping, or
+  ///       destroying a \c BasicLazy still requires exclusive access.
+  ///
+  /// \tparam SpinCount the number of times to check the state before parking
+  ////////////////////////////////////////////////////////////////////////////
+  template<unsigned SpinCount = LAZY_SPIN_COUNT>
+  struct basic_double_checked
+  {
+    class state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : m_state(uninitialized){}
+
+      bool is_initialized() const noexcept
+      {
+        return m_state.load(std::memory_order_acquire) == initialized;
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        auto state = m_state.load(std::memory_order_acquire);
+
+        while( state != initialized )
+        {
+          if( state != uninitialized )
+          {
+            // Another thread is constructing the T; wait for it to finish
+            state = wait(state);
+          }
+          else if( m_state.compare_exchange_weak(state,initializing,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_acquire) )
+          {
+            try {
+              init.construct();
+            } catch( ... ) {
+              finish(uninitialized);
+              throw;
+            }
+            finish(initialized);
+            return;
+          }
+        }
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        m_state.store(is_initialized ? initialized : uninitialized,
+                      std::memory_order_release);
+      }
+
+    private:
+
+      enum : std::uint32_t
+      {
+        uninitialized, ///< The T has not been constructed
+        initializing,  ///< A thread is constructing the T
+        contended,     ///< A thread is constructing the T, and others are parked
+        initialized    ///< The T has been constructed
+      };
+
+      /// \brief Publishes the result of constructing the \c T, waking any
+      ///        parked threads
+      ///
+      /// \param state the new state
+      void finish( std::uint32_t state ) noexcept
+      {
+        if( m_state.exchange(state,std::memory_order_release) == contended )
+        {
+          detail::atomic_notify_all(m_state);
+        }
+      }
+
+      /// \brief Waits for the thread constructing the \c T to finish
+      ///
+      /// \param state the last observed state
+      /// \return the state after construction finished
+      LAZY_NOINLINE
+      std::uint32_t wait( std::uint32_t state ) noexcept
+      {
+        for( auto spins = SpinCount; spins != 0; --spins )
+        {
+          if( state == uninitialized || state == initialized ) return state;
+
+          detail::cpu_relax();
+          state = m_state.load(std::memory_order_acquire);
+        }
+
+        while( state == initializing || state == contended )
+        {
+          // Flag that a thread is parking, so that the constructing thread
+          // knows to wake it. This is repeated after every wake-up, since a
+          // new thread may have started constructing without the flag.
+          if( state == initializing &&
+              !m_state.compare_exchange_weak(state,contended,
+                                             std::memory_order_acquire,
+                                             std::memory_order_acquire) )
+          {
+            continue;
+          }
+
+          detail::atomic_wait(m_state,contended);
+          state = m_state.load(std::memory_order_acquire);
+        }
+        return state;
+      }
+
+      detail::atomic_wait_type m_state;
+    };
+  };
+
+  /// \brief The threading policy used by \c ConcurrentLazy, which spins
+  ///        \c LAZY_SPIN_COUNT times before parking
+  using double_checked = basic_double_checked<>;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that may be accessed
+  ///        from many threads at once, initialized with \c std::call_once
+  ///
+  /// This behaves like \c double_checked, but leaves waiting to the standard
+  /// library, which may be preferable where its implementation is known to
+  /// cooperate with the platform's scheduler. Accessing an initialized
+  /// \c BasicLazy costs a single acquire load.
+  ///
+  /// \note Some implementations of \c std::call_once (such as libstdc++
+  ///       before GCC 11, or any program built with ThreadSanitizer)
+  ///       deadlock if the construction function throws; \c double_checked
+  ///       is preferable for construction functions that may throw.
+  ///
+  /// \note Only initialization is synchronized; assigning, swapping, or
+  ///       destroying a \c BasicLazy still requires exclusive access.
+  ////////////////////////////////////////////////////////////////////////////
+  struct call_once
+  {
+    class state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : m_flag(), m_is_initialized(false){}
+
+      bool is_initialized() const noexcept
+      {
+        return m_is_initialized.load(std::memory_order_acquire);
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        std::call_once(m_flag,[this,&init](){
+          // The T may have been assigned without going through the flag
+          if( !m_is_initialized.load(std::memory_order_relaxed) )
+          {
+            init.construct();
+          }
+          m_is_initialized.store(true,std::memory_order_release);
+        });
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        // A std::once_flag can't be reset, so a fresh one is made for the
+        // next initialization
+        if( !is_initialized )
+        {
+          m_flag.~once_flag();
+          ::new (static_cast<void*>(&m_flag)) std::once_flag();
+        }
+        m_is_initialized.store(is_initialized,std::memory_order_release);
+      }
+
+    private:
+
+      std::once_flag    m_flag;
+      std::atomic<bool> m_is_initialized;
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that may be accessed
+  ///        from many threads at once, and whose construction function may
+  ///        safely run more than once
+  ///
+  /// No thread ever waits for another to finish constructing the \c T.
+  /// Instead, every thread that finds the \c BasicLazy uninitialized
+  /// constructs its own \c T, and the first to finish moves it into the
+  /// \c BasicLazy. The others destroy theirs (invoking the destruction
+  /// function) and use the published \c T.
+  ///
+  /// This suits cheap, idempotent construction functions, where waiting
+  /// would cost more than the duplicated work. The construction function
+  /// must be safe to call from several threads at once, and \c T must be
+  /// move-constructible. Arguments stored by \c make_lazy are copied for
+  /// each construction, and are kept after initialization.
+  ///
+  /// \note Only initialization is synchronized; assigning, swapping, or
+  ///       destroying a \c BasicLazy still requires exclusive access.
+  ////////////////////////////////////////////////////////////////////////////
+  struct racy_idempotent
+  {
+    class state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : m_state(uninitialized){}
+
+      bool is_initialized() const noexcept
+      {
+        return m_state.load(std::memory_order_acquire) == initialized;
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        if( is_initialized() ) return;
+
+        typename Initializer::storage_type storage;
+        init.construct_at(&storage);
+
+        auto state = static_cast<unsigned char>(uninitialized);
+        while( !m_state.compare_exchange_weak(state,publishing,
+                                              std::memory_order_acquire,
+                                              std::memory_order_acquire) )
+        {
+          if( state == initialized )
+          {
+            // Another thread won the race
+            init.destroy_at(&storage);
+            return;
+          }
+
+          // Another thread is moving its T into place. If its move throws,
+          // this thread's T is published instead.
+          if( state == publishing ) std::this_thread::yield();
+          state = uninitialized;
+        }
+
+        try {
+          init.relocate_from(&storage);
+        } catch( ... ) {
+          init.destroy_at(&storage);
+          m_state.store(uninitialized,std::memory_order_release);
+          throw;
+        }
+        m_state.store(initialized,std::memory_order_release);
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        m_state.store(is_initialized ? initialized : uninitialized,
+                      std::memory_order_release);
+      }
+
+    private:
+
+      enum : unsigned char
+      {
+        uninitialized, ///< The T has not been constructed
+        publishing,    ///< A thread is moving its T into place
+        initialized    ///< The T has been constructed
+      };
+
+      std::atomic<unsigned char> m_state;
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A threading policy that behaves as \c Policy, but aligns each
+  ///        \c BasicLazy to a cache line
+  ///
+  /// The state of \c Policy is aligned to \c LAZY_CACHE_LINE_SIZE, so the
+  /// \c BasicLazy holding it occupies whole cache lines of its own. The first
+  /// access to one element of an array of these objects then writes only to
+  /// that element's cache lines, rather than invalidating its neighbours in
+  /// the caches of other threads (false sharing).
+  ///
+  /// This suits arrays of objects that are each used by a different thread,
+  /// such as tables of per-worker slots, at the cost of padding every object
+  /// to a multiple of \c LAZY_CACHE_LINE_SIZE bytes.
+  ///
+  /// \note Before C++17, objects allocated with \c new (including by
+  ///       standard containers) may not be aligned, and so may share a
+  ///       cache line at each end
+  ///
+  /// \tparam Policy the threading policy to align
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Policy = single_threaded>
+  struct cache_aligned
+  {
+    class alignas(LAZY_CACHE_LINE_SIZE) state_type
+      : public Policy::state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : Policy::state_type(){}
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A threading policy that behaves as \c Policy, but caches a
+  ///        failed construction for a while instead of retrying it on every
+  ///        access
+  ///
+  /// Normally, a \c BasicLazy whose construction function throws is left
+  /// uninitialized, and the next access retries construction immediately.
+  /// When construction fails because a backing resource is unavailable,
+  /// every access then re-runs the (often slow) failing construction.
+  ///
+  /// With this policy, the exception is instead kept, and rethrown by every
+  /// access for \c DelayMs milliseconds without calling the construction
+  /// function. Threads that were waiting on the failed construction are also
+  /// woken with the cached exception. The first access after the delay
+  /// retries construction. If \c MaxDelayMs is greater than \c DelayMs, the
+  /// delay doubles after each consecutive failure, up to \c MaxDelayMs
+  /// (exponential backoff). A successful construction forgets the failures.
+  ///
+  /// Accessing an initialized \c BasicLazy costs the same as with \c Policy.
+  /// The cached exception is shared by every thread that rethrows it.
+  ///
+  /// \tparam Policy     the threading policy to use for initialization
+  /// \tparam DelayMs    the number of milliseconds to cache the first failure
+  /// \tparam MaxDelayMs the maximum number of milliseconds to cache a failure
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Policy, unsigned DelayMs, unsigned MaxDelayMs = DelayMs>
+  struct cache_failures
+  {
+    static_assert(MaxDelayMs >= DelayMs,"The maximum delay must not be less than the initial delay");
+
+    class state_type
+      : public Policy::state_type
+    {
+      using base_type = typename Policy::state_type;
+      using clock     = std::chrono::steady_clock;
+
+    public:
+
+      constexpr state_type() noexcept
+        : base_type(),
+          m_retry_at(0),
+          m_mutex(),
+          m_error(nullptr),
+          m_failures(0)
+      {
+
+      }
+
+      state_type( const state_type& ) = delete;
+      state_type& operator=( const state_type& ) = delete;
+
+      ~state_type()
+      {
+        delete m_error;
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        rethrow_cached_failure();
+        base_type::initialize( failure_initializer<Initializer>{init,*this} );
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        base_type::set_initialized(is_initialized);
+        if( is_initialized ) forget_failures();
+      }
+
+    private:
+
+      /// \brief The operations of the \c BasicLazy::initializer \c Initializer,
+      ///        which check for and record failures around construction
+      template<typename Initializer>
+      struct failure_initializer
+      {
+        using storage_type = typename Initializer::storage_type;
+
+        const Initializer& init;
+        state_type&        state;
+
+        void construct() const
+        {
+          // A waiting thread may be retrying a construction that has just
+          // failed on another thread
+          state.rethrow_cached_failure();
+          try {
+            init.construct();
+          } catch( ... ) {
+            state.record_failure(std::current_exception());
+            throw;
+          }
+          state.forget_failures();
+        }
+
+        void construct_at( void* where ) const
+        {
+          state.rethrow_cached_failure();
+          try {
+            init.construct_at(where);
+          } catch( ... ) {
+            state.record_failure(std::current_exception());
+            throw;
+          }
+          state.forget_failures();
+        }
+
+        void relocate_from( void* where ) const
+        {
+          init.relocate_from(where);
+        }
+
+        void destroy_at( void* where ) const
+        {
+          init.destroy_at(where);
+        }
+      };
+
+      /// \brief Gets the current time, in ticks of the steady clock
+      static clock::rep now() noexcept
+      {
+        return clock::now().time_since_epoch().count();
+      }
+
+      /// \brief Rethrows the cached exception, if it has not expired
+      void rethrow_cached_failure()
+      {
+        const auto retry_at = m_retry_at.load(std::memory_order_acquire);
+        if( LAZY_LIKELY(retry_at == 0) || now() >= retry_at ) return;
+
+        auto error = std::exception_ptr();
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          if( m_error ) error = *m_error;
+        }
+        if( error ) std::rethrow_exception(error);
+      }
+
+      /// \brief Caches \p error, until the delay for the number of
+      ///        consecutive failures has passed
+      ///
+      /// \param error the exception thrown by construction
+      void record_failure( std::exception_ptr error )
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if( !m_error ) m_error = new std::exception_ptr(std::move(error));
+        else *m_error = std::move(error);
+
+        const auto failures  = m_failures.fetch_add(1,std::memory_order_relaxed);
+        const auto doublings = failures < 31u ? failures : 31u;
+        const auto delay_ms  = static_cast<unsigned long long>(DelayMs) << doublings;
+        const auto delay     = std::chrono::milliseconds(delay_ms < MaxDelayMs ? delay_ms : MaxDelayMs);
+
+        m_retry_at.store( now() + std::chrono::duration_cast<clock::duration>(delay).count(),
+                          std::memory_order_release );
+      }
+
+      /// \brief Forgets any cached exception after a successful construction
+      ///
+      /// This takes no lock, since it is called from \c set_initialized. The
+      /// cached exception is no longer rethrown once \c m_retry_at is reset,
+      /// and is replaced by the next failure, or freed on destruction.
+      void forget_failures() noexcept
+      {
+        if( m_retry_at.load(std::memory_order_acquire) == 0 ) return;
+
+        m_failures.store(0, std::memory_order_relaxed);
+        m_retry_at.store(0, std::memory_order_release);
+      }
+
+      std::atomic<clock::rep> m_retry_at; ///< When construction may be retried, or 0 if it has not failed
+      std::mutex              m_mutex;    ///< Guards the cached exception
+      std::exception_ptr*     m_error;    ///< The cached exception, allocated so that this is constexpr-constructible
+      std::atomic<unsigned>   m_failures; ///< The number of consecutive failures
+    };
+  };
+
+  //==========================================================================
+  // Sentinel values
+  //==========================================================================
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The customization point describing the value of \c T that
+  ///        represents "not yet constructed"
+  ///
+  /// A specialization provides:
+  ///
+  /// - \c static \c constexpr \c T \c empty(), which returns the sentinel
+  ///   value, and
+  /// - \c static \c bool \c is_empty(const T&), which checks whether a value
+  ///   is the sentinel.
+  ///
+  /// Specializations are provided for pointers and \c std::unique_ptr, with
+  /// \c nullptr as the sentinel. Others may be added for user types, or a
+  /// \c value_sentinel can be given to the \c sentinel policies instead.
+  ///
+  /// \tparam T the type with a sentinel value
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  struct sentinel_traits;
+
+  template<typename T>
+  struct sentinel_traits<T*>
+  {
+    static constexpr T* empty() noexcept{ return nullptr; }
+    static bool is_empty( T* const& value ) noexcept{ return value == nullptr; }
+  };
+
+  template<typename T, typename Deleter>
+  struct sentinel_traits<std::unique_ptr<T,Deleter>>
+  {
+    static constexpr std::unique_ptr<T,Deleter> empty() noexcept{ return std::unique_ptr<T,Deleter>(); }
+    static bool is_empty( const std::unique_ptr<T,Deleter>& value ) noexcept{ return value == nullptr; }
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief Sentinel traits using the reserved value \c Empty, such as \c -1
+  ///        for a file descriptor
+  ///
+  /// \tparam T     the type with a sentinel value
+  /// \tparam Empty the sentinel value
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T, T Empty>
+  struct value_sentinel
+  {
+    static constexpr T empty() noexcept{ return Empty; }
+    static bool is_empty( const T& value ) noexcept{ return value == Empty; }
+  };
+
+  namespace detail{
+
+    /// \brief Gets the sentinel traits to use for \c T: \c Traits, or
+    ///        \c sentinel_traits<T> if \c Traits is \c void
+    template<typename Traits, typename T>
+    using select_sentinel_traits = typename std::conditional<
+      std::is_void<Traits>::value,
+      sentinel_traits<T>,
+      Traits
+    >::type;
+
+  } // namespace detail
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that stores no separate
+  ///        initialized state, and is only ever accessed from one thread at a
+  ///        time
+  ///
+  /// Instead of a flag beside the \c T, the \c BasicLazy holds the sentinel
+  /// value (described by \c Traits) until the \c T is constructed. This
+  /// saves the flag and its padding for pointers, handles, and identifiers
+  /// that have a value reserved for "none".
+  ///
+  /// \note A \c BasicLazy whose \c T is constructed with (or moved into) the
+  ///       sentinel value is uninitialized. Moving out of a \c std::unique_ptr
+  ///       therefore leaves its \c BasicLazy uninitialized.
+  ///
+  /// \tparam Traits the sentinel traits, or \c void to use
+  ///                \c sentinel_traits<T>
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Traits = void>
+  struct sentinel
+  {
+    /// \brief The state of a \c BasicLazy, which holds the \c T itself
+    template<typename T>
+    class value_state
+    {
+      using value_type  = typename std::remove_cv<T>::type;
+      using traits_type = detail::select_sentinel_traits<Traits,value_type>;
+
+    public:
+
+      constexpr value_state() noexcept : m_value(traits_type::empty()){}
+
+      // The T is destroyed by the BasicLazy, which leaves the sentinel
+      ~value_state()
+      {
+        m_value.~value_type();
+      }
+
+      value_type* ptr() noexcept
+      {
+        return &m_value;
+      }
+
+      bool is_initialized() const noexcept
+      {
+        return !traits_type::is_empty(m_value);
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        if( !is_initialized() )
+        {
+          clear();
+          try {
+            init.construct();
+          } catch( ... ) {
+            set_initialized(false);
+            throw;
+          }
+        }
+      }
+
+      /// \brief Destroys the sentinel, so that a \c T may be constructed
+      ///        in its place
+      void clear() noexcept
+      {
+        m_value.~value_type();
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        // The T has already been constructed in place of the sentinel, or
+        // destroyed
+        if( !is_initialized ) new (&m_value) value_type(traits_type::empty());
+      }
+
+    private:
+
+      union{ value_type m_value; };
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that stores no separate
+  ///        initialized state, and may be accessed from many threads at once
+  ///
+  /// The \c T is held in a single atomic word, which holds the sentinel
+  /// value (described by \c Traits) until the \c T is published. As with
+  /// \c racy_idempotent, every thread that finds the \c BasicLazy
+  /// uninitialized constructs its own \c T, and the first to publish it with
+  /// a compare-and-swap wins; the others invoke the destruction function on
+  /// theirs. No thread ever waits for another, and accessing an initialized
+  /// \c BasicLazy costs a single acquire load.
+  ///
+  /// This suits lazily opened file descriptors and handles, where opening
+  /// twice (and closing the extra one) is harmless. \c T must be trivially
+  /// copyable, and should be small enough for \c std::atomic<T> to be
+  /// lock-free.
+  ///
+  /// \note Only initialization is synchronized; assigning, swapping, or
+  ///       destroying a \c BasicLazy still requires exclusive access.
+  ///
+  /// \tparam Traits the sentinel traits, or \c void to use
+  ///                \c sentinel_traits<T>
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Traits = void>
+  struct atomic_sentinel
+  {
+    /// \brief The state of a \c BasicLazy, which holds the \c T itself
+    template<typename T>
+    class value_state
+    {
+      using value_type  = typename std::remove_cv<T>::type;
+      using traits_type = detail::select_sentinel_traits<Traits,value_type>;
+
+      static_assert(std::is_trivially_copyable<value_type>::value,"atomic_sentinel requires T to be trivially copyable");
+      static_assert(sizeof(std::atomic<value_type>) == sizeof(value_type),"atomic_sentinel requires std::atomic<T> to have the layout of T");
+
+    public:
+
+      constexpr value_state() noexcept : m_value(traits_type::empty()){}
+
+      value_type* ptr() noexcept
+      {
+        return reinterpret_cast<value_type*>(&m_value);
+      }
+
+      bool is_initialized() const noexcept
+      {
+        return !traits_type::is_empty(m_value.load(std::memory_order_acquire));
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        typename Initializer::storage_type storage;
+        init.construct_at(&storage);
+
+        auto expected = traits_type::empty();
+        if( !m_value.compare_exchange_strong(expected,*reinterpret_cast<value_type*>(&storage),
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire) )
+        {
+          // Another thread won the race
+          init.destroy_at(&storage);
+        }
+      }
+
+      // The T is trivially destructible, so the sentinel needs no destruction
+      void clear() noexcept{}
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        // The T has already been constructed or destroyed in place
+        if( !is_initialized ) m_value.store(traits_type::empty(),std::memory_order_release);
+      }
+
+    private:
+
+      std::atomic<value_type> m_value;
+    };
+  };
+
+  namespace detail{
+
+    /// \brief Type trait to determine whether a \c BasicLazy with \c Policy
+    ///        may be initialized from many threads at once
+    ///
+    /// The result is aliased as \c ::value
+    template<typename Policy>
+    struct is_thread_safe_policy : std::false_type{};
+
+    template<unsigned SpinCount>
+    struct is_thread_safe_policy<basic_double_checked<SpinCount>> : std::true_type{};
+
+    template<>
+    struct is_thread_safe_policy<call_once> : std::true_type{};
+
+    template<>
+    struct is_thread_safe_policy<racy_idempotent> : std::true_type{};
+
+    template<typename Traits>
+    struct is_thread_safe_policy<atomic_sentinel<Traits>> : std::true_type{};
+
+    template<typename Policy>
+    struct is_thread_safe_policy<cache_aligned<Policy>> : is_thread_safe_policy<Policy>{};
+
+    template<typename Policy, unsigned DelayMs, unsigned MaxDelayMs>
+    struct is_thread_safe_policy<cache_failures<Policy,DelayMs,MaxDelayMs>> : is_thread_safe_policy<Policy>{};
+
+    /// \brief Type trait to determine whether a \c BasicLazy with \c Policy
+    ///        may construct a \c T on several threads at once, each into
+    ///        storage of its own
+    ///
+    /// The result is aliased as \c ::value
+    template<typename Policy>
+    struct races_construction : std::false_type{};
+
+    template<>
+    struct races_construction<racy_idempotent> : std::true_type{};
+
+    template<typename Traits>
+    struct races_construction<atomic_sentinel<Traits>> : std::true_type{};
+
+    template<typename Policy>
+    struct races_construction<cache_aligned<Policy>> : races_construction<Policy>{};
+
+    template<typename Policy, unsigned DelayMs, unsigned MaxDelayMs>
+    struct races_construction<cache_failures<Policy,DelayMs,MaxDelayMs>> : races_construction<Policy>{};
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_LAZY_POLICY_HPP_ */
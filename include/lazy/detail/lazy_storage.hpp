@@ -0,0 +1,289 @@
+/**
+ * \file lazy_storage.hpp
+ *
+ * \brief This file contains the storage of a \c BasicLazy, which selects a
+ *        trivial destructor when there is nothing to destroy.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_LAZY_STORAGE_HPP_
+#define LAZY_DETAIL_LAZY_STORAGE_HPP_
+
+#include "lazy_traits.hpp"
+#include "lazy_function.hpp"
+#include "lazy_policy.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace lazy{
+  namespace detail{
+
+    /// \brief Type trait to determine whether the destruction function
+    ///        \c DtorFunc is known to do nothing
+    ///
+    /// The result is aliased as \c ::value
+    template<typename DtorFunc>
+    struct is_noop_destructor : std::false_type{};
+
+    template<typename T>
+    struct is_noop_destructor<default_destructor<T>> : std::true_type{};
+
+    /// \brief Type trait to determine whether a
+    ///        \c BasicLazy<T,CtorFunc,DtorFunc,Policy> can be trivially
+    ///        destructible
+    ///
+    /// This is the case when destroying \c T does nothing, the destruction
+    /// function does nothing, and neither the functions nor the state of the
+    /// threading policy own any resources.
+    ///
+    /// The result is aliased as \c ::value
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    struct is_trivially_destructible_lazy : boolean_constant<
+      std::is_trivially_destructible<T>::value &&
+      is_noop_destructor<DtorFunc>::value &&
+      std::is_trivially_destructible<function_pair<CtorFunc,DtorFunc>>::value &&
+      std::is_trivially_destructible<typename Policy::state_type>::value
+    >{};
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The storage for a \c BasicLazy
+    ///
+    /// This holds the lazily-constructed \c T, whether it has been
+    /// initialized, and the construction and destruction functions. This
+    /// primary template destroys the \c T on destruction.
+    ///
+    /// \tparam T        the type being stored
+    /// \tparam CtorFunc the type of the construction function
+    /// \tparam DtorFunc the type of the destruction function
+    /// \tparam Policy   the threading policy
+    ////////////////////////////////////////////////////////////////////////////
+    template<
+      typename T,
+      typename CtorFunc,
+      typename DtorFunc,
+      typename Policy,
+      bool = is_trivially_destructible_lazy<T,CtorFunc,DtorFunc,Policy>::value
+    >
+    class lazy_storage
+    {
+    protected:
+
+      using unqualified_pointer = typename std::remove_cv<T>::type*;
+      using function_pair_type  = function_pair<CtorFunc,DtorFunc>;
+      using state_type          = typename Policy::state_type;
+      using storage_type        = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+
+      constexpr lazy_storage()
+        : m_storage(),
+          m_state(),
+          m_functions()
+      {
+
+      }
+
+      template<typename...Functions>
+      constexpr explicit lazy_storage( Functions&&...functions )
+        : m_storage(),
+          m_state(),
+          m_functions(static_cast<Functions&&>(functions)...)
+      {
+
+      }
+
+      ~lazy_storage()
+      {
+        destruct();
+      }
+
+      /// \brief Gets a pointer to the data stored in this \c lazy_storage
+      ///
+      /// \return the pointer to the object
+      unqualified_pointer ptr() const noexcept
+      {
+        // address-of idiom (https://en.wikibooks.org/wiki/More_C%2B%2B_Idioms/Address_Of)
+        return reinterpret_cast<unqualified_pointer>(& const_cast<char&>(reinterpret_cast<const volatile char &>(m_storage)));
+      }
+
+      /// \brief Destructs the \c T, if it has been initialized
+      void destruct() const
+      {
+        if( m_state.is_initialized() )
+        {
+          m_functions.second()(*ptr());
+          ptr()->~T();
+          m_state.set_initialized(false);
+        }
+      }
+
+      // The initialized state directly follows the storage so that it
+      // occupies the padding between a small T and the (pointer-aligned)
+      // functions, rather than adding padding of its own
+
+      mutable storage_type       m_storage;        ///< The storage to hold the lazy type
+      mutable state_type         m_state;          ///< Is the type initialized?
+      mutable function_pair_type m_functions;      ///< The construction/destruction functions
+    };
+
+    /// \brief The storage for a \c BasicLazy with nothing to destroy
+    ///
+    /// Destroying the \c T is skipped entirely, leaving this (and the
+    /// \c BasicLazy containing it) trivially destructible.
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    class lazy_storage<T,CtorFunc,DtorFunc,Policy,true>
+    {
+    protected:
+
+      using unqualified_pointer = typename std::remove_cv<T>::type*;
+      using function_pair_type  = function_pair<CtorFunc,DtorFunc>;
+      using state_type          = typename Policy::state_type;
+      using storage_type        = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+
+      constexpr lazy_storage()
+        : m_storage(),
+          m_state(),
+          m_functions()
+      {
+
+      }
+
+      template<typename...Functions>
+      constexpr explicit lazy_storage( Functions&&...functions )
+        : m_storage(),
+          m_state(),
+          m_functions(static_cast<Functions&&>(functions)...)
+      {
+
+      }
+
+      unqualified_pointer ptr() const noexcept
+      {
+        // address-of idiom (https://en.wikibooks.org/wiki/More_C%2B%2B_Idioms/Address_Of)
+        return reinterpret_cast<unqualified_pointer>(& const_cast<char&>(reinterpret_cast<const volatile char &>(m_storage)));
+      }
+
+      void destruct() const noexcept
+      {
+        m_state.set_initialized(false);
+      }
+
+      mutable storage_type       m_storage;        ///< The storage to hold the lazy type
+      mutable state_type         m_state;          ///< Is the type initialized?
+      mutable function_pair_type m_functions;      ///< The construction/destruction functions
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief Type trait to determine whether \c Policy encodes the
+    ///        initialized state in the value of the \c T
+    ///
+    /// The result is aliased as \c ::value
+    template<typename Policy>
+    struct is_sentinel_policy : std::false_type{};
+
+    template<typename Traits>
+    struct is_sentinel_policy<sentinel<Traits>> : std::true_type{};
+
+    template<typename Traits>
+    struct is_sentinel_policy<atomic_sentinel<Traits>> : std::true_type{};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The storage for a \c BasicLazy whose policy encodes the
+    ///        initialized state in the value of the \c T
+    ///
+    /// The state of the policy holds the \c T itself, so there is no
+    /// separate flag. The functions take no space when they are empty, where
+    /// \c LAZY_NO_UNIQUE_ADDRESS is supported.
+    ///
+    /// \tparam T        the type being stored
+    /// \tparam CtorFunc the type of the construction function
+    /// \tparam DtorFunc the type of the destruction function
+    /// \tparam Policy   the threading policy
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    class sentinel_lazy_storage
+    {
+    protected:
+
+      using unqualified_pointer = typename std::remove_cv<T>::type*;
+      using function_pair_type  = function_pair<CtorFunc,DtorFunc>;
+      using state_type          = typename Policy::template value_state<T>;
+      using storage_type        = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+
+      constexpr sentinel_lazy_storage()
+        : m_state(),
+          m_functions()
+      {
+
+      }
+
+      template<typename...Functions>
+      constexpr explicit sentinel_lazy_storage( Functions&&...functions )
+        : m_state(),
+          m_functions(static_cast<Functions&&>(functions)...)
+      {
+
+      }
+
+      ~sentinel_lazy_storage()
+      {
+        destruct();
+      }
+
+      /// \brief Gets a pointer to the data stored in this storage
+      ///
+      /// \return the pointer to the object
+      unqualified_pointer ptr() const noexcept
+      {
+        return m_state.ptr();
+      }
+
+      /// \brief Destructs the \c T, if it has been initialized
+      void destruct() const
+      {
+        if( m_state.is_initialized() )
+        {
+          m_functions.second()(*ptr());
+          ptr()->~T();
+          m_state.set_initialized(false);
+        }
+      }
+
+      mutable state_type                                m_state;     ///< The T, or its sentinel
+      LAZY_NO_UNIQUE_ADDRESS mutable function_pair_type m_functions; ///< The construction/destruction functions
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief Selects the storage for a \c BasicLazy<T,CtorFunc,DtorFunc,Policy>
+    ///
+    /// The result is aliased as \c ::type
+    template<
+      typename T,
+      typename CtorFunc,
+      typename DtorFunc,
+      typename Policy,
+      bool = is_sentinel_policy<Policy>::value
+    >
+    struct select_lazy_storage
+    {
+      using type = lazy_storage<T,CtorFunc,DtorFunc,Policy>;
+    };
+
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    struct select_lazy_storage<T,CtorFunc,DtorFunc,Policy,true>
+    {
+      using type = sentinel_lazy_storage<T,CtorFunc,DtorFunc,Policy>;
+    };
+
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    using lazy_storage_t = typename select_lazy_storage<T,CtorFunc,DtorFunc,Policy>::type;
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_LAZY_STORAGE_HPP_ */
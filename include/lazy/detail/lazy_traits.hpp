@@ -53,6 +53,10 @@ namespace lazy{
     template<bool b>
     using boolean_constant = std::integral_constant<bool,b>;
 
+    /// \brief Type alias to remove references and cv-qualifiers from \c T
+    template<typename T>
+    using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>::type>::type;
+
     /// \brief Type-trait for identities (always defines \c T as \c type)
     ///
     /// This aliases \c T as \c ::type
@@ -234,7 +238,7 @@ namespace lazy{
     struct is_tuple_constructible<T,std::pair<Args...>> : public std::is_constructible<T,Args...>{};
 
     /// \brief Type trait to determine whether or not the type \c T is
-    ///        a callable (function, member function, functor)
+    ///        a callable (function, function pointer, member function, functor)
     ///
     /// The result is aliased as \c ::type
     template<typename T>
@@ -244,10 +248,21 @@ namespace lazy{
       typename std::conditional<
         std::is_member_function_pointer<T>::value,
         std::is_member_function_pointer<T>,
-        std::is_function<T>
+        std::is_function<typename std::remove_pointer<T>::type>
       >::type
     >::type{};
 
+    //------------------------------------------------------------------------
+
+    /// \brief Type trait to determine whether the type \c T can be stored
+    ///        through the empty-base optimization
+    ///
+    /// The result is aliased as \c ::value
+    template<typename T>
+    struct is_ebo_candidate : boolean_constant<
+      std::is_class<T>::value && std::is_empty<T>::value && !__is_final(T)
+    >{};
+
   } // namespace detail
 } // namespace lazy
 
@@ -0,0 +1,64 @@
+/**
+ * \file owned_value.hpp
+ *
+ * \brief This file contains a heap-allocatable \c T that owns a copy of the
+ *        functions it was constructed with.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_OWNED_VALUE_HPP_
+#define LAZY_DETAIL_OWNED_VALUE_HPP_
+
+#include "lazy_function.hpp"
+
+#include <type_traits>
+
+namespace lazy{
+  namespace detail{
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief A \c T constructed from a copy of the functions of a lazy
+    ///        object, for lazy objects that allocate their values
+    ///
+    /// The \c T is constructed along with the \c owned_value, and the copy of
+    /// the destruction function is kept to be invoked when it is destroyed.
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename T>
+    class owned_value final
+    {
+    public:
+
+      explicit owned_value( const erased_function<T>& function )
+        : m_function(function)
+      {
+        m_function.consume( get() ); // only the destruction function is needed now
+      }
+
+      owned_value( const owned_value& ) = delete;
+      owned_value& operator=( const owned_value& ) = delete;
+
+      ~owned_value()
+      {
+        m_function( *get() );
+        get()->~T();
+      }
+
+      typename std::remove_cv<T>::type* get() noexcept
+      {
+        return reinterpret_cast<typename std::remove_cv<T>::type*>(&m_storage);
+      }
+
+    private:
+
+      using storage_type = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+
+      erased_function<T> m_function; ///< This value's copy of the functions
+      storage_type       m_storage;  ///< The storage of the T
+    };
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_OWNED_VALUE_HPP_ */
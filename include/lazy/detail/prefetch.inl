@@ -0,0 +1,9 @@
+namespace lazy{
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void prefetch( const BasicLazy<T,CtorFunc,DtorFunc,Policy>& lazy )
+  {
+    lazy.prefetch( default_executor() );
+  }
+
+} // namespace lazy
@@ -0,0 +1,313 @@
+/**
+ * \file thread_local_registry.hpp
+ *
+ * \brief This file contains the bookkeeping that associates each
+ *        \c ThreadLocalLazy with the instances constructed by each thread.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \version 1.0
+ */
+
+#ifndef LAZY_DETAIL_THREAD_LOCAL_REGISTRY_HPP_
+#define LAZY_DETAIL_THREAD_LOCAL_REGISTRY_HPP_
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace lazy{
+  namespace detail{
+
+    class thread_local_slots;
+    class thread_local_owner;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The instance of a \c ThreadLocalLazy belonging to one thread
+    ///
+    /// Each node is linked into the list of its owner, so that the owner can
+    /// enumerate the instances of every thread, and is referenced from the
+    /// slots of the thread it belongs to, so that it can be found quickly.
+    ////////////////////////////////////////////////////////////////////////////
+    struct thread_local_node
+    {
+      virtual ~thread_local_node() = default;
+
+      thread_local_owner* owner    = nullptr; ///< The ThreadLocalLazy this belongs to
+      thread_local_slots* slots    = nullptr; ///< The slots of the thread this belongs to
+      thread_local_node*  previous = nullptr; ///< The previous node of the owner
+      thread_local_node*  next     = nullptr; ///< The next node of the owner
+    };
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The process-wide state shared by every \c ThreadLocalLazy
+    ///
+    /// This hands out the index of each \c ThreadLocalLazy into the slots of
+    /// every thread, and guards all changes to nodes. Only the first access
+    /// from each thread, thread exit, enumeration, and destruction take the
+    /// lock; accessing an existing instance does not.
+    ///
+    /// The lock is recursive, so that constructing or enumerating the
+    /// instance of one \c ThreadLocalLazy may access another.
+    ////////////////////////////////////////////////////////////////////////////
+    class thread_local_registry
+    {
+    public:
+
+      /// \brief Gets the registry
+      ///
+      /// \note The registry is never destroyed, so that threads exiting
+      ///       during static destruction can still use it
+      ///
+      /// \return the registry
+      static thread_local_registry& instance()
+      {
+        static auto* registry = new thread_local_registry();
+        return *registry;
+      }
+
+      /// \brief Gets the lock guarding all nodes
+      ///
+      /// \return the lock
+      std::recursive_mutex& mutex() noexcept
+      {
+        return m_mutex;
+      }
+
+      /// \brief Reserves a unique index into the slots of each thread
+      ///
+      /// \return the index
+      std::size_t acquire_index()
+      {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+        if( m_free_indices.empty() ) return m_next_index++;
+
+        auto index = m_free_indices.back();
+        m_free_indices.pop_back();
+        return index;
+      }
+
+      /// \brief Returns an index reserved with \c acquire_index, once no
+      ///        thread's slot refers to it
+      ///
+      /// \param index the index to release
+      void release_index( std::size_t index )
+      {
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+        m_free_indices.push_back(index);
+      }
+
+    private:
+
+      thread_local_registry() = default;
+
+      std::recursive_mutex     m_mutex;        ///< The lock guarding all nodes
+      std::vector<std::size_t> m_free_indices; ///< Released indices, for reuse
+      std::size_t              m_next_index = 0; ///< The next unused index
+    };
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The nodes belonging to one thread, indexed by the index of their
+    ///        owner
+    ///
+    /// The remaining nodes are destroyed when the thread exits.
+    ////////////////////////////////////////////////////////////////////////////
+    class thread_local_slots
+    {
+    public:
+
+      /// \brief Gets the slots of the calling thread
+      ///
+      /// \return the slots
+      static thread_local_slots& current()
+      {
+        thread_local thread_local_slots slots;
+        return slots;
+      }
+
+      thread_local_slots() = default;
+      thread_local_slots( const thread_local_slots& ) = delete;
+      thread_local_slots& operator=( const thread_local_slots& ) = delete;
+
+      /// \brief Destroys the nodes of this thread
+      ~thread_local_slots();
+
+      /// \brief Finds the node at \p index
+      ///
+      /// \param index the index of the owner
+      /// \return the node, or \c nullptr if there is none
+      thread_local_node* find( std::size_t index ) const noexcept
+      {
+        return index < m_nodes.size() ? m_nodes[index] : nullptr;
+      }
+
+      /// \brief Stores \p node at \p index
+      ///
+      /// \note The registry's lock must be held
+      ///
+      /// \param index the index of the owner
+      /// \param node  the node to store
+      void insert( std::size_t index, thread_local_node* node )
+      {
+        if( index >= m_nodes.size() ) m_nodes.resize(index + 1);
+        m_nodes[index] = node;
+        node->slots = this;
+      }
+
+      /// \brief Clears the node at \p index
+      ///
+      /// \note The registry's lock must be held
+      ///
+      /// \param index the index of the owner
+      void erase( std::size_t index ) noexcept
+      {
+        m_nodes[index] = nullptr;
+      }
+
+    private:
+
+      std::vector<thread_local_node*> m_nodes; ///< The nodes, indexed by owner
+    };
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The part of a \c ThreadLocalLazy that does not depend on \c T,
+    ///        which keeps track of the instances of every thread
+    ////////////////////////////////////////////////////////////////////////////
+    class thread_local_owner
+    {
+    public:
+
+      thread_local_owner()
+        : m_index(thread_local_registry::instance().acquire_index())
+      {
+
+      }
+
+      thread_local_owner( const thread_local_owner& ) = delete;
+      thread_local_owner& operator=( const thread_local_owner& ) = delete;
+
+      /// \brief Destroys the instances of every thread
+      ~thread_local_owner()
+      {
+        auto& registry = thread_local_registry::instance();
+        {
+          std::lock_guard<std::recursive_mutex> lock(registry.mutex());
+
+          while( m_head )
+          {
+            auto node = m_head;
+            unlink(node);
+            node->slots->erase(m_index);
+            delete node;
+          }
+        }
+        registry.release_index(m_index);
+      }
+
+      /// \brief Finds the node belonging to the calling thread
+      ///
+      /// \return the node, or \c nullptr if there is none
+      thread_local_node* find() const
+      {
+        return thread_local_slots::current().find(m_index);
+      }
+
+      /// \brief Takes ownership of \p node as the node belonging to the
+      ///        calling thread
+      ///
+      /// \param node the node
+      void insert( thread_local_node* node )
+      {
+        auto& slots = thread_local_slots::current();
+
+        std::lock_guard<std::recursive_mutex> lock(thread_local_registry::instance().mutex());
+
+        try {
+          slots.insert(m_index,node);
+        } catch( ... ) {
+          delete node;
+          throw;
+        }
+
+        node->owner = this;
+        node->next  = m_head;
+        if( m_head ) m_head->previous = node;
+        m_head = node;
+      }
+
+      /// \brief Removes \p node from the nodes of this owner
+      ///
+      /// \note The registry's lock must be held
+      ///
+      /// \param node the node to remove
+      void unlink( thread_local_node* node ) noexcept
+      {
+        if( node->previous ) node->previous->next = node->next;
+        else m_head = node->next;
+        if( node->next ) node->next->previous = node->previous;
+      }
+
+      /// \brief Invokes \p function on the node of every thread
+      ///
+      /// \param function the function to invoke
+      template<typename Function>
+      void for_each( Function&& function ) const
+      {
+        std::lock_guard<std::recursive_mutex> lock(thread_local_registry::instance().mutex());
+
+        for( auto node = m_head; node; node = node->next ) {
+          function(*node);
+        }
+      }
+
+      /// \brief Gets the index of this owner into each thread's slots
+      ///
+      /// \return the index
+      std::size_t index() const noexcept
+      {
+        return m_index;
+      }
+
+    private:
+
+      std::size_t        m_index;          ///< The index into each thread's slots
+      thread_local_node* m_head = nullptr; ///< The nodes of every thread
+    };
+
+    //------------------------------------------------------------------------
+
+    inline thread_local_slots::~thread_local_slots()
+    {
+      std::lock_guard<std::recursive_mutex> lock(thread_local_registry::instance().mutex());
+
+      // The destructor of a T may access another ThreadLocalLazy, which may
+      // add nodes to the slots. Each slot is therefore cleared before its
+      // node is destroyed, the slots are indexed rather than iterated, and
+      // they are swept again until no nodes remain.
+      auto destroyed = true;
+      while( destroyed )
+      {
+        destroyed = false;
+        for( auto index = std::size_t(0); index < m_nodes.size(); ++index ) {
+          auto node = m_nodes[index];
+          if( !node ) continue;
+
+          m_nodes[index] = nullptr;
+          node->owner->unlink(node);
+          delete node;
+          destroyed = true;
+        }
+      }
+    }
+
+  } // namespace detail
+} // namespace lazy
+
+#endif /* LAZY_DETAIL_THREAD_LOCAL_REGISTRY_HPP_ */
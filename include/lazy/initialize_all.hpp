@@ -0,0 +1,141 @@
+/**
+ * \file initialize_all.hpp
+ *
+ * \brief This file contains \c lazy::initialize_all, which constructs the
+ *        values of many lazy objects in parallel.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \copyright Matthew Rodusek
+ */
+
+#ifndef LAZY_INITIALIZE_ALL_HPP_
+#define LAZY_INITIALIZE_ALL_HPP_
+
+#include "detail/executor_ref.hpp"
+#include "WorkStealingExecutor.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lazy{
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The exception thrown by \c initialize_all when one or more lazy
+  ///        objects fail to initialize
+  ///
+  /// It holds the exception thrown for each one, in no particular order.
+  ////////////////////////////////////////////////////////////////////////////
+  class initialization_error final
+    : public std::exception
+  {
+  public:
+
+    /// \brief Constructs an \c initialization_error from the exceptions that
+    ///        were thrown
+    ///
+    /// \param errors the exceptions
+    explicit initialization_error( std::vector<std::exception_ptr> errors )
+      : m_errors(std::move(errors))
+    {
+
+    }
+
+    /// \brief Gets the exceptions that were thrown
+    ///
+    /// \return the exceptions, one for each lazy object that failed
+    const std::vector<std::exception_ptr>& errors() const noexcept
+    {
+      return m_errors;
+    }
+
+    const char* what() const noexcept override
+    {
+      return "lazy::initialization_error: lazy objects failed to initialize";
+    }
+
+  private:
+
+    std::vector<std::exception_ptr> m_errors; ///< The exceptions that were thrown
+  };
+
+  //--------------------------------------------------------------------------
+  // Free Functions
+  //--------------------------------------------------------------------------
+
+  /// \brief Constructs the values of every uninitialized lazy object in
+  ///        \p range in parallel, on \c default_executor()
+  ///
+  /// \see initialize_all(Range&&,Executor&)
+  ///
+  /// \param range the lazy objects to initialize
+  template<typename Range>
+  void initialize_all( Range&& range );
+
+  /// \brief Constructs the values of every uninitialized lazy object in
+  ///        \p range in parallel, on \p executor
+  ///
+  /// Each lazy object in \p range (anything with \c is_initialized() and
+  /// \c get(), such as a \c Lazy or \c ConcurrentLazy) that is not yet
+  /// initialized is constructed by exactly one thread. The objects are
+  /// shared out among up to one task per thread of \p executor (its
+  /// \c thread_count(), or else the number of hardware threads), which each
+  /// take the next object until none remain; the calling thread takes part as
+  /// well, so this completes even when every thread of \p executor is busy
+  /// (including when it is called from a task on \p executor).
+  ///
+  /// This returns once every object has been constructed or has failed.
+  ///
+  /// \note Each object is only accessed by the thread that constructs it,
+  ///       so objects with the \c single_threaded policy may be used, as
+  ///       long as no object appears in \p range twice and no other thread
+  ///       accesses them meanwhile.
+  ///
+  /// \throw initialization_error if any construction throws, holding every
+  ///        exception that was thrown
+  /// \param range    the lazy objects to initialize
+  /// \param executor any object for which \c executor.execute(f) runs the
+  ///                 nullary function \c f on some thread
+  template<
+    typename Range,
+    typename Executor,
+    typename = typename std::enable_if<detail::is_executor<Executor>::value>::type
+  >
+  void initialize_all( Range&& range, Executor& executor );
+
+  /// \brief Calls \p visitor with each element of \p range in parallel, on
+  ///        \p executor
+  ///
+  /// This initializes ranges of lazy objects of different types, or that
+  /// are held indirectly: \p visitor is called with each element, from
+  /// several threads at once, and should initialize the lazy object it
+  /// refers to. Unlike \c initialize_all(Range&&,Executor&), elements are
+  /// not checked for initialization first.
+  ///
+  /// \throw initialization_error if any call to \p visitor throws, holding
+  ///        every exception that was thrown
+  /// \param range    the elements to visit
+  /// \param executor the executor to visit them on
+  /// \param visitor  the function to call with each element
+  template<
+    typename Range,
+    typename Executor,
+    typename Visitor,
+    typename = typename std::enable_if<detail::is_executor<Executor>::value>::type
+  >
+  void initialize_all( Range&& range, Executor& executor, Visitor visitor );
+
+} // namespace lazy
+
+#include "detail/initialize_all.inl"
+
+#endif /* LAZY_INITIALIZE_ALL_HPP_ */
@@ -0,0 +1,34 @@
+/**
+ * \file prefetch.hpp
+ *
+ * \brief This file contains \c lazy::prefetch, which starts the construction
+ *        of a lazy object on the default executor.
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ * \copyright Matthew Rodusek
+ */
+
+#ifndef LAZY_PREFETCH_HPP_
+#define LAZY_PREFETCH_HPP_
+
+#include "Lazy.hpp"
+#include "WorkStealingExecutor.hpp"
+
+namespace lazy{
+
+  /// \brief Submits the construction of the \c T of \p lazy to
+  ///        \c default_executor(), unless it is already constructed
+  ///
+  /// \note \p lazy must outlive the submitted task
+  ///
+  /// \see BasicLazy::prefetch
+  ///
+  /// \param lazy the lazy object, which must have a thread-safe policy
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  void prefetch( const BasicLazy<T,CtorFunc,DtorFunc,Policy>& lazy );
+
+} // namespace lazy
+
+#include "detail/prefetch.inl"
+
+#endif /* LAZY_PREFETCH_HPP_ */
@@ -3,8 +3,11 @@
  *
  * \brief This is the main include file for the \c Lazy library.
  *
- * Including this gives access to \c lazy::Lazy<T> and the utility
- * \c lazy::make_lazy functions.
+ * Including this gives access to \c lazy::Lazy<T>, the thread-safe
+ * \c lazy::ConcurrentLazy<T>, the statically-typed
+ * \c lazy::BasicLazy<T,CtorFunc,DtorFunc,Policy>, and the utility
+ * \c lazy::make_lazy functions. The other lazy types, executors and
+ * algorithms each have their own header under \c lazy/.
  *
  *
  * \author Matthew Rodusek (matthew.rodusek@gmail.com)
@@ -39,13 +42,183 @@
 #ifndef LAZY_LAZY_HPP_
 #define LAZY_LAZY_HPP_
 
+/// \def LAZY_DEFAULT_INLINE_BYTES
+///
+/// \brief The number of bytes a \c Lazy reserves for storing its construction
+///        function (and any arguments captured by it) without allocating
+///
+/// Construction functions that don't fit in this many bytes are allocated on
+/// the heap, unless \c LAZY_NO_HEAP_FALLBACK is defined.
+#ifndef LAZY_DEFAULT_INLINE_BYTES
+# define LAZY_DEFAULT_INLINE_BYTES (4 * sizeof(void*))
+#endif
+/// \def LAZY_NO_HEAP_FALLBACK
+///
+/// \brief When defined, construction functions that don't fit in the inline
+///        buffer of a \c Lazy fail to compile rather than being allocated on
+///        the heap
+#ifdef LAZY_NO_HEAP_FALLBACK
+# define LAZY_HEAP_FALLBACK_ENABLED 0
+#else
+# define LAZY_HEAP_FALLBACK_ENABLED 1
+#endif
+/// \def LAZY_SPIN_COUNT
+///
+/// \brief The number of times a thread waiting for another thread to
+///        initialize a \c ConcurrentLazy checks on it before parking
+///
+/// Spinning avoids the cost of parking when construction is quick, while
+/// parking keeps many waiting threads from burning cores when it is not.
+#ifndef LAZY_SPIN_COUNT
+# define LAZY_SPIN_COUNT 100
+#endif
+/// \def LAZY_CACHE_LINE_SIZE
+///
+/// \brief The size of a cache line, in bytes
+///
+/// Objects that are written from different threads (such as the shards of a
+/// \c ShardedLazy) are aligned to this, so that no two share a cache line.
+#ifndef LAZY_CACHE_LINE_SIZE
+# define LAZY_CACHE_LINE_SIZE 64
+#endif
+/// \def LAZY_LIKELY(x)
+///
+/// \brief Hints to the compiler that the condition \p x is usually \c true
+///
+/// \def LAZY_UNLIKELY(x)
+///
+/// \brief Hints to the compiler that the condition \p x is usually \c false
+#if defined(__GNUC__) || defined(__clang__)
+# define LAZY_LIKELY(x)   __builtin_expect(!!(x),1)
+# define LAZY_UNLIKELY(x) __builtin_expect(!!(x),0)
+#else
+# define LAZY_LIKELY(x)   (x)
+# define LAZY_UNLIKELY(x) (x)
+#endif
+/// \def LAZY_NOINLINE
+///
+/// \brief Prevents a function from being inlined into its callers
+///
+/// \def LAZY_COLD
+///
+/// \brief Marks a function as rarely called, so that it is optimized for
+///        size and placed away from frequently executed code
+#if defined(__GNUC__) || defined(__clang__)
+# define LAZY_NOINLINE __attribute__((noinline))
+# define LAZY_COLD     __attribute__((cold))
+#elif defined(_MSC_VER)
+# define LAZY_NOINLINE __declspec(noinline)
+# define LAZY_COLD
+#else
+# define LAZY_NOINLINE
+# define LAZY_COLD
+#endif
+/// \def LAZY_CONSTINIT
+///
+/// \brief Requires a variable at namespace scope to be constant-initialized
+///
+/// This expands to \c constinit when it is available, or to an equivalent
+/// attribute where one exists, and otherwise to nothing. A \c Lazy marked
+/// with this is guaranteed not to add a dynamic initializer:
+///
+/// \code
+/// LAZY_CONSTINIT lazy::Lazy<Config> g_config;
+/// \endcode
+#ifndef LAZY_CONSTINIT
+# if defined(__cpp_constinit)
+#  define LAZY_CONSTINIT constinit
+# elif defined(__has_cpp_attribute)
+#  if __has_cpp_attribute(clang::require_constant_initialization)
+#   define LAZY_CONSTINIT [[clang::require_constant_initialization]]
+#  endif
+# endif
+#endif
+#ifndef LAZY_CONSTINIT
+# define LAZY_CONSTINIT
+#endif
+/// \def LAZY_NO_UNIQUE_ADDRESS
+///
+/// \brief Allows an empty data member to share the address of another
+///        member, so that it takes no space
+///
+/// This expands to \c [[no_unique_address]] under C++20, and otherwise to
+/// nothing.
+#ifndef LAZY_NO_UNIQUE_ADDRESS
+# if __cplusplus > 201703L && defined(__has_cpp_attribute)
+#  if __has_cpp_attribute(no_unique_address)
+#   define LAZY_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#  endif
+# endif
+#endif
+#ifndef LAZY_NO_UNIQUE_ADDRESS
+# define LAZY_NO_UNIQUE_ADDRESS
+#endif
+/// \def LAZY_HAS_COROUTINES
+///
+/// \brief Defined to \c 1 if C++20 coroutines are available, so that
+///        \c co_await may be used on an \c AsyncLazy, and to \c 0 otherwise
+#ifndef LAZY_HAS_COROUTINES
+# if defined(__cpp_impl_coroutine) && defined(__has_include)
+#  if __has_include(<coroutine>)
+#   define LAZY_HAS_COROUTINES 1
+#  endif
+# endif
+#endif
+#ifndef LAZY_HAS_COROUTINES
+# define LAZY_HAS_COROUTINES 0
+#endif
 #include <type_traits>
-#include <functional>
 #include <tuple>
 #include <cstdlib>
+#include <utility>
+#include <new>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+/// \def LAZY_ATOMIC_WAIT_STD
+///
+/// \brief Whether threads are parked with \c std::atomic::wait
+///
+/// \def LAZY_ATOMIC_WAIT_FUTEX
+///
+/// \brief Whether threads are parked with a Linux futex
+///
+/// When neither is available, parked threads yield in a loop instead.
+#ifndef LAZY_ATOMIC_WAIT_STD
+# if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+#  define LAZY_ATOMIC_WAIT_STD 1
+# else
+#  define LAZY_ATOMIC_WAIT_STD 0
+# endif
+#endif
+#ifndef LAZY_ATOMIC_WAIT_FUTEX
+# if !LAZY_ATOMIC_WAIT_STD && defined(__linux__)
+#  define LAZY_ATOMIC_WAIT_FUTEX 1
+# else
+#  define LAZY_ATOMIC_WAIT_FUTEX 0
+# endif
+#endif
+#if LAZY_ATOMIC_WAIT_FUTEX
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# include <climits>
+#endif
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+# include <intrin.h>
+#endif
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <cassert>
 
 namespace lazy{
 
+
   namespace detail{
 
     // c++14 index sequence
@@ -83,6 +256,10 @@ namespace lazy{
     template<bool b>
     using boolean_constant = std::integral_constant<bool,b>;
 
+    /// \brief Type alias to remove references and cv-qualifiers from \c T
+    template<typename T>
+    using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>::type>::type;
+
     /// \brief Type-trait for identities (always defines \c T as \c type)
     ///
     /// This aliases \c T as \c ::type
@@ -264,7 +441,7 @@ namespace lazy{
     struct is_tuple_constructible<T,std::pair<Args...>> : public std::is_constructible<T,Args...>{};
 
     /// \brief Type trait to determine whether or not the type \c T is
-    ///        a callable (function, member function, functor)
+    ///        a callable (function, function pointer, member function, functor)
     ///
     /// The result is aliased as \c ::type
     template<typename T>
@@ -274,449 +451,3155 @@ namespace lazy{
       typename std::conditional<
         std::is_member_function_pointer<T>::value,
         std::is_member_function_pointer<T>,
-        std::is_function<T>
+        std::is_function<typename std::remove_pointer<T>::type>
       >::type
     >::type{};
 
-  } // namespace detail
-
-  ////////////////////////////////////////////////////////////////////////////
-  /// \brief Lazy class used for lazy-loading any type
-  ///
-  /// The stored lazy-loaded class, \c T, will always be instantiated
-  /// before being accessed, and destructed when put out of scope.
-  ///
-  /// \tparam T the type contained within this \c Lazy
-  ////////////////////////////////////////////////////////////////////////////
-  template<typename T>
-  class Lazy final
-  {
-    //------------------------------------------------------------------------
-    // Public Member Types
-    //------------------------------------------------------------------------
-  public:
-
-    using this_type = Lazy<T>; ///< Instance of this type
-
-    using value_type = T;  ///< The underlying type of this Lazy
-    using pointer    = T*; ///< The pointer type of the Lazy
-    using reference  = T&; ///< The reference type of the Lazy
-
-    //------------------------------------------------------------------------
-    // Construction / Destruction / Assignment
     //------------------------------------------------------------------------
-  public:
-
-    /// \brief Default constructor; no initialization takes place
-    Lazy( );
 
-    /// \brief Constructs a \c Lazy given the \p constructor and \p destructor
-    ///        functions
-    ///
-    /// \note The \p constructor function must return a \c std::tuple containing
-    ///       the arguments to pass to \c T's constructor for lazy-construction
+    /// \brief Type trait to determine whether the type \c T can be stored
+    ///        through the empty-base optimization
     ///
-    /// \param constructor function to use for construction
-    /// \param destructor  function to use prior to destruction
-    template<
-      typename CtorFunc,
-      typename DtorFunc = void(value_type&),
-      typename = typename std::enable_if<detail::is_callable<CtorFunc>::value>::type,
-      typename = typename std::enable_if<detail::is_callable<DtorFunc>::value>::type
-    >
-    explicit Lazy( const CtorFunc& constructor,
-                   const DtorFunc& destructor = default_destructor );
+    /// The result is aliased as \c ::value
+    template<typename T>
+    struct is_ebo_candidate : boolean_constant<
+      std::is_class<T>::value && std::is_empty<T>::value && !__is_final(T)
+    >{};
 
-    /// \brief Constructs a \c Lazy by copying another \c Lazy
-    ///
-    /// \note If \p rhs is initialized, then this copy will also be initialized
-    ///
-    /// \param rhs the \c Lazy to copy
-    Lazy( const Lazy<T>& rhs );
+  } // namespace detail
 
-    /// \brief Constructs a \c Lazy by moving another \c Lazy
-    ///
-    /// \note If \p rhs is initialized, then this moved version will
-    ///       also be initialized
-    ///
-    /// \param rhs the \c Lazy to move
-    Lazy( Lazy<T>&& rhs );
+  namespace detail{
 
-    /// \brief Constructs a \c Lazy by calling \c T's copy constructor
+    /// \brief Storage for a single member of a \c compressed_pair
     ///
-    /// \note This does not initialize the \c Lazy. Instead, it stores this value as
-    ///       a copy and move-constructs it later, if necessary
-    ///
-    /// \param rhs the \c T to copy
-    explicit Lazy( const value_type& rhs );
-
-    /// \brief Constructs a \c Lazy from a given rvalue \c T
+    /// Empty, non-final class types are inherited from so that they occupy
+    /// no storage; everything else is stored as a regular member.
     ///
-    /// \note This does not initialize the \c Lazy. Instead, it stores this value as
-    ///       a copy and move-constructs it later, if necessary
+    /// \tparam T     the type being stored
+    /// \tparam Index the index of the member in the pair (to allow two
+    ///               members of the same type)
     ///
-    /// \param rhs the \c T to move
-    explicit Lazy( value_type&& rhs );
-
-    //------------------------------------------------------------------------
+    /// \note \c static_cast is used in place of \c std::forward, which is not
+    ///       \c constexpr until C++14
+    template<typename T, std::size_t Index, bool = is_ebo_candidate<T>::value>
+    class ebo_storage
+    {
+    public:
 
-    /// \brief Destructs this \c Lazy and it's \c T
-    ~Lazy( );
+      constexpr ebo_storage() : m_value(){}
 
-    //------------------------------------------------------------------------
+      template<typename U>
+      constexpr explicit ebo_storage( U&& value ) : m_value(static_cast<U&&>(value)){}
 
-    /// \brief Assigns a \c Lazy to this \c Lazy
-    ///
-    /// \note This will construct a new \c T if the \c Lazy is not already
-    ///       initialized, otherwise it will assign
-    ///
-    /// \param rhs the \c Lazy on the right-side of the assignment
-    /// \return reference to (*this)
-    this_type& operator=( const this_type& rhs );
+      T& get() noexcept{ return m_value; }
+      const T& get() const noexcept{ return m_value; }
 
-    /// \brief Assigns a \c Lazy to this \c Lazy
-    ///
-    /// \note This will construct a new \c T if the \c Lazy is not already
-    ///       initialized, otherwise it will assign
-    ///
-    /// \param rhs the rvalue \c Lazy on the right-side of the assignment
-    /// \return reference to (*this)
-    this_type& operator=( this_type&& rhs );
+    private:
 
-    /// \brief Assigns a \c T to this \c Lazy
-    ///
-    /// \note This will construct a new \c T if the \c Lazy is not already
-    ///       initialized, otherwise it will assign
-    ///
-    /// \param rhs the \c T on the right-side of the assignment
-    /// \return reference to (\c ptr())
-    value_type& operator=( const value_type& rhs );
+      T m_value;
+    };
 
-    /// \brief Assigns an rvalue \c T to this \c Lazy
-    ///
-    /// \note This will construct a new \c T if the \c Lazy is not already
-    ///       initialized, otherwise it will assign
-    ///
-    /// \param rhs the \c T on the right-side of the assignment
-    /// \return reference to (\c ptr())
-    value_type& operator=( value_type&& rhs );
+    template<typename T, std::size_t Index>
+    class ebo_storage<T,Index,true> : private T
+    {
+    public:
 
-    //------------------------------------------------------------------------
-    // Casting
-    //------------------------------------------------------------------------
-  public:
+      constexpr ebo_storage() : T(){}
 
-    /// \brief Converts this \c Lazy into a reference
-    ///
-    /// \return the reference to the lazy-loaded object
-    explicit operator reference() const;
+      template<typename U>
+      constexpr explicit ebo_storage( U&& value ) : T(static_cast<U&&>(value)){}
 
-    /// \brief Checks whether this \c Lazy has an instantiated object
-    ///
-    /// \return \c true if this lazy has an instantiated object
-    explicit operator bool() const noexcept;
+      T& get() noexcept{ return *this; }
+      const T& get() const noexcept{ return *this; }
+    };
 
     //------------------------------------------------------------------------
-    // Operators
-    //------------------------------------------------------------------------
-  public:
-
-    /// \brief Swapperator class for no-exception swapping
-    ///
-    /// \param rhs the rhs to swap
-    void swap(Lazy<T>& rhs) noexcept;
-
-    /// \brief Boolean to check if this \c Lazy is initialized.
-    ///
-    /// \return \c true if the underlying type \c T is initialized.
-    bool is_initialized() const noexcept;
 
-    /// \brief Gets a pointer to the underlying type
-    ///
-    /// \note This has been added to have a similar API to smart pointers
+    /// \brief A pair that takes no storage for empty member types
     ///
-    /// \return the pointer to the underlying type
-    pointer get() const;
-
-    /// \brief Dereferences this \c Lazy object into the lazy-loaded object
+    /// This is used to store the construction and destruction functions of
+    /// a \c BasicLazy so that stateless functors (such as captureless
+    /// lambdas) don't contribute to the size of the \c BasicLazy.
     ///
-    /// \return a constant reference to the lazy-loaded object
-    reference operator*() const;
+    /// \tparam T0 the first type
+    /// \tparam T1 the second type
+    template<typename T0, typename T1>
+    class compressed_pair : private ebo_storage<T0,0>,
+                            private ebo_storage<T1,1>
+    {
+      using first_base  = ebo_storage<T0,0>;
+      using second_base = ebo_storage<T1,1>;
 
-    /// \brief Dereferences this \c Lazy object into the lazy-loaded object
-    ///
-    /// \return a pointer to the lazy-loaded object
-    pointer operator->() const;
+    public:
 
-    //------------------------------------------------------------------------
-    // Private Member Types
-    //------------------------------------------------------------------------
-  private:
+      constexpr compressed_pair() : first_base(), second_base(){}
 
-    /// \brief Constructor tag for tag-dispatching VA Arguments
-    struct ctor_va_args_tag{};
+      template<typename U0, typename U1>
+      constexpr compressed_pair( U0&& first, U1&& second )
+        : first_base(static_cast<U0&&>(first)),
+          second_base(static_cast<U1&&>(second))
+      {
 
-    using unqualified_pointer = typename std::remove_cv<T>::type*;
-    using ctor_function_type  = std::function<void()>;
-    using dtor_function_type  = std::function<void(T&)>;
+      }
 
-    using storage_type = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+      T0& first() noexcept{ return first_base::get(); }
+      const T0& first() const noexcept{ return first_base::get(); }
 
-    //------------------------------------------------------------------------
-    // Private Members
-    //------------------------------------------------------------------------
-  private:
+      T1& second() noexcept{ return second_base::get(); }
+      const T1& second() const noexcept{ return second_base::get(); }
+    };
 
-    mutable storage_type m_storage;        ///< The storage to hold the lazy type
-    mutable bool         m_is_initialized; ///< Is the type initialized?
-    ctor_function_type   m_constructor;    ///< The construction function
-    dtor_function_type   m_destructor;     ///< The destruction function
+  } // namespace detail
 
-    //------------------------------------------------------------------------
-    // Private Static Member Functions
-    //------------------------------------------------------------------------
-  private:
+  namespace detail{
 
-    /// \brief A default destructor function for this Lazy object
+    /// \brief Storage for a type-erased function object
     ///
-    /// \param x the \c T type to be destructed
-    static void default_destructor( value_type& x ) noexcept;
+    /// Function objects are stored inline in \c data when they fit, and are
+    /// otherwise allocated and referenced by \c heap. The buffer is always
+    /// large enough to hold a pointer.
+    ///
+    /// \tparam Size the number of bytes to reserve for inline storage
+    template<std::size_t Size>
+    union function_buffer
+    {
+      static constexpr std::size_t size = (Size < sizeof(void*)) ? sizeof(void*) : Size;
+
+      void* heap; ///< The allocated function, if not stored inline
+      typename std::aligned_storage<size,alignof(void*)>::type data; ///< The inline storage
+    };
 
     //------------------------------------------------------------------------
-    // Private Constructor
-    //------------------------------------------------------------------------
-  private:
 
-    /// \brief Constructs a \c Lazy by constructing it's \c T with its constructor
+    /// \brief Type trait to determine whether the function object \c F may be
+    ///        stored inline in a \c function_buffer<Size>
     ///
-    /// \param tag  unused tag for dispatching to VA constructor
-    /// \param args arguments to \c T's constructor
-    template<typename...Args>
-    explicit Lazy( ctor_va_args_tag tag, Args&&...args );
+    /// The result is aliased as \c ::value
+    template<typename F, std::size_t Size>
+    struct is_inline_storable : boolean_constant<
+      sizeof(F) <= function_buffer<Size>::size &&
+      alignof(F) <= alignof(function_buffer<Size>) &&
+      std::is_nothrow_move_constructible<F>::value
+    >{};
 
     //------------------------------------------------------------------------
-    // Private Member Functions
-    //------------------------------------------------------------------------
-  private:
 
-    /// \brief Gets a pointer to the data stored in this \c Laz
+    /// \brief Operations for managing a function object of type \c F stored
+    ///        in a \c function_buffer<Size>
     ///
-    /// \return the constant pointer to the object
-    unqualified_pointer ptr() const noexcept;
-
-    /// \brief Forcibly initializes the \c Lazy
-    void lazy_construct() const;
-
-    /// \brief Constructs a \c Lazy object using \c T's copy constructor
+    /// This primary template manages function objects stored inline
     ///
-    /// \param x Instance of \c T to copy.
-    void construct( const value_type& x ) const;
+    /// \tparam F    the type of the function object
+    /// \tparam Size the size of the buffer
+    template<typename F, std::size_t Size, bool = is_inline_storable<F,Size>::value>
+    struct function_storage
+    {
+      using buffer_type = function_buffer<Size>;
 
-    /// \brief Constructs a \c Lazy object using \c T's move constructor
-    ///
-    /// \param x Instance of rvalue \c T to copy
-    void construct( value_type&& x ) const;
+      /// \brief Retrieves the function object stored in \p buffer
+      static F& get( buffer_type& buffer ) noexcept
+      {
+        return *static_cast<F*>(static_cast<void*>(&buffer.data));
+      }
 
-    /// \brief Constructs a \c Lazy object using the arguments for \c T's constructor
-    ///
-    /// \param tag  tag to dispatch to this VA args constructor
-    /// \param args the arguments to forward to the constructor
-    template<typename...Args>
-    void construct( ctor_va_args_tag tag, Args&&...args ) const;
+      /// \brief Retrieves the function object stored in \p buffer
+      static const F& get( const buffer_type& buffer ) noexcept
+      {
+        return *static_cast<const F*>(static_cast<const void*>(&buffer.data));
+      }
 
-    /// \brief Constructs a \c Lazy object using the arguments provided in a
-    ///        \c std::tuple for \c T's constructor
-    ///
-    /// \param tag  the tag for tag-dispatching
-    /// \param args the arguments to forward to the constructor
-    template<typename...Args>
-    void construct( const std::tuple<Args...>& args ) const;
+      /// \brief Constructs the function object in \p buffer from \p args
+      template<typename...Args>
+      static void create( buffer_type& buffer, Args&&...args )
+      {
+        new (&buffer.data) F( std::forward<Args>(args)... );
+      }
 
-    /// \brief Constructs a \c lazy object by passing all values stored in a
-    ///        \c std::tuple to \c T's constructor
-    ///
-    /// \param unused unused parameter for getting index list
-    template<typename...Args, std::size_t...Is>
-    void tuple_construct( const std::tuple<Args...>& args,
-                          const detail::index_sequence<Is...>& unused ) const noexcept( std::is_nothrow_constructible<T,Args...>::value );
+      /// \brief Copies the function object in \p source into \p destination
+      static void copy( const buffer_type& source, buffer_type& destination )
+      {
+        create( destination, get(source) );
+      }
 
-    //------------------------------------------------------------------------
+      /// \brief Moves the function object in \p source into \p destination,
+      ///        leaving \p source empty
+      static void move( buffer_type& source, buffer_type& destination ) noexcept
+      {
+        create( destination, std::move(get(source)) );
+        destroy( source );
+      }
 
-    /// \brief Destructs the \c Lazy object
-    void destruct( ) const;
+      /// \brief Destroys the function object in \p buffer
+      static void destroy( buffer_type& buffer ) noexcept
+      {
+        get(buffer).~F();
+      }
+    };
 
-    //------------------------------------------------------------------------
+    /// \brief Operations for managing a function object of type \c F that is
+    ///        too large to store inline in a \c function_buffer<Size>
+    template<typename F, std::size_t Size>
+    struct function_storage<F,Size,false>
+    {
+      using buffer_type = function_buffer<Size>;
 
-    /// \brief Copy-assigns type at \c rhs
-    ///
-    /// \param rhs the value to assign
-    void assign( const value_type& rhs ) const noexcept( std::is_nothrow_copy_assignable<T>::value );
+      static F& get( buffer_type& buffer ) noexcept
+      {
+        return *static_cast<F*>(buffer.heap);
+      }
 
-    /// \brief Copy-assigns type at \c rhs
-    ///
-    /// \param rhs the value to assign
-    void assign( value_type&& rhs ) const noexcept( std::is_nothrow_move_assignable<T>::value );
+      static const F& get( const buffer_type& buffer ) noexcept
+      {
+        return *static_cast<const F*>(buffer.heap);
+      }
 
-    //------------------------------------------------------------------------
-    // Friends
-    //------------------------------------------------------------------------
+      template<typename...Args>
+      static void create( buffer_type& buffer, Args&&...args )
+      {
+        static_assert(LAZY_HEAP_FALLBACK_ENABLED || is_inline_storable<F,Size>::value,
+                      "Construction function does not fit in the inline buffer, and LAZY_NO_HEAP_FALLBACK is defined");
 
-    template<typename U,typename...Args>
-    friend Lazy<U> make_lazy( Args&&...args );
-  };
+        buffer.heap = new F( std::forward<Args>(args)... );
+      }
 
-  //--------------------------------------------------------------------------
-  // Utilities
-  //--------------------------------------------------------------------------
+      static void copy( const buffer_type& source, buffer_type& destination )
+      {
+        create( destination, get(source) );
+      }
 
-  /// \brief Convenience utility to construct a \c Lazy object by specifying
-  ///        \c T's constructor signature.
-  ///
-  /// The arguments are stored by copy until the object is constructed in order
-  /// to avoid dangling references.
-  ///
-  /// \param args the arguments to the constructor
-  /// \return an instance of the \c Lazy object
-  template<typename T, typename...Args>
-  Lazy<T> make_lazy( Args&&...args );
+      static void move( buffer_type& source, buffer_type& destination ) noexcept
+      {
+        destination.heap = source.heap;
+        source.heap = nullptr;
+      }
 
-  /// \brief Implementation of \c swap for custom swapperations using ADL
-  ///
-  /// \param lhs the left-hand \c Lazy object
-  /// \param rhs the right-hand \c Lazy object
-  template<typename T>
-  void swap(Lazy<T>& lhs, Lazy<T>& rhs) noexcept;
+      static void destroy( buffer_type& buffer ) noexcept
+      {
+        delete static_cast<F*>(buffer.heap);
+      }
+    };
 
+  } // namespace detail
 
-  //--------------------------------------------------------------------------
-  // Constructors / Destructor / Assignment
-  //--------------------------------------------------------------------------
+  template<typename T> struct default_destructor;
 
-  template<typename T>
-  inline Lazy<T>::Lazy()
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor([this](){this->construct(ctor_va_args_tag());}),
-      m_destructor(default_destructor)
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief Exception thrown when copying a \c Lazy whose construction
+  ///        function can't be copied
+  ///
+  /// This happens when copying a \c Lazy that was created by \c make_lazy
+  /// with move-only arguments, before it has been initialized
+  ////////////////////////////////////////////////////////////////////////////
+  class bad_lazy_copy : public std::logic_error
   {
-    static_assert(std::is_default_constructible<T>::value,"No matching default constructor for type T");
-  }
+  public:
 
-  template<typename T>
-  template<typename CtorFunc,typename DtorFunc,typename,typename>
-  inline Lazy<T>::Lazy( const CtorFunc& constructor,
-                        const DtorFunc& destructor )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor([this,constructor](){this->construct(constructor());}),
-      m_destructor(destructor)
-  {
-    using return_type = typename detail::function_traits<CtorFunc>::result_type;
+    bad_lazy_copy()
+      : std::logic_error("lazy: construction function is not copyable")
+    {
 
-    static_assert(detail::is_tuple<return_type>::value,"Lazy-construction functions must return tuples containing constructor arguments");
-    static_assert(detail::is_tuple_constructible<T,return_type>::value, "No matching constructor for type T with given arguments");
-  }
+    }
+  };
 
-  template<typename T>
-  inline Lazy<T>::Lazy( const this_type& rhs )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor(rhs.m_constructor),
-      m_destructor(rhs.m_destructor)
-  {
-    static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
+  namespace detail{
 
-    if(rhs.m_is_initialized)
-    {
-      construct(*rhs);
-    }
-  }
+    /// \brief Constructor tag for tag-dispatching VA Arguments
+    struct ctor_va_args_tag{};
 
-  template<typename T>
-  inline Lazy<T>::Lazy( this_type&& rhs )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor(std::move(rhs.m_constructor)),
-      m_destructor(std::move(rhs.m_destructor))
-  {
-    static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
+    //------------------------------------------------------------------------
 
-    if(rhs.m_is_initialized)
+    /// \brief Constructs a \c T at the address \p where by passing all
+    ///        values stored in a \c std::tuple to \c T's constructor
+    ///
+    /// \param where  the address to construct the \c T at
+    /// \param args   the tuple of arguments
+    /// \param unused unused parameter for getting index list
+    template<typename T, typename Tuple, std::size_t...Is>
+    inline void tuple_construct( void* where, Tuple&& args,
+                                 const index_sequence<Is...>& )
     {
-      construct(std::move(*rhs));
+      new (where) T( std::get<Is>(std::forward<Tuple>(args))... );
     }
-    rhs.m_constructor = nullptr;
-    rhs.m_destructor = nullptr;
-  }
 
-  template<typename T>
-  inline Lazy<T>::Lazy( const value_type& rhs )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor([this,rhs](){this->construct(std::move(rhs));}),
-      m_destructor(default_destructor)
-  {
-    static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
+    /// \brief Constructs a \c T at the address \p where by invoking the
+    ///        tuple-returning function \p constructor
+    ///
+    /// \param where       the address to construct the \c T at
+    /// \param constructor the function returning the constructor arguments
+    template<typename T, typename CtorFunc>
+    inline void construct_from_function( void* where, CtorFunc& constructor )
+    {
+      using return_type = remove_cvref_t<decltype(constructor())>;
+
+      static_assert(is_tuple<return_type>::value,"Lazy-construction functions must return tuples containing constructor arguments");
+      static_assert(is_tuple_constructible<T,return_type>::value, "No matching constructor for type T with given arguments");
+
+      tuple_construct<T>( where, constructor(),
+                          make_index_sequence<std::tuple_size<return_type>::value>() );
+    }
+
+    //------------------------------------------------------------------------
+
+    /// \brief A construction function that default-constructs a \c T
+    template<typename T>
+    struct default_construct_function
+    {
+      void operator()( void* where ) const
+      {
+        new (where) T();
+      }
+    };
+
+    /// \brief A construction function that constructs a \c T with the
+    ///        arguments returned from a tuple-returning function
+    template<typename T, typename CtorFunc>
+    struct tuple_construct_function
+    {
+      CtorFunc constructor;
+
+      void operator()( void* where )
+      {
+        construct_from_function<T>( where, constructor );
+      }
+    };
+
+    /// \brief A construction function that constructs a \c T from a stored
+    ///        copy of a \c T
+    ///
+    /// The stored copy is only moved from by \c consume, and only if \c T's
+    /// move constructor does not throw, since the function is released after
+    /// that construction. A move-only \c T is always moved from.
+    template<typename T>
+    struct value_construct_function
+    {
+      typename std::remove_cv<T>::type value;
+
+      void operator()( void* where )
+      {
+        construct( where, std::is_copy_constructible<T>() );
+      }
+
+      void consume( void* where )
+      {
+        new (where) T( std::move_if_noexcept(value) );
+      }
+
+    private:
+
+      void construct( void* where, std::true_type )
+      {
+        new (where) T( static_cast<const T&>(value) );
+      }
+
+      void construct( void* where, std::false_type )
+      {
+        new (where) T( std::move(value) );
+      }
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief A copy of an array argument
+    ///
+    /// Unlike a raw array, this can be stored in a \c std::tuple
+    template<typename T, std::size_t N>
+    struct array_argument
+    {
+      T value[N];
+
+      array_argument( const T (&array)[N] )
+      {
+        std::copy( array, array + N, value );
+      }
+    };
+
+    /// \brief The type used to store an argument of type \c Arg until
+    ///        construction
+    template<typename Arg, typename U = typename std::remove_reference<Arg>::type>
+    struct stored_argument
+    {
+      using type = typename std::decay<Arg>::type;
+    };
+
+    template<typename Arg, typename T, std::size_t N>
+    struct stored_argument<Arg,T[N]>
+    {
+      using type = array_argument<typename std::remove_cv<T>::type,N>;
+    };
+
+    /// \brief Passes a stored argument on to the constructor, copying it
+    ///
+    /// \param argument the stored argument
+    template<typename Arg>
+    inline const Arg& unwrap_argument( const Arg& argument )
+    {
+      return argument;
+    }
+
+    /// \brief Passes a stored array argument on to the constructor
+    ///
+    /// \param argument the stored array argument
+    template<typename T, std::size_t N>
+    inline const T (&unwrap_argument( const array_argument<T,N>& argument ))[N]
+    {
+      return argument.value;
+    }
+
+    /// \brief Passes a stored argument on to the constructor, moving it
+    ///
+    /// \param argument the stored argument
+    template<typename Arg>
+    inline Arg&& move_argument( Arg& argument )
+    {
+      return std::move(argument);
+    }
+
+    /// \brief Passes a stored array argument on to the constructor
+    ///
+    /// \param argument the stored array argument
+    template<typename T, std::size_t N>
+    inline const T (&move_argument( array_argument<T,N>& argument ))[N]
+    {
+      return argument.value;
+    }
+
+    /// \brief The type a stored argument of type \c Arg is passed on to the
+    ///        constructor as when it is copied
+    template<typename Arg>
+    using copied_argument_t = decltype(unwrap_argument(std::declval<const Arg&>()));
+
+    /// \brief The type a stored argument of type \c Arg is passed on to the
+    ///        constructor as when it is moved
+    template<typename Arg>
+    using moved_argument_t = decltype(move_argument(std::declval<Arg&>()));
+
+    /// \brief A construction function that constructs a \c T from stored
+    ///        arguments
+    ///
+    /// The arguments are moved into \c T's constructor by \c consume, since
+    /// the function is released after that construction, so each argument
+    /// is only ever copied or moved once into storage, and once into the
+    /// \c T. Otherwise they are copied, unless they can only be moved.
+    ///
+    /// \note If \c T's constructor throws, the arguments it has moved from
+    ///       stay moved-from for the next attempt
+    template<typename T, typename...Args>
+    struct arguments_construct_function
+    {
+      /// Whether T can be constructed from copies of the arguments
+      using is_copyable = std::is_constructible<T,copied_argument_t<Args>...>;
+
+      std::tuple<Args...> arguments;
+
+      template<typename...UArgs>
+      explicit arguments_construct_function( ctor_va_args_tag, UArgs&&...args )
+        : arguments(std::forward<UArgs>(args)...)
+      {
+
+      }
+
+      void operator()( void* where )
+      {
+        construct( where, is_copyable() );
+      }
+
+      void consume( void* where )
+      {
+        move_construct( where, make_index_sequence<sizeof...(Args)>() );
+      }
+
+    private:
+
+      void construct( void* where, std::true_type )
+      {
+        copy_construct( where, make_index_sequence<sizeof...(Args)>() );
+      }
+
+      void construct( void* where, std::false_type )
+      {
+        move_construct( where, make_index_sequence<sizeof...(Args)>() );
+      }
+
+      template<std::size_t...Is>
+      void copy_construct( void* where, const index_sequence<Is...>& )
+      {
+        const auto& args = arguments;
+
+        new (where) T( unwrap_argument(std::get<Is>(args))... );
+      }
+
+      template<std::size_t...Is>
+      void move_construct( void* where, const index_sequence<Is...>& )
+      {
+        new (where) T( move_argument(std::get<Is>(arguments))... );
+      }
+    };
+
+    /// \brief The construction function left behind once an
+    ///        \c erased_function has been released
+    struct released_construct_function
+    {
+      void operator()( void* ) const
+      {
+        throw std::bad_function_call();
+      }
+    };
+
+    /// \brief Constructs a \c T at the address \p where with the
+    ///        construction function \p function, which is released
+    ///        afterwards, and so may give up its state to the \c T
+    ///
+    /// \param function the construction function
+    /// \param where    the address to construct the \c T at
+    template<typename CtorFunc>
+    inline auto consume_construct( CtorFunc& function, void* where, int )
+      -> decltype(function.consume(where))
+    {
+      function.consume(where);
+    }
+
+    template<typename CtorFunc>
+    inline void consume_construct( CtorFunc& function, void* where, long )
+    {
+      function(where);
+    }
+
+    //------------------------------------------------------------------------
+
+    /// \brief The table of operations for the state stored in an
+    ///        \c erased_function<T,InlineBytes>
+    template<typename T, std::size_t InlineBytes>
+    struct erased_vtable
+    {
+      using buffer_type = function_buffer<InlineBytes>;
+
+      void (*construct)( buffer_type&, void* );
+      const erased_vtable* (*consume)( buffer_type&, void* );
+      void (*destruct)( buffer_type&, T& );
+      const erased_vtable* (*release)( buffer_type& );
+      void (*copy)( const buffer_type&, buffer_type& );
+      void (*move)( buffer_type&, buffer_type& );
+      void (*destroy)( buffer_type& );
+      bool is_allocated;
+      std::size_t size;
+    };
+
+    /// \brief The operations for an \c erased_function storing the
+    ///        construction function \c CtorFunc and destruction function
+    ///        \c DtorFunc together as a single \c compressed_pair
+    ///
+    /// \tparam T           the type being constructed
+    /// \tparam InlineBytes the size of the buffer
+    /// \tparam CtorFunc    the type of the construction function
+    /// \tparam DtorFunc    the type of the destruction function
+    template<typename T, std::size_t InlineBytes, typename CtorFunc, typename DtorFunc>
+    struct erased_operations
+    {
+      using state_type    = compressed_pair<CtorFunc,DtorFunc>;
+      using storage_type  = function_storage<state_type,InlineBytes>;
+      using buffer_type   = function_buffer<InlineBytes>;
+      using vtable_type   = erased_vtable<T,InlineBytes>;
+      using released_type = erased_operations<T,InlineBytes,released_construct_function,DtorFunc>;
+
+      /// \brief Whether the construction function may be released without
+      ///        allocating
+      using is_releasable = boolean_constant<
+        !std::is_same<CtorFunc,released_construct_function>::value &&
+        is_inline_storable<typename released_type::state_type,InlineBytes>::value
+      >;
+
+      static const vtable_type value;
+
+      static void construct( buffer_type& buffer, void* where )
+      {
+        storage_type::get(buffer).first()( where );
+      }
+
+      static const vtable_type* consume( buffer_type& buffer, void* where )
+      {
+        return consume( buffer, where, is_releasable() );
+      }
+
+      static const vtable_type* consume( buffer_type& buffer, void* where, std::true_type )
+      {
+        consume_construct( storage_type::get(buffer).first(), where, 0 );
+        return release( buffer, std::true_type() );
+      }
+
+      // The function is kept, so its state must be kept intact as well
+      static const vtable_type* consume( buffer_type& buffer, void* where, std::false_type )
+      {
+        construct( buffer, where );
+        return &value;
+      }
+
+      static void destruct( buffer_type& buffer, T& x )
+      {
+        storage_type::get(buffer).second()( x );
+      }
+
+      static const vtable_type* release( buffer_type& buffer )
+      {
+        return release( buffer, is_releasable() );
+      }
+
+      static const vtable_type* release( buffer_type& buffer, std::true_type )
+      {
+        DtorFunc destructor( std::move(storage_type::get(buffer).second()) );
+
+        storage_type::destroy( buffer );
+        released_type::storage_type::create( buffer, released_construct_function(), std::move(destructor) );
+        return &released_type::value;
+      }
+
+      static const vtable_type* release( buffer_type&, std::false_type )
+      {
+        return &value;
+      }
+
+      static void copy( const buffer_type& source, buffer_type& destination )
+      {
+        copy( source, destination, std::is_copy_constructible<state_type>() );
+      }
+
+      static void copy( const buffer_type& source, buffer_type& destination, std::true_type )
+      {
+        storage_type::copy( source, destination );
+      }
+
+      static void copy( const buffer_type&, buffer_type&, std::false_type )
+      {
+        throw bad_lazy_copy();
+      }
+    };
+
+    template<typename T, std::size_t InlineBytes, typename CtorFunc, typename DtorFunc>
+    const erased_vtable<T,InlineBytes> erased_operations<T,InlineBytes,CtorFunc,DtorFunc>::value = {
+      static_cast<void(*)(buffer_type&,void*)>(&erased_operations::construct),
+      static_cast<const vtable_type*(*)(buffer_type&,void*)>(&erased_operations::consume),
+      &erased_operations::destruct,
+      static_cast<const vtable_type*(*)(buffer_type&)>(&erased_operations::release),
+      static_cast<void(*)(const buffer_type&,buffer_type&)>(&erased_operations::copy),
+      &storage_type::move,
+      &storage_type::destroy,
+      !is_inline_storable<state_type,InlineBytes>::value,
+      std::is_empty<state_type>::value ? 0 : sizeof(state_type)
+    };
+
+    /// \brief The operations for an \c erased_function that default-constructs
+    ///        the \c T, and does nothing prior to destruction
+    ///
+    /// Nothing is stored in the buffer for these operations, which allows a
+    /// default-constructed \c erased_function to be constant-initialized.
+    ///
+    /// \tparam T           the type being constructed
+    /// \tparam InlineBytes the size of the buffer
+    template<typename T, std::size_t InlineBytes>
+    struct default_operations
+    {
+      using buffer_type = function_buffer<InlineBytes>;
+      using vtable_type = erased_vtable<T,InlineBytes>;
+
+      static const vtable_type value;
+
+      static void construct( buffer_type&, void* where )
+      {
+        new (where) T();
+      }
+
+      static const vtable_type* consume( buffer_type& buffer, void* where )
+      {
+        construct( buffer, where );
+        return &value;
+      }
+
+      static void destruct( buffer_type&, T& ){}
+
+      // There is no state to release, so the operations are kept as-is
+      static const vtable_type* release( buffer_type& ){ return &value; }
+
+      static void copy( const buffer_type&, buffer_type& ){}
+      static void move( buffer_type&, buffer_type& ){}
+      static void destroy( buffer_type& ){}
+    };
+
+    template<typename T, std::size_t InlineBytes>
+    const erased_vtable<T,InlineBytes> default_operations<T,InlineBytes>::value = {
+      &default_operations::construct,
+      &default_operations::consume,
+      &default_operations::destruct,
+      &default_operations::release,
+      &default_operations::copy,
+      &default_operations::move,
+      &default_operations::destroy,
+      false,
+      0
+    };
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief A type-erased construction and destruction function for a \c T
+    ///
+    /// Unlike user-supplied construction functions, which return a
+    /// \c std::tuple of arguments, an \c erased_function constructs the
+    /// \c T directly into the storage that it is supplied with. This allows
+    /// construction from values and argument packs to be stored behind the
+    /// same type.
+    ///
+    /// The construction and destruction functions share a single table of
+    /// operations and a single buffer, so that a \c Lazy pays for one
+    /// pointer of bookkeeping rather than one per function. The functions,
+    /// along with any arguments they have captured, are stored in an inline
+    /// buffer of \c InlineBytes bytes. Functions that do not fit are
+    /// allocated on the heap, unless \c LAZY_NO_HEAP_FALLBACK is defined.
+    ///
+    /// \tparam T           the type being constructed
+    /// \tparam InlineBytes the number of bytes to store functions in without
+    ///                     allocating
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename T, std::size_t InlineBytes = LAZY_DEFAULT_INLINE_BYTES>
+    class erased_function
+    {
+    public:
+
+      /// \brief Constructs an \c erased_function that will default-construct
+      ///        the \c T
+      ///
+      /// \note This is \c constexpr, allowing a default-constructed \c Lazy
+      ///       to be constant-initialized
+      constexpr erased_function() noexcept;
+
+      /// \brief Constructs an \c erased_function from a function returning
+      ///        a \c std::tuple of arguments to \c T's constructor
+      ///
+      /// \param constructor the construction function
+      template<
+        typename CtorFunc,
+        typename = typename std::enable_if<is_callable<CtorFunc>::value &&
+                                           !std::is_same<CtorFunc,erased_function>::value>::type
+      >
+      erased_function( const CtorFunc& constructor );
+
+      /// \brief Constructs an \c erased_function from a function returning
+      ///        a \c std::tuple of arguments to \c T's constructor, and a
+      ///        function to invoke prior to destruction
+      ///
+      /// \param constructor the construction function
+      /// \param destructor  the destruction function
+      template<
+        typename CtorFunc,
+        typename DtorFunc,
+        typename = typename std::enable_if<is_callable<CtorFunc>::value &&
+                                           is_callable<DtorFunc>::value>::type
+      >
+      erased_function( const CtorFunc& constructor, const DtorFunc& destructor );
+
+      /// \brief Constructs an \c erased_function that copy-constructs
+      ///        the \c T from \p value
+      ///
+      /// \param value the value to copy
+      explicit erased_function( const T& value );
+
+      /// \brief Constructs an \c erased_function that move-constructs
+      ///        the \c T from \p value
+      ///
+      /// \param value the value to move
+      explicit erased_function( T&& value );
+
+      /// \brief Constructs an \c erased_function that constructs the \c T
+      ///        from \p args
+      ///
+      /// The arguments are copied or moved into this \c erased_function, and
+      /// moved into \c T's constructor by \c consume
+      ///
+      /// \param tag  unused tag for dispatching to VA constructor
+      /// \param args arguments to \c T's constructor
+      template<typename...Args>
+      erased_function( ctor_va_args_tag tag, Args&&...args );
+
+      /// \brief Copy-constructs an \c erased_function
+      ///
+      /// \throw bad_lazy_copy if the stored functions can't be copied
+      ///
+      /// \param rhs the \c erased_function to copy
+      erased_function( const erased_function& rhs );
+
+      /// \brief Move-constructs an \c erased_function
+      ///
+      /// \note \p rhs is left empty
+      ///
+      /// \param rhs the \c erased_function to move
+      erased_function( erased_function&& rhs ) noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Destroys the stored functions
+      ~erased_function();
+
+      //----------------------------------------------------------------------
+
+      /// \brief Copy-assigns an \c erased_function
+      ///
+      /// \param rhs the \c erased_function to copy
+      /// \return reference to (*this)
+      erased_function& operator=( const erased_function& rhs );
+
+      /// \brief Move-assigns an \c erased_function
+      ///
+      /// \note \p rhs is left empty
+      ///
+      /// \param rhs the \c erased_function to move
+      /// \return reference to (*this)
+      erased_function& operator=( erased_function&& rhs ) noexcept;
+
+      //----------------------------------------------------------------------
+
+      /// \brief Constructs the \c T at the address \p where
+      ///
+      /// The stored arguments are copied into the \c T, unless they can only
+      /// be moved, so construction may be repeated.
+      ///
+      /// \throw std::bad_function_call if this \c erased_function is empty,
+      ///        or has been released
+      ///
+      /// \param where the address to construct the \c T at
+      void construct( void* where );
+
+      /// \brief Constructs the \c T at the address \p where, and then
+      ///        releases the construction function as if by \c release
+      ///
+      /// The stored arguments are moved into the \c T, since they are not
+      /// needed again.
+      ///
+      /// \throw std::bad_function_call if this \c erased_function is empty,
+      ///        or has been released
+      ///
+      /// \param where the address to construct the \c T at
+      void consume( void* where );
+
+      /// \brief Invokes the destruction function on \p x
+      ///
+      /// \param x the \c T to be destructed
+      void operator()( T& x );
+
+      /// \brief Destroys the stored construction function, along with any
+      ///        arguments it has captured, keeping only the destruction
+      ///        function
+      ///
+      /// \note The construction function is kept if the destruction
+      ///       function could not be kept inline without allocating
+      void release() noexcept;
+
+      /// \brief Checks whether the stored functions were allocated on the
+      ///        heap
+      ///
+      /// \return \c true if the functions are not stored inline
+      bool is_allocated() const noexcept;
+
+      /// \brief Gets the number of bytes of state retained by the stored
+      ///        functions
+      ///
+      /// \return the size of the stored functions, or \c 0 if stateless
+      std::size_t retained_bytes() const noexcept;
+
+    private:
+
+      using buffer_type = function_buffer<InlineBytes>;
+      using vtable_type = erased_vtable<T,InlineBytes>;
+
+      const vtable_type* m_vtable; ///< The operations for the stored functions
+      buffer_type        m_buffer; ///< The storage of the stored functions
+
+      /// \brief Stores the functions \c CtorFunc and \c DtorFunc constructed
+      ///        from \p constructor and \p destructor
+      ///
+      /// \param constructor the construction function
+      /// \param destructor  the destruction function
+      template<typename CtorFunc, typename DtorFunc, typename Ctor, typename Dtor>
+      void store( Ctor&& constructor, Dtor&& destructor );
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief Type trait to determine whether the construction function
+    ///        \c CtorFunc constructs into supplied storage, rather than
+    ///        returning a \c std::tuple of arguments
+    ///
+    /// The result is aliased as \c ::value
+    template<typename CtorFunc>
+    struct is_storage_constructor : std::false_type{};
+
+    template<typename T, std::size_t InlineBytes>
+    struct is_storage_constructor<erased_function<T,InlineBytes>> : std::true_type{};
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The construction and destruction functions of a \c BasicLazy
+    ///
+    /// This stores both functions in a \c compressed_pair so that stateless
+    /// functions take up no space. If both functions are the same
+    /// \c erased_function, only a single one is stored and serves as both.
+    ///
+    /// \tparam CtorFunc the type of the construction function
+    /// \tparam DtorFunc the type of the destruction function
+    ////////////////////////////////////////////////////////////////////////////
+    template<
+      typename CtorFunc,
+      typename DtorFunc,
+      bool = std::is_same<CtorFunc,DtorFunc>::value && is_storage_constructor<CtorFunc>::value
+    >
+    class function_pair
+    {
+    public:
+
+      constexpr function_pair() : m_pair(){}
+
+      template<
+        typename Ctor,
+        typename = typename std::enable_if<!std::is_same<remove_cvref_t<Ctor>,function_pair>::value>::type
+      >
+      constexpr explicit function_pair( Ctor&& constructor )
+        : m_pair(static_cast<Ctor&&>(constructor),DtorFunc())
+      {
+
+      }
+
+      template<typename Ctor, typename Dtor>
+      constexpr function_pair( Ctor&& constructor, Dtor&& destructor )
+        : m_pair(static_cast<Ctor&&>(constructor),static_cast<Dtor&&>(destructor))
+      {
+
+      }
+
+      CtorFunc& first() noexcept{ return m_pair.first(); }
+      const CtorFunc& first() const noexcept{ return m_pair.first(); }
+
+      DtorFunc& second() noexcept{ return m_pair.second(); }
+      const DtorFunc& second() const noexcept{ return m_pair.second(); }
+
+      void swap( function_pair& rhs ) noexcept
+      {
+        using std::swap; // for ADL
+
+        swap(first(),rhs.first());
+        swap(second(),rhs.second());
+      }
+
+    private:
+
+      LAZY_NO_UNIQUE_ADDRESS compressed_pair<CtorFunc,DtorFunc> m_pair;
+    };
+
+    template<typename Function>
+    class function_pair<Function,Function,true>
+    {
+    public:
+
+      constexpr function_pair() : m_function(){}
+
+      template<
+        typename Ctor,
+        typename = typename std::enable_if<!std::is_same<remove_cvref_t<Ctor>,function_pair>::value>::type
+      >
+      constexpr explicit function_pair( Ctor&& constructor )
+        : m_function(static_cast<Ctor&&>(constructor))
+      {
+
+      }
+
+      template<typename Ctor, typename Dtor>
+      constexpr function_pair( Ctor&& constructor, Dtor&& destructor )
+        : m_function(static_cast<Ctor&&>(constructor),static_cast<Dtor&&>(destructor))
+      {
+
+      }
+
+      Function& first() noexcept{ return m_function; }
+      const Function& first() const noexcept{ return m_function; }
+
+      Function& second() noexcept{ return m_function; }
+      const Function& second() const noexcept{ return m_function; }
+
+      void swap( function_pair& rhs ) noexcept
+      {
+        using std::swap; // for ADL
+
+        swap(m_function,rhs.m_function);
+      }
+
+    private:
+
+      LAZY_NO_UNIQUE_ADDRESS Function m_function;
+    };
+
+    //------------------------------------------------------------------------
+    // erased_function
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    inline constexpr erased_function<T,InlineBytes>::erased_function()
+      noexcept
+      : m_vtable(&default_operations<T,InlineBytes>::value),
+        m_buffer()
+    {
+      static_assert(std::is_default_constructible<T>::value,"No matching default constructor for type T");
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    template<typename CtorFunc, typename>
+    inline erased_function<T,InlineBytes>::erased_function( const CtorFunc& constructor )
+      : erased_function(constructor,default_destructor<T>())
+    {
+
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    template<typename CtorFunc, typename DtorFunc, typename>
+    inline erased_function<T,InlineBytes>::erased_function( const CtorFunc& constructor,
+                                                            const DtorFunc& destructor )
+      : m_vtable(nullptr)
+    {
+      using return_type = typename function_traits<CtorFunc>::result_type;
+
+      static_assert(is_tuple<return_type>::value,"Lazy-construction functions must return tuples containing constructor arguments");
+      static_assert(is_tuple_constructible<T,return_type>::value, "No matching constructor for type T with given arguments");
+
+      using function_type = tuple_construct_function<T,typename std::decay<CtorFunc>::type>;
+
+      store<function_type,typename std::decay<DtorFunc>::type>( function_type{constructor}, destructor );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::erased_function( const T& value )
+      : m_vtable(nullptr)
+    {
+      static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
+
+      store<value_construct_function<T>,default_destructor<T>>( value_construct_function<T>{value},
+                                                                default_destructor<T>() );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::erased_function( T&& value )
+      : m_vtable(nullptr)
+    {
+      static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
+
+      store<value_construct_function<T>,default_destructor<T>>( value_construct_function<T>{std::move(value)},
+                                                                default_destructor<T>() );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    template<typename...Args>
+    inline erased_function<T,InlineBytes>::erased_function( ctor_va_args_tag,
+                                                            Args&&...args )
+      : m_vtable(nullptr)
+    {
+      static_assert(std::is_constructible<T,moved_argument_t<typename stored_argument<Args>::type>...>::value,
+                    "No matching constructor for type T with given arguments");
+
+      using function_type = arguments_construct_function<T,typename stored_argument<Args>::type...>;
+
+      store<function_type,default_destructor<T>>( function_type(ctor_va_args_tag(),std::forward<Args>(args)...),
+                                                  default_destructor<T>() );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::erased_function( const erased_function& rhs )
+      : m_vtable(nullptr)
+    {
+      if( rhs.m_vtable )
+      {
+        rhs.m_vtable->copy( rhs.m_buffer, m_buffer );
+        m_vtable = rhs.m_vtable;
+      }
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::erased_function( erased_function&& rhs )
+      noexcept
+      : m_vtable(rhs.m_vtable)
+    {
+      if( m_vtable )
+      {
+        m_vtable->move( rhs.m_buffer, m_buffer );
+        rhs.m_vtable = nullptr;
+      }
+    }
+
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>::~erased_function()
+    {
+      if( m_vtable )
+      {
+        m_vtable->destroy( m_buffer );
+      }
+    }
+
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>&
+      erased_function<T,InlineBytes>::operator=( const erased_function& rhs )
+    {
+      if( this != &rhs )
+      {
+        (*this) = erased_function(rhs);
+      }
+      return (*this);
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline erased_function<T,InlineBytes>&
+      erased_function<T,InlineBytes>::operator=( erased_function&& rhs )
+      noexcept
+    {
+      if( this != &rhs )
+      {
+        if( m_vtable )
+        {
+          m_vtable->destroy( m_buffer );
+        }
+        m_vtable = rhs.m_vtable;
+        if( m_vtable )
+        {
+          m_vtable->move( rhs.m_buffer, m_buffer );
+          rhs.m_vtable = nullptr;
+        }
+      }
+      return (*this);
+    }
+
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    inline void erased_function<T,InlineBytes>::construct( void* where )
+    {
+      if( !m_vtable )
+      {
+        throw std::bad_function_call();
+      }
+      m_vtable->construct( m_buffer, where );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline void erased_function<T,InlineBytes>::consume( void* where )
+    {
+      if( !m_vtable )
+      {
+        throw std::bad_function_call();
+      }
+      m_vtable = m_vtable->consume( m_buffer, where );
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline void erased_function<T,InlineBytes>::operator()( T& x )
+    {
+      if( m_vtable )
+      {
+        m_vtable->destruct( m_buffer, x );
+      }
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline void erased_function<T,InlineBytes>::release()
+      noexcept
+    {
+      if( m_vtable )
+      {
+        m_vtable = m_vtable->release( m_buffer );
+      }
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline bool erased_function<T,InlineBytes>::is_allocated()
+      const noexcept
+    {
+      return m_vtable && m_vtable->is_allocated;
+    }
+
+    template<typename T, std::size_t InlineBytes>
+    inline std::size_t erased_function<T,InlineBytes>::retained_bytes()
+      const noexcept
+    {
+      return m_vtable ? m_vtable->size : 0;
+    }
+
+    //------------------------------------------------------------------------
+
+    template<typename T, std::size_t InlineBytes>
+    template<typename CtorFunc, typename DtorFunc, typename Ctor, typename Dtor>
+    inline void erased_function<T,InlineBytes>::store( Ctor&& constructor,
+                                                       Dtor&& destructor )
+    {
+      using operations_type = erased_operations<T,InlineBytes,CtorFunc,DtorFunc>;
+
+      operations_type::storage_type::create( m_buffer,
+                                             std::forward<Ctor>(constructor),
+                                             std::forward<Dtor>(destructor) );
+      m_vtable = &operations_type::value;
+    }
+
+  } // namespace detail
+
+  namespace detail{
+
+    /// \brief The type of an atomic state word that threads can wait on
+    using atomic_wait_type = std::atomic<std::uint32_t>;
+
+    /// \brief Hints to the processor that the calling thread is spinning
+    inline void cpu_relax() noexcept
+    {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+      __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+      asm volatile("yield" ::: "memory");
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+      _mm_pause();
+#endif
+    }
+
+    /// \brief Blocks the calling thread while \p state holds \p old
+    ///
+    /// This may return spuriously, so callers must re-check \p state.
+    ///
+    /// \param state the state word to wait on
+    /// \param old   the value to wait for \p state to change from
+    inline void atomic_wait( const atomic_wait_type& state, std::uint32_t old ) noexcept
+    {
+#if LAZY_ATOMIC_WAIT_STD
+      state.wait(old,std::memory_order_acquire);
+#elif LAZY_ATOMIC_WAIT_FUTEX
+      static_assert(sizeof(atomic_wait_type)==sizeof(std::uint32_t),
+                    "futex requires a 32-bit state word");
+
+      ::syscall(SYS_futex,
+                const_cast<atomic_wait_type*>(&state),
+                FUTEX_WAIT_PRIVATE,
+                old,
+                nullptr, nullptr, 0);
+#else
+      if( state.load(std::memory_order_acquire) == old ) {
+        std::this_thread::yield();
+      }
+#endif
+    }
+
+    /// \brief Wakes all threads blocked in \c atomic_wait on \p state
+    ///
+    /// \param state the state word being waited on
+    inline void atomic_notify_all( atomic_wait_type& state ) noexcept
+    {
+#if LAZY_ATOMIC_WAIT_STD
+      state.notify_all();
+#elif LAZY_ATOMIC_WAIT_FUTEX
+      ::syscall(SYS_futex,
+                &state,
+                FUTEX_WAKE_PRIVATE,
+                INT_MAX,
+                nullptr, nullptr, 0);
+#else
+      (void) state;
+#endif
+    }
+
+  } // namespace detail
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that is only ever
+  ///        accessed from one thread at a time
+  ///
+  /// The initialized state is a plain \c bool, so accessing the \c BasicLazy
+  /// costs nothing beyond a check of the flag. Accessing the same
+  /// uninitialized \c BasicLazy from multiple threads is a data race.
+  ////////////////////////////////////////////////////////////////////////////
+  struct single_threaded
+  {
+    class state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : m_is_initialized(false){}
+
+      /// \brief Checks whether the \c T has been constructed
+      ///
+      /// \return \c true if the \c T has been constructed
+      bool is_initialized() const noexcept
+      {
+        return m_is_initialized;
+      }
+
+      /// \brief Constructs the \c T with \p init, unless it has already
+      ///        been constructed
+      ///
+      /// \param init the operations for constructing the \c T
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        if( !m_is_initialized )
+        {
+          init.construct();
+          m_is_initialized = true;
+        }
+      }
+
+      /// \brief Sets whether the \c T has been constructed
+      ///
+      /// \note This is only used outside of \c initialize, while there is no
+      ///       concurrent access to the \c BasicLazy
+      ///
+      /// \param is_initialized whether the \c T has been constructed
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        m_is_initialized = is_initialized;
+      }
+
+    private:
+
+      bool m_is_initialized;
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that may be accessed
+  ///        from many threads at once
+  ///
+  /// The initialized state is an atomic state word. Accessing an initialized
+  /// \c BasicLazy costs a single acquire load; if it is not initialized,
+  /// exactly one thread constructs the \c T while any others wait for it to
+  /// finish.
+  ///
+  /// Waiting threads check the state word \p SpinCount times, and then park
+  /// until the constructing thread wakes them (with \c std::atomic::wait, or
+  /// a futex on Linux). The constructing thread only pays for the wake-up if
+  /// some thread actually parked.
+  ///
+  /// If the construction function throws, the \c BasicLazy is left
+  /// uninitialized, and one of the waiting threads (if any) tries again.
+  ///
+  /// \note Only initialization is synchronized; assigning, swapping, or
+  ///       destroying a \c BasicLazy still requires exclusive access.
+  ///
+  /// \tparam SpinCount the number of times to check the state before parking
+  ////////////////////////////////////////////////////////////////////////////
+  template<unsigned SpinCount = LAZY_SPIN_COUNT>
+  struct basic_double_checked
+  {
+    class state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : m_state(uninitialized){}
+
+      bool is_initialized() const noexcept
+      {
+        return m_state.load(std::memory_order_acquire) == initialized;
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        auto state = m_state.load(std::memory_order_acquire);
+
+        while( state != initialized )
+        {
+          if( state != uninitialized )
+          {
+            // Another thread is constructing the T; wait for it to finish
+            state = wait(state);
+          }
+          else if( m_state.compare_exchange_weak(state,initializing,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_acquire) )
+          {
+            try {
+              init.construct();
+            } catch( ... ) {
+              finish(uninitialized);
+              throw;
+            }
+            finish(initialized);
+            return;
+          }
+        }
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        m_state.store(is_initialized ? initialized : uninitialized,
+                      std::memory_order_release);
+      }
+
+    private:
+
+      enum : std::uint32_t
+      {
+        uninitialized, ///< The T has not been constructed
+        initializing,  ///< A thread is constructing the T
+        contended,     ///< A thread is constructing the T, and others are parked
+        initialized    ///< The T has been constructed
+      };
+
+      /// \brief Publishes the result of constructing the \c T, waking any
+      ///        parked threads
+      ///
+      /// \param state the new state
+      void finish( std::uint32_t state ) noexcept
+      {
+        if( m_state.exchange(state,std::memory_order_release) == contended )
+        {
+          detail::atomic_notify_all(m_state);
+        }
+      }
+
+      /// \brief Waits for the thread constructing the \c T to finish
+      ///
+      /// \param state the last observed state
+      /// \return the state after construction finished
+      LAZY_NOINLINE
+      std::uint32_t wait( std::uint32_t state ) noexcept
+      {
+        for( auto spins = SpinCount; spins != 0; --spins )
+        {
+          if( state == uninitialized || state == initialized ) return state;
+
+          detail::cpu_relax();
+          state = m_state.load(std::memory_order_acquire);
+        }
+
+        while( state == initializing || state == contended )
+        {
+          // Flag that a thread is parking, so that the constructing thread
+          // knows to wake it. This is repeated after every wake-up, since a
+          // new thread may have started constructing without the flag.
+          if( state == initializing &&
+              !m_state.compare_exchange_weak(state,contended,
+                                             std::memory_order_acquire,
+                                             std::memory_order_acquire) )
+          {
+            continue;
+          }
+
+          detail::atomic_wait(m_state,contended);
+          state = m_state.load(std::memory_order_acquire);
+        }
+        return state;
+      }
+
+      detail::atomic_wait_type m_state;
+    };
+  };
+
+  /// \brief The threading policy used by \c ConcurrentLazy, which spins
+  ///        \c LAZY_SPIN_COUNT times before parking
+  using double_checked = basic_double_checked<>;
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that may be accessed
+  ///        from many threads at once, initialized with \c std::call_once
+  ///
+  /// This behaves like \c double_checked, but leaves waiting to the standard
+  /// library, which may be preferable where its implementation is known to
+  /// cooperate with the platform's scheduler. Accessing an initialized
+  /// \c BasicLazy costs a single acquire load.
+  ///
+  /// \note Some implementations of \c std::call_once (such as libstdc++
+  ///       before GCC 11, or any program built with ThreadSanitizer)
+  ///       deadlock if the construction function throws; \c double_checked
+  ///       is preferable for construction functions that may throw.
+  ///
+  /// \note Only initialization is synchronized; assigning, swapping, or
+  ///       destroying a \c BasicLazy still requires exclusive access.
+  ////////////////////////////////////////////////////////////////////////////
+  struct call_once
+  {
+    class state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : m_flag(), m_is_initialized(false){}
+
+      bool is_initialized() const noexcept
+      {
+        return m_is_initialized.load(std::memory_order_acquire);
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        std::call_once(m_flag,[this,&init](){
+          // The T may have been assigned without going through the flag
+          if( !m_is_initialized.load(std::memory_order_relaxed) )
+          {
+            init.construct();
+          }
+          m_is_initialized.store(true,std::memory_order_release);
+        });
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        // A std::once_flag can't be reset, so a fresh one is made for the
+        // next initialization
+        if( !is_initialized )
+        {
+          m_flag.~once_flag();
+          ::new (static_cast<void*>(&m_flag)) std::once_flag();
+        }
+        m_is_initialized.store(is_initialized,std::memory_order_release);
+      }
+
+    private:
+
+      std::once_flag    m_flag;
+      std::atomic<bool> m_is_initialized;
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that may be accessed
+  ///        from many threads at once, and whose construction function may
+  ///        safely run more than once
+  ///
+  /// No thread ever waits for another to finish constructing the \c T.
+  /// Instead, every thread that finds the \c BasicLazy uninitialized
+  /// constructs its own \c T, and the first to finish moves it into the
+  /// \c BasicLazy. The others destroy theirs (invoking the destruction
+  /// function) and use the published \c T.
+  ///
+  /// This suits cheap, idempotent construction functions, where waiting
+  /// would cost more than the duplicated work. The construction function
+  /// must be safe to call from several threads at once, and \c T must be
+  /// move-constructible. Arguments stored by \c make_lazy are copied for
+  /// each construction, and are kept after initialization.
+  ///
+  /// \note Only initialization is synchronized; assigning, swapping, or
+  ///       destroying a \c BasicLazy still requires exclusive access.
+  ////////////////////////////////////////////////////////////////////////////
+  struct racy_idempotent
+  {
+    class state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : m_state(uninitialized){}
+
+      bool is_initialized() const noexcept
+      {
+        return m_state.load(std::memory_order_acquire) == initialized;
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        if( is_initialized() ) return;
+
+        typename Initializer::storage_type storage;
+        init.construct_at(&storage);
+
+        auto state = static_cast<unsigned char>(uninitialized);
+        while( !m_state.compare_exchange_weak(state,publishing,
+                                              std::memory_order_acquire,
+                                              std::memory_order_acquire) )
+        {
+          if( state == initialized )
+          {
+            // Another thread won the race
+            init.destroy_at(&storage);
+            return;
+          }
+
+          // Another thread is moving its T into place. If its move throws,
+          // this thread's T is published instead.
+          if( state == publishing ) std::this_thread::yield();
+          state = uninitialized;
+        }
+
+        try {
+          init.relocate_from(&storage);
+        } catch( ... ) {
+          init.destroy_at(&storage);
+          m_state.store(uninitialized,std::memory_order_release);
+          throw;
+        }
+        m_state.store(initialized,std::memory_order_release);
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        m_state.store(is_initialized ? initialized : uninitialized,
+                      std::memory_order_release);
+      }
+
+    private:
+
+      enum : unsigned char
+      {
+        uninitialized, ///< The T has not been constructed
+        publishing,    ///< A thread is moving its T into place
+        initialized    ///< The T has been constructed
+      };
+
+      std::atomic<unsigned char> m_state;
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A threading policy that behaves as \c Policy, but aligns each
+  ///        \c BasicLazy to a cache line
+  ///
+  /// The state of \c Policy is aligned to \c LAZY_CACHE_LINE_SIZE, so the
+  /// \c BasicLazy holding it occupies whole cache lines of its own. The first
+  /// access to one element of an array of these objects then writes only to
+  /// that element's cache lines, rather than invalidating its neighbours in
+  /// the caches of other threads (false sharing).
+  ///
+  /// This suits arrays of objects that are each used by a different thread,
+  /// such as tables of per-worker slots, at the cost of padding every object
+  /// to a multiple of \c LAZY_CACHE_LINE_SIZE bytes.
+  ///
+  /// \note Before C++17, objects allocated with \c new (including by
+  ///       standard containers) may not be aligned, and so may share a
+  ///       cache line at each end
+  ///
+  /// \tparam Policy the threading policy to align
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Policy = single_threaded>
+  struct cache_aligned
+  {
+    class alignas(LAZY_CACHE_LINE_SIZE) state_type
+      : public Policy::state_type
+    {
+    public:
+
+      constexpr state_type() noexcept : Policy::state_type(){}
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief A threading policy that behaves as \c Policy, but caches a
+  ///        failed construction for a while instead of retrying it on every
+  ///        access
+  ///
+  /// Normally, a \c BasicLazy whose construction function throws is left
+  /// uninitialized, and the next access retries construction immediately.
+  /// When construction fails because a backing resource is unavailable,
+  /// every access then re-runs the (often slow) failing construction.
+  ///
+  /// With this policy, the exception is instead kept, and rethrown by every
+  /// access for \c DelayMs milliseconds without calling the construction
+  /// function. Threads that were waiting on the failed construction are also
+  /// woken with the cached exception. The first access after the delay
+  /// retries construction. If \c MaxDelayMs is greater than \c DelayMs, the
+  /// delay doubles after each consecutive failure, up to \c MaxDelayMs
+  /// (exponential backoff). A successful construction forgets the failures.
+  ///
+  /// Accessing an initialized \c BasicLazy costs the same as with \c Policy.
+  /// The cached exception is shared by every thread that rethrows it.
+  ///
+  /// \tparam Policy     the threading policy to use for initialization
+  /// \tparam DelayMs    the number of milliseconds to cache the first failure
+  /// \tparam MaxDelayMs the maximum number of milliseconds to cache a failure
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Policy, unsigned DelayMs, unsigned MaxDelayMs = DelayMs>
+  struct cache_failures
+  {
+    static_assert(MaxDelayMs >= DelayMs,"The maximum delay must not be less than the initial delay");
+
+    class state_type
+      : public Policy::state_type
+    {
+      using base_type = typename Policy::state_type;
+      using clock     = std::chrono::steady_clock;
+
+    public:
+
+      constexpr state_type() noexcept
+        : base_type(),
+          m_retry_at(0),
+          m_mutex(),
+          m_error(nullptr),
+          m_failures(0)
+      {
+
+      }
+
+      state_type( const state_type& ) = delete;
+      state_type& operator=( const state_type& ) = delete;
+
+      ~state_type()
+      {
+        delete m_error;
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        rethrow_cached_failure();
+        base_type::initialize( failure_initializer<Initializer>{init,*this} );
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        base_type::set_initialized(is_initialized);
+        if( is_initialized ) forget_failures();
+      }
+
+    private:
+
+      /// \brief The operations of the \c BasicLazy::initializer \c Initializer,
+      ///        which check for and record failures around construction
+      template<typename Initializer>
+      struct failure_initializer
+      {
+        using storage_type = typename Initializer::storage_type;
+
+        const Initializer& init;
+        state_type&        state;
+
+        void construct() const
+        {
+          // A waiting thread may be retrying a construction that has just
+          // failed on another thread
+          state.rethrow_cached_failure();
+          try {
+            init.construct();
+          } catch( ... ) {
+            state.record_failure(std::current_exception());
+            throw;
+          }
+          state.forget_failures();
+        }
+
+        void construct_at( void* where ) const
+        {
+          state.rethrow_cached_failure();
+          try {
+            init.construct_at(where);
+          } catch( ... ) {
+            state.record_failure(std::current_exception());
+            throw;
+          }
+          state.forget_failures();
+        }
+
+        void relocate_from( void* where ) const
+        {
+          init.relocate_from(where);
+        }
+
+        void destroy_at( void* where ) const
+        {
+          init.destroy_at(where);
+        }
+      };
+
+      /// \brief Gets the current time, in ticks of the steady clock
+      static clock::rep now() noexcept
+      {
+        return clock::now().time_since_epoch().count();
+      }
+
+      /// \brief Rethrows the cached exception, if it has not expired
+      void rethrow_cached_failure()
+      {
+        const auto retry_at = m_retry_at.load(std::memory_order_acquire);
+        if( LAZY_LIKELY(retry_at == 0) || now() >= retry_at ) return;
+
+        auto error = std::exception_ptr();
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          if( m_error ) error = *m_error;
+        }
+        if( error ) std::rethrow_exception(error);
+      }
+
+      /// \brief Caches \p error, until the delay for the number of
+      ///        consecutive failures has passed
+      ///
+      /// \param error the exception thrown by construction
+      void record_failure( std::exception_ptr error )
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if( !m_error ) m_error = new std::exception_ptr(std::move(error));
+        else *m_error = std::move(error);
+
+        const auto failures  = m_failures.fetch_add(1,std::memory_order_relaxed);
+        const auto doublings = failures < 31u ? failures : 31u;
+        const auto delay_ms  = static_cast<unsigned long long>(DelayMs) << doublings;
+        const auto delay     = std::chrono::milliseconds(delay_ms < MaxDelayMs ? delay_ms : MaxDelayMs);
+
+        m_retry_at.store( now() + std::chrono::duration_cast<clock::duration>(delay).count(),
+                          std::memory_order_release );
+      }
+
+      /// \brief Forgets any cached exception after a successful construction
+      ///
+      /// This takes no lock, since it is called from \c set_initialized. The
+      /// cached exception is no longer rethrown once \c m_retry_at is reset,
+      /// and is replaced by the next failure, or freed on destruction.
+      void forget_failures() noexcept
+      {
+        if( m_retry_at.load(std::memory_order_acquire) == 0 ) return;
+
+        m_failures.store(0, std::memory_order_relaxed);
+        m_retry_at.store(0, std::memory_order_release);
+      }
+
+      std::atomic<clock::rep> m_retry_at; ///< When construction may be retried, or 0 if it has not failed
+      std::mutex              m_mutex;    ///< Guards the cached exception
+      std::exception_ptr*     m_error;    ///< The cached exception, allocated so that this is constexpr-constructible
+      std::atomic<unsigned>   m_failures; ///< The number of consecutive failures
+    };
+  };
+
+  //==========================================================================
+  // Sentinel values
+  //==========================================================================
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The customization point describing the value of \c T that
+  ///        represents "not yet constructed"
+  ///
+  /// A specialization provides:
+  ///
+  /// - \c static \c constexpr \c T \c empty(), which returns the sentinel
+  ///   value, and
+  /// - \c static \c bool \c is_empty(const T&), which checks whether a value
+  ///   is the sentinel.
+  ///
+  /// Specializations are provided for pointers and \c std::unique_ptr, with
+  /// \c nullptr as the sentinel. Others may be added for user types, or a
+  /// \c value_sentinel can be given to the \c sentinel policies instead.
+  ///
+  /// \tparam T the type with a sentinel value
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  struct sentinel_traits;
+
+  template<typename T>
+  struct sentinel_traits<T*>
+  {
+    static constexpr T* empty() noexcept{ return nullptr; }
+    static bool is_empty( T* const& value ) noexcept{ return value == nullptr; }
+  };
+
+  template<typename T, typename Deleter>
+  struct sentinel_traits<std::unique_ptr<T,Deleter>>
+  {
+    static constexpr std::unique_ptr<T,Deleter> empty() noexcept{ return std::unique_ptr<T,Deleter>(); }
+    static bool is_empty( const std::unique_ptr<T,Deleter>& value ) noexcept{ return value == nullptr; }
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief Sentinel traits using the reserved value \c Empty, such as \c -1
+  ///        for a file descriptor
+  ///
+  /// \tparam T     the type with a sentinel value
+  /// \tparam Empty the sentinel value
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T, T Empty>
+  struct value_sentinel
+  {
+    static constexpr T empty() noexcept{ return Empty; }
+    static bool is_empty( const T& value ) noexcept{ return value == Empty; }
+  };
+
+  namespace detail{
+
+    /// \brief Gets the sentinel traits to use for \c T: \c Traits, or
+    ///        \c sentinel_traits<T> if \c Traits is \c void
+    template<typename Traits, typename T>
+    using select_sentinel_traits = typename std::conditional<
+      std::is_void<Traits>::value,
+      sentinel_traits<T>,
+      Traits
+    >::type;
+
+  } // namespace detail
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that stores no separate
+  ///        initialized state, and is only ever accessed from one thread at a
+  ///        time
+  ///
+  /// Instead of a flag beside the \c T, the \c BasicLazy holds the sentinel
+  /// value (described by \c Traits) until the \c T is constructed. This
+  /// saves the flag and its padding for pointers, handles, and identifiers
+  /// that have a value reserved for "none".
+  ///
+  /// \note A \c BasicLazy whose \c T is constructed with (or moved into) the
+  ///       sentinel value is uninitialized. Moving out of a \c std::unique_ptr
+  ///       therefore leaves its \c BasicLazy uninitialized.
+  ///
+  /// \tparam Traits the sentinel traits, or \c void to use
+  ///                \c sentinel_traits<T>
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Traits = void>
+  struct sentinel
+  {
+    /// \brief The state of a \c BasicLazy, which holds the \c T itself
+    template<typename T>
+    class value_state
+    {
+      using value_type  = typename std::remove_cv<T>::type;
+      using traits_type = detail::select_sentinel_traits<Traits,value_type>;
+
+    public:
+
+      constexpr value_state() noexcept : m_value(traits_type::empty()){}
+
+      // The T is destroyed by the BasicLazy, which leaves the sentinel
+      ~value_state()
+      {
+        m_value.~value_type();
+      }
+
+      value_type* ptr() noexcept
+      {
+        return &m_value;
+      }
+
+      bool is_initialized() const noexcept
+      {
+        return !traits_type::is_empty(m_value);
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        if( !is_initialized() )
+        {
+          clear();
+          try {
+            init.construct();
+          } catch( ... ) {
+            set_initialized(false);
+            throw;
+          }
+        }
+      }
+
+      /// \brief Destroys the sentinel, so that a \c T may be constructed
+      ///        in its place
+      void clear() noexcept
+      {
+        m_value.~value_type();
+      }
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        // The T has already been constructed in place of the sentinel, or
+        // destroyed
+        if( !is_initialized ) new (&m_value) value_type(traits_type::empty());
+      }
+
+    private:
+
+      union{ value_type m_value; };
+    };
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The threading policy for a \c BasicLazy that stores no separate
+  ///        initialized state, and may be accessed from many threads at once
+  ///
+  /// The \c T is held in a single atomic word, which holds the sentinel
+  /// value (described by \c Traits) until the \c T is published. As with
+  /// \c racy_idempotent, every thread that finds the \c BasicLazy
+  /// uninitialized constructs its own \c T, and the first to publish it with
+  /// a compare-and-swap wins; the others invoke the destruction function on
+  /// theirs. No thread ever waits for another, and accessing an initialized
+  /// \c BasicLazy costs a single acquire load.
+  ///
+  /// This suits lazily opened file descriptors and handles, where opening
+  /// twice (and closing the extra one) is harmless. \c T must be trivially
+  /// copyable, and should be small enough for \c std::atomic<T> to be
+  /// lock-free.
+  ///
+  /// \note Only initialization is synchronized; assigning, swapping, or
+  ///       destroying a \c BasicLazy still requires exclusive access.
+  ///
+  /// \tparam Traits the sentinel traits, or \c void to use
+  ///                \c sentinel_traits<T>
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename Traits = void>
+  struct atomic_sentinel
+  {
+    /// \brief The state of a \c BasicLazy, which holds the \c T itself
+    template<typename T>
+    class value_state
+    {
+      using value_type  = typename std::remove_cv<T>::type;
+      using traits_type = detail::select_sentinel_traits<Traits,value_type>;
+
+      static_assert(std::is_trivially_copyable<value_type>::value,"atomic_sentinel requires T to be trivially copyable");
+      static_assert(sizeof(std::atomic<value_type>) == sizeof(value_type),"atomic_sentinel requires std::atomic<T> to have the layout of T");
+
+    public:
+
+      constexpr value_state() noexcept : m_value(traits_type::empty()){}
+
+      value_type* ptr() noexcept
+      {
+        return reinterpret_cast<value_type*>(&m_value);
+      }
+
+      bool is_initialized() const noexcept
+      {
+        return !traits_type::is_empty(m_value.load(std::memory_order_acquire));
+      }
+
+      template<typename Initializer>
+      void initialize( const Initializer& init )
+      {
+        typename Initializer::storage_type storage;
+        init.construct_at(&storage);
+
+        auto expected = traits_type::empty();
+        if( !m_value.compare_exchange_strong(expected,*reinterpret_cast<value_type*>(&storage),
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire) )
+        {
+          // Another thread won the race
+          init.destroy_at(&storage);
+        }
+      }
+
+      // The T is trivially destructible, so the sentinel needs no destruction
+      void clear() noexcept{}
+
+      void set_initialized( bool is_initialized ) noexcept
+      {
+        // The T has already been constructed or destroyed in place
+        if( !is_initialized ) m_value.store(traits_type::empty(),std::memory_order_release);
+      }
+
+    private:
+
+      std::atomic<value_type> m_value;
+    };
+  };
+
+  namespace detail{
+
+    /// \brief Type trait to determine whether a \c BasicLazy with \c Policy
+    ///        may be initialized from many threads at once
+    ///
+    /// The result is aliased as \c ::value
+    template<typename Policy>
+    struct is_thread_safe_policy : std::false_type{};
+
+    template<unsigned SpinCount>
+    struct is_thread_safe_policy<basic_double_checked<SpinCount>> : std::true_type{};
+
+    template<>
+    struct is_thread_safe_policy<call_once> : std::true_type{};
+
+    template<>
+    struct is_thread_safe_policy<racy_idempotent> : std::true_type{};
+
+    template<typename Traits>
+    struct is_thread_safe_policy<atomic_sentinel<Traits>> : std::true_type{};
+
+    template<typename Policy>
+    struct is_thread_safe_policy<cache_aligned<Policy>> : is_thread_safe_policy<Policy>{};
+
+    template<typename Policy, unsigned DelayMs, unsigned MaxDelayMs>
+    struct is_thread_safe_policy<cache_failures<Policy,DelayMs,MaxDelayMs>> : is_thread_safe_policy<Policy>{};
+
+    /// \brief Type trait to determine whether a \c BasicLazy with \c Policy
+    ///        may construct a \c T on several threads at once, each into
+    ///        storage of its own
+    ///
+    /// The result is aliased as \c ::value
+    template<typename Policy>
+    struct races_construction : std::false_type{};
+
+    template<>
+    struct races_construction<racy_idempotent> : std::true_type{};
+
+    template<typename Traits>
+    struct races_construction<atomic_sentinel<Traits>> : std::true_type{};
+
+    template<typename Policy>
+    struct races_construction<cache_aligned<Policy>> : races_construction<Policy>{};
+
+    template<typename Policy, unsigned DelayMs, unsigned MaxDelayMs>
+    struct races_construction<cache_failures<Policy,DelayMs,MaxDelayMs>> : races_construction<Policy>{};
+
+  } // namespace detail
+
+  namespace detail{
+
+    /// \brief Type trait to determine whether the destruction function
+    ///        \c DtorFunc is known to do nothing
+    ///
+    /// The result is aliased as \c ::value
+    template<typename DtorFunc>
+    struct is_noop_destructor : std::false_type{};
+
+    template<typename T>
+    struct is_noop_destructor<default_destructor<T>> : std::true_type{};
+
+    /// \brief Type trait to determine whether a
+    ///        \c BasicLazy<T,CtorFunc,DtorFunc,Policy> can be trivially
+    ///        destructible
+    ///
+    /// This is the case when destroying \c T does nothing, the destruction
+    /// function does nothing, and neither the functions nor the state of the
+    /// threading policy own any resources.
+    ///
+    /// The result is aliased as \c ::value
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    struct is_trivially_destructible_lazy : boolean_constant<
+      std::is_trivially_destructible<T>::value &&
+      is_noop_destructor<DtorFunc>::value &&
+      std::is_trivially_destructible<function_pair<CtorFunc,DtorFunc>>::value &&
+      std::is_trivially_destructible<typename Policy::state_type>::value
+    >{};
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The storage for a \c BasicLazy
+    ///
+    /// This holds the lazily-constructed \c T, whether it has been
+    /// initialized, and the construction and destruction functions. This
+    /// primary template destroys the \c T on destruction.
+    ///
+    /// \tparam T        the type being stored
+    /// \tparam CtorFunc the type of the construction function
+    /// \tparam DtorFunc the type of the destruction function
+    /// \tparam Policy   the threading policy
+    ////////////////////////////////////////////////////////////////////////////
+    template<
+      typename T,
+      typename CtorFunc,
+      typename DtorFunc,
+      typename Policy,
+      bool = is_trivially_destructible_lazy<T,CtorFunc,DtorFunc,Policy>::value
+    >
+    class lazy_storage
+    {
+    protected:
+
+      using unqualified_pointer = typename std::remove_cv<T>::type*;
+      using function_pair_type  = function_pair<CtorFunc,DtorFunc>;
+      using state_type          = typename Policy::state_type;
+      using storage_type        = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+
+      constexpr lazy_storage()
+        : m_storage(),
+          m_state(),
+          m_functions()
+      {
+
+      }
+
+      template<typename...Functions>
+      constexpr explicit lazy_storage( Functions&&...functions )
+        : m_storage(),
+          m_state(),
+          m_functions(static_cast<Functions&&>(functions)...)
+      {
+
+      }
+
+      ~lazy_storage()
+      {
+        destruct();
+      }
+
+      /// \brief Gets a pointer to the data stored in this \c lazy_storage
+      ///
+      /// \return the pointer to the object
+      unqualified_pointer ptr() const noexcept
+      {
+        // address-of idiom (https://en.wikibooks.org/wiki/More_C%2B%2B_Idioms/Address_Of)
+        return reinterpret_cast<unqualified_pointer>(& const_cast<char&>(reinterpret_cast<const volatile char &>(m_storage)));
+      }
+
+      /// \brief Destructs the \c T, if it has been initialized
+      void destruct() const
+      {
+        if( m_state.is_initialized() )
+        {
+          m_functions.second()(*ptr());
+          ptr()->~T();
+          m_state.set_initialized(false);
+        }
+      }
+
+      // The initialized state directly follows the storage so that it
+      // occupies the padding between a small T and the (pointer-aligned)
+      // functions, rather than adding padding of its own
+
+      mutable storage_type       m_storage;        ///< The storage to hold the lazy type
+      mutable state_type         m_state;          ///< Is the type initialized?
+      mutable function_pair_type m_functions;      ///< The construction/destruction functions
+    };
+
+    /// \brief The storage for a \c BasicLazy with nothing to destroy
+    ///
+    /// Destroying the \c T is skipped entirely, leaving this (and the
+    /// \c BasicLazy containing it) trivially destructible.
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    class lazy_storage<T,CtorFunc,DtorFunc,Policy,true>
+    {
+    protected:
+
+      using unqualified_pointer = typename std::remove_cv<T>::type*;
+      using function_pair_type  = function_pair<CtorFunc,DtorFunc>;
+      using state_type          = typename Policy::state_type;
+      using storage_type        = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+
+      constexpr lazy_storage()
+        : m_storage(),
+          m_state(),
+          m_functions()
+      {
+
+      }
+
+      template<typename...Functions>
+      constexpr explicit lazy_storage( Functions&&...functions )
+        : m_storage(),
+          m_state(),
+          m_functions(static_cast<Functions&&>(functions)...)
+      {
+
+      }
+
+      unqualified_pointer ptr() const noexcept
+      {
+        // address-of idiom (https://en.wikibooks.org/wiki/More_C%2B%2B_Idioms/Address_Of)
+        return reinterpret_cast<unqualified_pointer>(& const_cast<char&>(reinterpret_cast<const volatile char &>(m_storage)));
+      }
+
+      void destruct() const noexcept
+      {
+        m_state.set_initialized(false);
+      }
+
+      mutable storage_type       m_storage;        ///< The storage to hold the lazy type
+      mutable state_type         m_state;          ///< Is the type initialized?
+      mutable function_pair_type m_functions;      ///< The construction/destruction functions
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief Type trait to determine whether \c Policy encodes the
+    ///        initialized state in the value of the \c T
+    ///
+    /// The result is aliased as \c ::value
+    template<typename Policy>
+    struct is_sentinel_policy : std::false_type{};
+
+    template<typename Traits>
+    struct is_sentinel_policy<sentinel<Traits>> : std::true_type{};
+
+    template<typename Traits>
+    struct is_sentinel_policy<atomic_sentinel<Traits>> : std::true_type{};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The storage for a \c BasicLazy whose policy encodes the
+    ///        initialized state in the value of the \c T
+    ///
+    /// The state of the policy holds the \c T itself, so there is no
+    /// separate flag. The functions take no space when they are empty, where
+    /// \c LAZY_NO_UNIQUE_ADDRESS is supported.
+    ///
+    /// \tparam T        the type being stored
+    /// \tparam CtorFunc the type of the construction function
+    /// \tparam DtorFunc the type of the destruction function
+    /// \tparam Policy   the threading policy
+    ////////////////////////////////////////////////////////////////////////////
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    class sentinel_lazy_storage
+    {
+    protected:
+
+      using unqualified_pointer = typename std::remove_cv<T>::type*;
+      using function_pair_type  = function_pair<CtorFunc,DtorFunc>;
+      using state_type          = typename Policy::template value_state<T>;
+      using storage_type        = typename std::aligned_storage<sizeof(T),alignof(T)>::type;
+
+      constexpr sentinel_lazy_storage()
+        : m_state(),
+          m_functions()
+      {
+
+      }
+
+      template<typename...Functions>
+      constexpr explicit sentinel_lazy_storage( Functions&&...functions )
+        : m_state(),
+          m_functions(static_cast<Functions&&>(functions)...)
+      {
+
+      }
+
+      ~sentinel_lazy_storage()
+      {
+        destruct();
+      }
+
+      /// \brief Gets a pointer to the data stored in this storage
+      ///
+      /// \return the pointer to the object
+      unqualified_pointer ptr() const noexcept
+      {
+        return m_state.ptr();
+      }
+
+      /// \brief Destructs the \c T, if it has been initialized
+      void destruct() const
+      {
+        if( m_state.is_initialized() )
+        {
+          m_functions.second()(*ptr());
+          ptr()->~T();
+          m_state.set_initialized(false);
+        }
+      }
+
+      mutable state_type                                m_state;     ///< The T, or its sentinel
+      LAZY_NO_UNIQUE_ADDRESS mutable function_pair_type m_functions; ///< The construction/destruction functions
+    };
+
+    //------------------------------------------------------------------------
+
+    /// \brief Selects the storage for a \c BasicLazy<T,CtorFunc,DtorFunc,Policy>
+    ///
+    /// The result is aliased as \c ::type
+    template<
+      typename T,
+      typename CtorFunc,
+      typename DtorFunc,
+      typename Policy,
+      bool = is_sentinel_policy<Policy>::value
+    >
+    struct select_lazy_storage
+    {
+      using type = lazy_storage<T,CtorFunc,DtorFunc,Policy>;
+    };
+
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    struct select_lazy_storage<T,CtorFunc,DtorFunc,Policy,true>
+    {
+      using type = sentinel_lazy_storage<T,CtorFunc,DtorFunc,Policy>;
+    };
+
+    template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+    using lazy_storage_t = typename select_lazy_storage<T,CtorFunc,DtorFunc,Policy>::type;
+
+  } // namespace detail
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The default construction function for a \c BasicLazy
+  ///
+  /// This constructs \c T with its default constructor
+  ///
+  /// \tparam T the type being constructed
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  struct default_constructor
+  {
+    /// \brief Returns the (empty) arguments for \c T's default constructor
+    ///
+    /// \return an empty tuple
+    std::tuple<> operator()() const noexcept;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief The default destruction function for a \c BasicLazy
+  ///
+  /// This performs no additional work prior to \c T's destructor
+  ///
+  /// \tparam T the type being destructed
+  ////////////////////////////////////////////////////////////////////////////
+  template<typename T>
+  struct default_destructor
+  {
+    /// \brief Does nothing
+    ///
+    /// \param x the \c T type to be destructed
+    void operator()( T& x ) const noexcept;
+  };
+
+  ////////////////////////////////////////////////////////////////////////////
+  /// \brief Lazy class used for lazy-loading any type, using statically
+  ///        typed construction and destruction functions
+  ///
+  /// The stored lazy-loaded class, \c T, will always be instantiated
+  /// before being accessed, and destructed when put out of scope.
+  ///
+  /// The construction and destruction functions are stored inline by type,
+  /// which allows the compiler to inline them and avoids any allocations.
+  /// Stateless function objects take up no space in the \c BasicLazy.
+  ///
+  /// If \c T is trivially destructible and \c DtorFunc is the
+  /// \c default_destructor, there is nothing to do on destruction, and the
+  /// \c BasicLazy is itself trivially destructible.
+  ///
+  /// \note The \p CtorFunc function must return a \c std::tuple containing
+  ///       the arguments to pass to \c T's constructor for lazy-construction
+  ///
+  /// The \p Policy controls whether the \c BasicLazy may be initialized
+  /// from multiple threads at once; see \c single_threaded,
+  /// \c double_checked, \c call_once, and \c racy_idempotent.
+  ///
+  /// \tparam T        the type contained within this \c BasicLazy
+  /// \tparam CtorFunc the type of the function to use for construction
+  /// \tparam DtorFunc the type of the function to use prior to destruction
+  /// \tparam Policy   the threading policy to use for initialization
+  ////////////////////////////////////////////////////////////////////////////
+  template<
+    typename T,
+    typename CtorFunc = default_constructor<T>,
+    typename DtorFunc = default_destructor<T>,
+    typename Policy   = single_threaded
+  >
+  class BasicLazy final
+    : private detail::lazy_storage_t<T,CtorFunc,DtorFunc,Policy>
+  {
+    //------------------------------------------------------------------------
+    // Public Member Types
+    //------------------------------------------------------------------------
+  public:
+
+    using this_type = BasicLazy<T,CtorFunc,DtorFunc,Policy>; ///< Instance of this type
+
+    using value_type = T;  ///< The underlying type of this Lazy
+    using pointer    = T*; ///< The pointer type of the Lazy
+    using reference  = T&; ///< The reference type of the Lazy
+
+    using constructor_type = CtorFunc; ///< The type of the construction function
+    using destructor_type  = DtorFunc; ///< The type of the destruction function
+    using policy_type      = Policy;   ///< The threading policy
+
+    //------------------------------------------------------------------------
+    // Construction / Destruction / Assignment
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Default constructor; no initialization takes place
+    ///
+    /// The construction and destruction functions are default-constructed
+    ///
+    /// \note This is \c constexpr, so a \c BasicLazy (or \c Lazy) at
+    ///       namespace scope is constant-initialized, and costs nothing
+    ///       until it is first used
+    constexpr BasicLazy( );
+
+    /// \brief Constructs a \c BasicLazy given the \p constructor function
+    ///
+    /// The destruction function is default-constructed
+    ///
+    /// \note This is \c constexpr when \c CtorFunc can be constructed from
+    ///       \p constructor at compile-time, such as for stateless functors
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    template<
+      typename Ctor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type
+    >
+    constexpr explicit BasicLazy( Ctor&& constructor );
+
+    /// \brief Constructs a \c BasicLazy given the \p constructor and
+    ///        \p destructor functions
+    ///
+    /// \note The \p constructor function must return a \c std::tuple containing
+    ///       the arguments to pass to \c T's constructor for lazy-construction
+    ///
+    /// \param constructor function to use for construction
+    /// \param destructor  function to use prior to destruction
+    template<
+      typename Ctor,
+      typename Dtor,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Ctor>>::value>::type,
+      typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<Dtor>>::value>::type
+    >
+    constexpr BasicLazy( Ctor&& constructor, Dtor&& destructor );
+
+    /// \brief Constructs a \c BasicLazy by copying another \c BasicLazy
+    ///
+    /// \note If \p rhs is initialized, then this copy will also be initialized
+    ///
+    /// \param rhs the \c BasicLazy to copy
+    BasicLazy( const this_type& rhs );
+
+    /// \brief Constructs a \c BasicLazy by moving another \c BasicLazy
+    ///
+    /// \note If \p rhs is initialized, then this moved version will
+    ///       also be initialized
+    ///
+    /// \note The construction function never refers back to the \c BasicLazy
+    ///       that owns it, so a moved \c BasicLazy will always construct into
+    ///       its own storage. This is \c noexcept whenever moving \c T and
+    ///       the functions is, allowing containers to relocate it by moving.
+    ///
+    /// \param rhs the \c BasicLazy to move
+    BasicLazy( this_type&& rhs )
+      noexcept( std::is_nothrow_move_constructible<T>::value &&
+                std::is_nothrow_move_constructible<CtorFunc>::value &&
+                std::is_nothrow_move_constructible<DtorFunc>::value );
+
+    /// \brief Constructs a \c BasicLazy by calling \c T's copy constructor
+    ///
+    /// \note This does not initialize the \c BasicLazy. Instead, it stores
+    ///       this value as a copy and move-constructs it later, if necessary
+    ///
+    /// \note This requires \c CtorFunc to be constructible from a \c T
+    ///
+    /// \param rhs the \c T to copy
+    explicit BasicLazy( const value_type& rhs );
+
+    /// \brief Constructs a \c BasicLazy from a given rvalue \c T
+    ///
+    /// \note This does not initialize the \c BasicLazy. Instead, it stores
+    ///       this value as a copy and move-constructs it later, if necessary
+    ///
+    /// \note This requires \c CtorFunc to be constructible from a \c T
+    ///
+    /// \param rhs the \c T to move
+    explicit BasicLazy( value_type&& rhs );
+
+
+    //------------------------------------------------------------------------
+
+    /// \brief Assigns a \c BasicLazy to this \c BasicLazy
+    ///
+    /// \note If \p rhs is initialized, this will copy-construct a new \c T if
+    ///       the \c BasicLazy is not already initialized, otherwise it will
+    ///       assign
+    ///
+    /// \note This requires \c CtorFunc and \c DtorFunc to be copy-assignable
+    ///
+    /// \param rhs the \c BasicLazy on the right-side of the assignment
+    /// \return reference to (*this)
+    this_type& operator=( const this_type& rhs );
+
+    /// \brief Assigns a \c BasicLazy to this \c BasicLazy
+    ///
+    /// \note If \p rhs is initialized, this will move-construct a new \c T if
+    ///       the \c BasicLazy is not already initialized, otherwise it will
+    ///       assign
+    ///
+    /// \note This requires \c CtorFunc and \c DtorFunc to be move-assignable
+    ///
+    /// \param rhs the rvalue \c BasicLazy on the right-side of the assignment
+    /// \return reference to (*this)
+    this_type& operator=( this_type&& rhs )
+      noexcept( std::is_nothrow_move_constructible<T>::value &&
+                std::is_nothrow_move_assignable<T>::value &&
+                std::is_nothrow_move_assignable<CtorFunc>::value &&
+                std::is_nothrow_move_assignable<DtorFunc>::value );
+
+    /// \brief Assigns a \c T to this \c BasicLazy
+    ///
+    /// \note This will construct a new \c T if the \c BasicLazy is not already
+    ///       initialized, otherwise it will assign
+    ///
+    /// \param rhs the \c T on the right-side of the assignment
+    /// \return reference to (\c ptr())
+    value_type& operator=( const value_type& rhs );
+
+    /// \brief Assigns an rvalue \c T to this \c BasicLazy
+    ///
+    /// \note This will construct a new \c T if the \c BasicLazy is not already
+    ///       initialized, otherwise it will assign
+    ///
+    /// \param rhs the \c T on the right-side of the assignment
+    /// \return reference to (\c ptr())
+    value_type& operator=( value_type&& rhs );
+
+    //------------------------------------------------------------------------
+    // Casting
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Converts this \c BasicLazy into a reference
+    ///
+    /// \return the reference to the lazy-loaded object
+    explicit operator reference() const;
+
+    /// \brief Checks whether this \c BasicLazy has an instantiated object
+    ///
+    /// \return \c true if this lazy has an instantiated object
+    explicit operator bool() const noexcept;
+
+    //------------------------------------------------------------------------
+    // Operators
+    //------------------------------------------------------------------------
+  public:
+
+    /// \brief Swapperator class for no-exception swapping
+    ///
+    /// Initialized values are swapped if both \c BasicLazy objects are
+    /// initialized; otherwise the initialized value (if any) is moved
+    /// into the other \c BasicLazy.
+    ///
+    /// \param rhs the rhs to swap
+    void swap(this_type& rhs) noexcept;
+
+    /// \brief Boolean to check if this \c BasicLazy is initialized.
+    ///
+    /// \return \c true if the underlying type \c T is initialized.
+    bool is_initialized() const noexcept;
+
+    /// \brief Gets a pointer to the underlying type
+    ///
+    /// \note This has been added to have a similar API to smart pointers
+    ///
+    /// \return the pointer to the underlying type
+    pointer get() const;
+
+    /// \brief Gets a pointer to the underlying type, without initializing
+    ///        this \c BasicLazy
+    ///
+    /// \return the pointer to the underlying type, or \c nullptr if this
+    ///         \c BasicLazy is not initialized
+    pointer try_get() const noexcept;
+
+    /// \brief Gets a pointer to the underlying type, which must already be
+    ///        initialized
+    ///
+    /// Unlike \c get(), this does not check whether the \c T needs to be
+    /// constructed. This is asserted in debug builds only.
+    ///
+    /// \return the pointer to the underlying type
+    pointer unchecked_get() const noexcept;
+
+    /// \brief Gets a copy of the underlying type if this \c BasicLazy is
+    ///        initialized, otherwise \p fallback, without initializing
+    ///        this \c BasicLazy
+    ///
+    /// \param fallback the value to use if this is not initialized
+    /// \return a copy of the underlying type, or \p fallback
+    template<typename U>
+    value_type value_or( U&& fallback ) const;
+
+    /// \brief Dereferences this \c BasicLazy object into the lazy-loaded object
+    ///
+    /// \return a constant reference to the lazy-loaded object
+    reference operator*() const;
+
+    /// \brief Dereferences this \c BasicLazy object into the lazy-loaded object
+    ///
+    /// \return a pointer to the lazy-loaded object
+    pointer operator->() const;
+
+    /// \brief Submits the construction of the \c T to \p executor, unless
+    ///        it is already constructed
+    ///
+    /// This starts a slow construction ahead of the first access, for
+    /// example while waiting on I/O. An access made while the submitted
+    /// construction is running waits for it, rather than constructing a
+    /// second \c T (except with the racy policies, where both may run). An
+    /// exception thrown by the submitted construction is discarded, and left
+    /// for the next access to encounter.
+    ///
+    /// \note This requires a thread-safe policy, such as that of
+    ///       \c ConcurrentLazy. The \c BasicLazy must outlive the submitted
+    ///       task.
+    ///
+    /// \param executor any object for which \c executor.execute(f) runs the
+    ///                 nullary function \c f on some thread
+    template<typename Executor>
+    void prefetch( Executor& executor ) const;
+
+    /// \brief Gets the number of bytes of state retained by the construction
+    ///        function, including any arguments captured for it
+    ///
+    /// \note Type-erased construction functions (such as those used by
+    ///       \c Lazy) are released, along with their captured arguments, as
+    ///       soon as the \c T has been constructed; after which this
+    ///       returns \c 0.
+    ///
+    /// \return the number of bytes retained by the construction function
+    std::size_t retained_bytes() const noexcept;
+
+    //------------------------------------------------------------------------
+    // Private Member Types
+    //------------------------------------------------------------------------
+  private:
+
+    using base_type = detail::lazy_storage_t<T,CtorFunc,DtorFunc,Policy>;
+
+    using typename base_type::unqualified_pointer;
+    using typename base_type::storage_type;
+
+    //------------------------------------------------------------------------
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// \brief The operations that the state of the \p Policy uses to
+    ///        initialize a \c BasicLazy
+    ///
+    /// Policies that construct the \c T exclusively only use \c construct.
+    /// Policies that allow several threads to race on construction instead
+    /// construct a \c T in their own storage with \c construct_at, and then
+    /// either publish it with \c relocate_from, or discard it with
+    /// \c destroy_at.
+    ////////////////////////////////////////////////////////////////////////////
+    class initializer
+    {
+    public:
+
+      /// \brief Storage suitable for constructing a \c T in
+      using storage_type = typename this_type::storage_type;
+
+      /// \brief Constructs an \c initializer for \p lazy
+      ///
+      /// \param lazy the \c BasicLazy being initialized
+      explicit initializer( const this_type& lazy ) noexcept;
+
+      /// \brief Constructs the \c T in the \c BasicLazy
+      ///
+      /// \note This releases the construction function once the \c T has
+      ///       been constructed, so it may only be called by one thread at a
+      ///       time
+      void construct() const;
+
+      /// \brief Constructs a \c T at \p where, without consuming the
+      ///        construction function
+      ///
+      /// \note This may be called from several threads at once, provided
+      ///       the construction function may be
+      ///
+      /// \param where the address to construct the \c T at
+      void construct_at( void* where ) const;
+
+      /// \brief Moves the \c T at \p where into the \c BasicLazy, and
+      ///        destroys it
+      ///
+      /// \param where the address of the \c T constructed by \c construct_at
+      void relocate_from( void* where ) const;
+
+      /// \brief Destroys the \c T at \p where, invoking the destruction
+      ///        function first
+      ///
+      /// \param where the address of the \c T constructed by \c construct_at
+      void destroy_at( void* where ) const;
+
+    private:
+
+      const this_type& m_lazy; ///< The BasicLazy being initialized
+    };
+
+    //------------------------------------------------------------------------
+    // Private Members
+    //------------------------------------------------------------------------
+  private:
+
+    using base_type::m_state;
+    using base_type::m_functions;
+
+    //------------------------------------------------------------------------
+    // Private Member Functions
+    //------------------------------------------------------------------------
+  private:
+
+    using base_type::ptr;
+    using base_type::destruct;
+
+    /// \brief Initializes the \c BasicLazy, if it is not already initialized
+    ///
+    /// This is the hot path of every accessor, and is kept to a single
+    /// check of the initialized flag
+    void lazy_construct() const;
+
+    /// \brief Forcibly initializes the \c BasicLazy
+    ///
+    /// This is kept out-of-line and marked cold so that the construction
+    /// function is not inlined into (and does not bloat) every accessor
+    LAZY_NOINLINE LAZY_COLD void initialize() const;
+
+    /// \brief Constructs the \c T using a construction function that
+    ///        constructs directly into storage, releasing the function
+    ///        afterwards
+    ///
+    /// \param tag the tag for tag-dispatching
+    void construct_with_function( std::true_type tag ) const;
+
+    /// \brief Constructs the \c T using a construction function that returns
+    ///        a \c std::tuple of arguments
+    ///
+    /// \param tag the tag for tag-dispatching
+    void construct_with_function( std::false_type tag ) const;
+
+    /// \brief Constructs the \c T with a construction function that
+    ///        constructs directly into storage, releasing the function only
+    ///        if the \c T is not the sentinel value of the policy
+    ///
+    /// \param tag the tag for tag-dispatching
+    void consume_function( std::true_type tag ) const;
+
+    /// \brief Constructs the \c T with a construction function that
+    ///        constructs directly into storage, releasing the function
+    ///        afterwards
+    ///
+    /// \param tag the tag for tag-dispatching
+    void consume_function( std::false_type tag ) const;
+
+    /// \brief Constructs a \c T at \p where, without consuming a
+    ///        construction function that constructs directly into storage
+    ///
+    /// \param where the address to construct the \c T at
+    /// \param tag   the tag for tag-dispatching
+    void construct_with_function( void* where, std::true_type tag ) const;
+
+    /// \brief Constructs a \c T at \p where using a construction function
+    ///        that returns a \c std::tuple of arguments
+    ///
+    /// \param where the address to construct the \c T at
+    /// \param tag   the tag for tag-dispatching
+    void construct_with_function( void* where, std::false_type tag ) const;
+
+    /// \brief Gets the number of bytes retained by a construction function
+    ///        that constructs directly into storage
+    ///
+    /// \param tag the tag for tag-dispatching
+    std::size_t retained_bytes( std::true_type tag ) const noexcept;
+
+    /// \brief Gets the number of bytes retained by a construction function
+    ///        that returns a \c std::tuple of arguments
+    ///
+    /// \param tag the tag for tag-dispatching
+    std::size_t retained_bytes( std::false_type tag ) const noexcept;
+
+    /// \brief Constructs a \c BasicLazy object using \c T's copy constructor
+    ///
+    /// \param x Instance of \c T to copy.
+    void construct( const value_type& x ) const;
+
+    /// \brief Constructs a \c BasicLazy object using \c T's move constructor
+    ///
+    /// \param x Instance of rvalue \c T to copy
+    void construct( value_type&& x ) const;
+
+    /// \brief Constructs the \c T from \p x in the storage of a sentinel
+    ///        policy, in place of the sentinel
+    ///
+    /// \param x   the value to construct the \c T from
+    /// \param tag the tag for tag-dispatching
+    template<typename U>
+    void construct_value( U&& x, std::true_type tag ) const;
+
+    /// \brief Constructs the \c T from \p x in storage that holds no object
+    ///
+    /// \param x   the value to construct the \c T from
+    /// \param tag the tag for tag-dispatching
+    template<typename U>
+    void construct_value( U&& x, std::false_type tag ) const;
+
+    //------------------------------------------------------------------------
+
+    /// \brief Releases the construction function, if it supports being
+    ///        released
+    ///
+    /// \param tag the tag for tag-dispatching
+    void release_constructor( std::true_type tag ) const noexcept;
+
+    /// \brief Releases the construction function, if it supports being
+    ///        released
+    ///
+    /// \param tag the tag for tag-dispatching
+    void release_constructor( std::false_type tag ) const noexcept;
+
+    //------------------------------------------------------------------------
+
+    /// \brief Moves the initialized value of this \c BasicLazy into the
+    ///        uninitialized \p other, leaving this \c BasicLazy uninitialized
+    ///
+    /// \param other the \c BasicLazy to relocate the value to
+    void relocate( this_type& other ) const noexcept;
+
+    //------------------------------------------------------------------------
+
+    /// \brief Copy-assigns type at \c rhs
+    ///
+    /// \param rhs the value to assign
+    void assign( const value_type& rhs ) const noexcept( std::is_nothrow_copy_assignable<T>::value );
+
+    /// \brief Copy-assigns type at \c rhs
+    ///
+    /// \param rhs the value to assign
+    void assign( value_type&& rhs ) const noexcept( std::is_nothrow_move_assignable<T>::value );
+  };
+
+  //--------------------------------------------------------------------------
+  // Type Aliases
+  //--------------------------------------------------------------------------
+
+  /// \brief Lazy class used for lazy-loading any type
+  ///
+  /// The stored lazy-loaded class, \c T, will always be instantiated
+  /// before being accessed, and destructed when put out of scope.
+  ///
+  /// Unlike \c BasicLazy, the construction and destruction functions of a
+  /// \c Lazy are type-erased, so that any \c Lazy<T> may be constructed from
+  /// any construction function, a \c T, or a pack of \c T's constructor
+  /// arguments (through \c make_lazy).
+  ///
+  /// The construction and destruction functions share a single pointer to
+  /// their operations, and are stored along with any arguments captured for
+  /// them in an inline buffer of \c LAZY_DEFAULT_INLINE_BYTES bytes; see
+  /// \c InlineLazy for controlling the size of this buffer.
+  ///
+  /// The \p Policy selects how (and whether) the \c Lazy may be initialized
+  /// from multiple threads at once: \c single_threaded, \c double_checked,
+  /// \c call_once, or \c racy_idempotent.
+  ///
+  /// \tparam T      the type contained within this \c Lazy
+  /// \tparam Policy the threading policy to use for initialization
+  template<typename T, typename Policy = single_threaded>
+  using Lazy = BasicLazy<T,detail::erased_function<T>,detail::erased_function<T>,Policy>;
+
+  /// \brief A \c Lazy that reserves \c InlineBytes bytes for storing its
+  ///        construction function without allocating
+  ///
+  /// Construction functions (including the arguments captured by
+  /// \c make_lazy) that don't fit in \c InlineBytes are allocated on the heap,
+  /// or fail to compile if \c LAZY_NO_HEAP_FALLBACK is defined.
+  ///
+  /// \tparam T           the type contained within this \c InlineLazy
+  /// \tparam InlineBytes the number of bytes to reserve for the construction
+  ///                     function
+  template<typename T, std::size_t InlineBytes>
+  using InlineLazy = BasicLazy<T,detail::erased_function<T,InlineBytes>,detail::erased_function<T,InlineBytes>>;
+
+  /// \brief A \c Lazy that may be accessed from multiple threads at once
+  ///
+  /// Exactly one thread constructs the \c T, while any other threads
+  /// accessing it wait for construction to finish. Once initialized, each
+  /// access costs a single acquire load.
+  ///
+  /// \tparam T the type contained within this \c ConcurrentLazy
+  template<typename T>
+  using ConcurrentLazy = Lazy<T,double_checked>;
+
+  /// \brief An \c InlineLazy with the smallest possible footprint
+  ///
+  /// Only a single pointer's worth of state is kept inline, which holds
+  /// values and functions of up to pointer size (such as a captured
+  /// pointer, or a stored \c int) without allocating. Larger functions are
+  /// allocated on the heap.
+  ///
+  /// \tparam T the type contained within this \c CompactLazy
+  template<typename T>
+  using CompactLazy = InlineLazy<T,sizeof(void*)>;
+
+  //--------------------------------------------------------------------------
+  // Utilities
+  //--------------------------------------------------------------------------
+
+  /// \brief Convenience utility to construct a \c Lazy object by specifying
+  ///        \c T's constructor signature.
+  ///
+  /// The arguments are stored by copy until the object is constructed in order
+  /// to avoid dangling references.
+  ///
+  /// \param args the arguments to the constructor
+  /// \return an instance of the \c Lazy object
+  template<typename T, typename...Args>
+  Lazy<T> make_lazy( Args&&...args );
+
+  /// \brief Convenience utility to construct an \c InlineLazy object by
+  ///        specifying \c T's constructor signature.
+  ///
+  /// The arguments are stored by copy in an inline buffer of \c InlineBytes
+  /// bytes until the object is constructed, so that no allocations take place
+  /// if they fit.
+  ///
+  /// \param args the arguments to the constructor
+  /// \return an instance of the \c InlineLazy object
+  template<typename T, std::size_t InlineBytes, typename...Args>
+  InlineLazy<T,InlineBytes> make_lazy( Args&&...args );
+
+  /// \brief Convenience utility to construct a \c BasicLazy object from the
+  ///        given construction and destruction functions, deducing their
+  ///        types
+  ///
+  /// \note The \p constructor function must return a \c std::tuple containing
+  ///       the arguments to pass to \c T's constructor for lazy-construction
+  ///
+  /// \param constructor function to use for construction
+  /// \param destructor  function to use prior to destruction
+  /// \return an instance of the \c BasicLazy object
+  template<
+    typename T,
+    typename CtorFunc,
+    typename DtorFunc = default_destructor<T>,
+    typename = typename std::enable_if<detail::is_callable<detail::remove_cvref_t<CtorFunc>>::value>::type
+  >
+  BasicLazy<T,typename std::decay<CtorFunc>::type,typename std::decay<DtorFunc>::type>
+    make_basic_lazy( CtorFunc&& constructor, DtorFunc&& destructor = DtorFunc() );
+
+  /// \brief Implementation of \c swap for custom swapperations using ADL
+  ///
+  /// \param lhs the left-hand \c BasicLazy object
+  /// \param rhs the right-hand \c BasicLazy object
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  void swap(BasicLazy<T,CtorFunc,DtorFunc,Policy>& lhs,
+            BasicLazy<T,CtorFunc,DtorFunc,Policy>& rhs) noexcept;
+
+  //--------------------------------------------------------------------------
+  // Default Functions
+  //--------------------------------------------------------------------------
+
+  template<typename T>
+  inline std::tuple<> default_constructor<T>::operator()()
+    const noexcept
+  {
+    static_assert(std::is_default_constructible<T>::value,"No matching default constructor for type T");
+
+    return std::tuple<>();
   }
 
   template<typename T>
-  inline Lazy<T>::Lazy( value_type&& rhs )
-    : m_storage(),
-      m_is_initialized(false),
-      m_constructor([this,rhs](){this->construct(std::move(rhs));}),
-      m_destructor(default_destructor)
+  inline void default_destructor<T>::operator()( T& )
+    const noexcept
   {
-    static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
+
   }
 
+  //--------------------------------------------------------------------------
+  // Constructors / Destructor / Assignment
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  inline Lazy<T>::~Lazy()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline constexpr BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy()
+    : base_type()
   {
-    destruct();
+
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename Ctor, typename>
+  inline constexpr BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( Ctor&& constructor )
+    : base_type(static_cast<Ctor&&>(constructor))
+  {
+
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename Ctor, typename Dtor, typename, typename>
+  inline constexpr BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( Ctor&& constructor,
+                                                              Dtor&& destructor )
+    : base_type(static_cast<Ctor&&>(constructor),static_cast<Dtor&&>(destructor))
+  {
+
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( const this_type& rhs )
+    : base_type(rhs.m_functions)
+  {
+    static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
+
+    if(rhs.m_state.is_initialized())
+    {
+      construct(*rhs);
+    }
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( this_type&& rhs )
+    noexcept( std::is_nothrow_move_constructible<T>::value &&
+              std::is_nothrow_move_constructible<CtorFunc>::value &&
+              std::is_nothrow_move_constructible<DtorFunc>::value )
+    : base_type(std::move(rhs.m_functions))
+  {
+    static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
+
+    if(rhs.m_state.is_initialized())
+    {
+      construct(std::move(*rhs));
+    }
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( const value_type& rhs )
+    : base_type(CtorFunc(rhs))
+  {
+    static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::BasicLazy( value_type&& rhs )
+    : base_type(CtorFunc(std::move(rhs)))
+  {
+    static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
+    static_assert(std::is_copy_constructible<T>::value || !detail::races_construction<Policy>::value,
+                  "Racing to construct T from a stored value requires T to be copy-constructible");
   }
 
+
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  inline Lazy<T>& Lazy<T>::operator=( const this_type& rhs )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::this_type&
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator=( const this_type& rhs )
   {
     static_assert(std::is_copy_assignable<T>::value,"No matching copy assignment operator for type T");
     static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
 
-    if(rhs.m_is_initialized) {
-      lazy_construct();
-      assign(*rhs);
-    } else {
-      m_constructor = rhs.m_constructor;
+    if(rhs.m_state.is_initialized()) {
+      if(m_state.is_initialized()) {
+        assign(*rhs);
+      } else {
+        construct(*rhs);
+      }
+    }
+    m_functions = rhs.m_functions;
+
+    if(m_state.is_initialized()) {
+      release_constructor( detail::is_storage_constructor<CtorFunc>() );
     }
-    m_destructor  = rhs.m_destructor;
 
     return (*this);
   }
 
-  template<typename T>
-  inline typename Lazy<T>::this_type& Lazy<T>::operator=( this_type&& rhs )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::this_type&
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator=( this_type&& rhs )
+    noexcept( std::is_nothrow_move_constructible<T>::value &&
+              std::is_nothrow_move_assignable<T>::value &&
+              std::is_nothrow_move_assignable<CtorFunc>::value &&
+              std::is_nothrow_move_assignable<DtorFunc>::value )
   {
     static_assert(std::is_move_assignable<T>::value,"No matching move assignment operator for type T");
     static_assert(std::is_move_constructible<T>::value,"No matching move constructor for type T");
 
-    if(rhs.m_is_initialized) {
-      lazy_construct();
-      assign(std::move(*rhs));
-    } else {
-      m_constructor = std::move(rhs.m_constructor);
-      rhs.m_constructor = nullptr;
+    if(rhs.m_state.is_initialized()) {
+      if(m_state.is_initialized()) {
+        assign(std::move(*rhs.ptr()));
+      } else {
+        construct(std::move(*rhs.ptr()));
+      }
+    }
+    m_functions = std::move(rhs.m_functions);
+
+    if(m_state.is_initialized()) {
+      release_constructor( detail::is_storage_constructor<CtorFunc>() );
     }
-    m_destructor = std::move(rhs.m_destructor);
-    rhs.m_destructor = nullptr;
 
     return (*this);
   }
 
-  template<typename T>
-  inline typename Lazy<T>::value_type& Lazy<T>::operator=( const value_type& rhs )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::value_type&
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator=( const value_type& rhs )
   {
     static_assert(std::is_copy_assignable<T>::value,"No matching copy assignment operator for type T");
 
@@ -726,9 +3609,10 @@ namespace lazy{
     return *ptr();
   }
 
-  template<typename T>
-  inline typename Lazy<T>::value_type& Lazy<T>::operator=( value_type&& rhs )
- {
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::value_type&
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator=( value_type&& rhs )
+  {
     static_assert(std::is_move_assignable<T>::value,"No matching move assignment operator for type T");
 
     lazy_construct();
@@ -741,184 +3625,344 @@ namespace lazy{
   // Casting
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  inline Lazy<T>::operator reference()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator reference()
     const
   {
     lazy_construct();
     return *ptr();
   }
 
-  template<typename T>
-  inline Lazy<T>::operator bool()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator bool()
     const noexcept
   {
-    return m_is_initialized;
+    return m_state.is_initialized();
   }
 
   //--------------------------------------------------------------------------
   // Operators
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  inline void Lazy<T>::swap(Lazy<T>& rhs)
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::swap(this_type& rhs)
     noexcept
   {
     using std::swap; // for ADL
 
-    swap(m_constructor,rhs.m_constructor);
-    swap(m_destructor,rhs.m_destructor);
-    swap(m_is_initialized,rhs.m_is_initialized);
-    swap((*ptr()),(*rhs.ptr())); // Swap the values of the T types
+    m_functions.swap(rhs.m_functions);
+
+    if( m_state.is_initialized() && rhs.m_state.is_initialized() ) {
+      swap((*ptr()),(*rhs.ptr())); // Swap the values of the T types
+    } else if( m_state.is_initialized() ) {
+      relocate(rhs);
+    } else if( rhs.m_state.is_initialized() ) {
+      rhs.relocate(*this);
+    }
   }
 
-  template<typename T>
-  inline bool Lazy<T>::is_initialized()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline bool BasicLazy<T,CtorFunc,DtorFunc,Policy>::is_initialized()
     const noexcept
   {
-    return m_is_initialized;
+    return m_state.is_initialized();
   }
 
-  template<typename T>
-  inline typename Lazy<T>::pointer Lazy<T>::get()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::pointer
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::get()
     const
   {
     lazy_construct();
     return ptr();
   }
 
-  template<typename T>
-  inline typename Lazy<T>::reference Lazy<T>::operator*()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::pointer
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::try_get()
+    const noexcept
+  {
+    return m_state.is_initialized() ? ptr() : nullptr;
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::pointer
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::unchecked_get()
+    const noexcept
+  {
+    assert(m_state.is_initialized() && "unchecked_get() called on an uninitialized lazy");
+    return ptr();
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename U>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::value_type
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::value_or( U&& fallback )
+    const
+  {
+    static_assert(std::is_copy_constructible<T>::value,"No matching copy constructor for type T");
+    static_assert(std::is_convertible<U&&,T>::value,"Fallback value is not convertible to type T");
+
+    return m_state.is_initialized() ? *ptr() : static_cast<value_type>(std::forward<U>(fallback));
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::reference
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator*()
     const
   {
     lazy_construct();
     return *ptr();
   }
 
-  template<typename T>
-  inline typename Lazy<T>::pointer Lazy<T>::operator->()
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline typename BasicLazy<T,CtorFunc,DtorFunc,Policy>::pointer
+    BasicLazy<T,CtorFunc,DtorFunc,Policy>::operator->()
     const
   {
     lazy_construct();
     return ptr();
   }
 
-  //--------------------------------------------------------------------------
-  // Private Static Member Functions
-  //--------------------------------------------------------------------------
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename Executor>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::prefetch( Executor& executor )
+    const
+  {
+    static_assert(detail::is_thread_safe_policy<Policy>::value,"prefetch requires a thread-safe policy");
 
-  template<typename T>
-  inline void Lazy<T>::default_destructor(value_type&) noexcept{}
+    if( m_state.is_initialized() ) return;
+
+    executor.execute([this](){
+      try {
+        lazy_construct();
+      } catch( ... ) {
+        // The next access retries, or rethrows a cached failure
+      }
+    });
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline std::size_t BasicLazy<T,CtorFunc,DtorFunc,Policy>::retained_bytes()
+    const noexcept
+  {
+    return retained_bytes( detail::is_storage_constructor<CtorFunc>() );
+  }
 
   //--------------------------------------------------------------------------
-  // Private Constructors
+  // Initializer
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  template<typename...Args>
-  inline Lazy<T>::Lazy( ctor_va_args_tag, Args&&...args )
-    : m_is_initialized(false),
-      m_constructor([this,args...](){this->construct(ctor_va_args_tag(), std::move(args)...);}),
-      m_destructor(default_destructor)
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::initializer( const this_type& lazy )
+    noexcept
+    : m_lazy(lazy)
+  {
+
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::construct( )
+    const
+  {
+    m_lazy.construct_with_function( detail::is_storage_constructor<CtorFunc>() );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::construct_at( void* where )
+    const
+  {
+    m_lazy.construct_with_function( where, detail::is_storage_constructor<CtorFunc>() );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::relocate_from( void* where )
+    const
+  {
+    static_assert(std::is_move_constructible<T>::value,"Racing to construct T requires T to be move-constructible");
+
+    auto& source = *static_cast<unqualified_pointer>(where);
+
+    new (m_lazy.ptr()) value_type( std::move(source) );
+    source.~T();
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initializer::destroy_at( void* where )
+    const
   {
-    static_assert(std::is_constructible<T,Args...>::value, "No matching constructor for type T with given arguments");
+    auto& source = *static_cast<unqualified_pointer>(where);
+
+    m_lazy.m_functions.second()( source );
+    source.~T();
   }
 
   //--------------------------------------------------------------------------
   // Private Member Functions
   //--------------------------------------------------------------------------
 
-  template<typename T>
-  inline typename Lazy<T>::unqualified_pointer Lazy<T>::ptr()
-    const noexcept
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::lazy_construct( )
+    const
   {
-    // address-of idiom (https://en.wikibooks.org/wiki/More_C%2B%2B_Idioms/Address_Of)
-    return reinterpret_cast<unqualified_pointer>(& const_cast<char&>(reinterpret_cast<const volatile char &>(m_storage)));
+    if( LAZY_UNLIKELY(!m_state.is_initialized()) )
+    {
+      initialize();
+    }
   }
 
-  template<typename T>
-  inline void Lazy<T>::lazy_construct( )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  void BasicLazy<T,CtorFunc,DtorFunc,Policy>::initialize( )
+    const
+  {
+    m_state.initialize( initializer(*this) );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_with_function( std::true_type )
+    const
+  {
+    consume_function( detail::is_sentinel_policy<Policy>() );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::consume_function( std::true_type )
     const
   {
-    if( !m_is_initialized )
+    // A T constructed as the sentinel leaves the BasicLazy uninitialized, so
+    // the arguments are kept for the next attempt
+    m_functions.first().construct( ptr() );
+    if( m_state.is_initialized() )
     {
-      m_constructor();
-      m_is_initialized = true;
+      release_constructor( std::true_type() );
     }
   }
 
-  template<typename T>
-  inline void Lazy<T>::construct( const value_type& x )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::consume_function( std::false_type )
     const
   {
-    destruct();
-    new (ptr()) value_type( x );
-    m_is_initialized = true;
+    // The arguments are no longer needed once the T is constructed
+    m_functions.first().consume( ptr() );
   }
 
-  template<typename T>
-  inline void Lazy<T>::construct( value_type&& x )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_with_function( std::false_type )
     const
   {
-    destruct();
-    new (ptr()) value_type( std::forward<value_type>(x) );
-    m_is_initialized = true;
+    detail::construct_from_function<T>( ptr(), m_functions.first() );
   }
 
-  template<typename T>
-  template<typename...Args>
-  inline void Lazy<T>::construct( ctor_va_args_tag, Args&&...args )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_with_function( void* where, std::true_type )
+    const
+  {
+    // The stored function is shared with any other threads constructing
+    // concurrently, so it is only read from, and never consumed
+    m_functions.first().construct( where );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_with_function( void* where, std::false_type )
+    const
+  {
+    detail::construct_from_function<T>( where, m_functions.first() );
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline std::size_t BasicLazy<T,CtorFunc,DtorFunc,Policy>::retained_bytes( std::true_type )
+    const noexcept
+  {
+    return m_functions.first().retained_bytes();
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline std::size_t BasicLazy<T,CtorFunc,DtorFunc,Policy>::retained_bytes( std::false_type )
+    const noexcept
+  {
+    return std::is_empty<CtorFunc>::value ? 0 : sizeof(CtorFunc);
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct( const value_type& x )
     const
   {
     destruct();
-    new (ptr()) value_type( std::forward<Args>(args)... );
-    m_is_initialized = true;
+    construct_value( x, detail::is_sentinel_policy<Policy>() );
+    m_state.set_initialized(true);
   }
 
-  template<typename T>
-  template<typename...Args>
-  inline void Lazy<T>::construct( const std::tuple<Args...>& args )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct( value_type&& x )
     const
   {
     destruct();
-    tuple_construct(args,detail::index_sequence_for<Args...>());
-    m_is_initialized = true;
+    construct_value( std::forward<value_type>(x), detail::is_sentinel_policy<Policy>() );
+    m_state.set_initialized(true);
   }
 
-  template<typename T>
-  template<typename...Args, std::size_t...Ints>
-  inline void Lazy<T>::tuple_construct(const std::tuple<Args...>& args,
-                                       const detail::index_sequence<Ints...>& )
-    const noexcept( std::is_nothrow_constructible<T,Args...>::value )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename U>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_value( U&& x, std::true_type )
+    const
+  {
+    // The sentinel is destroyed before the T takes its place, and is put
+    // back if constructing the T throws
+    m_state.clear();
+    try {
+      new (ptr()) value_type( std::forward<U>(x) );
+    } catch( ... ) {
+      m_state.set_initialized(false);
+      throw;
+    }
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  template<typename U>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::construct_value( U&& x, std::false_type )
+    const
   {
-    static_assert(std::is_constructible<T,Args...>::value,"No matching constructor for type T with given arguments");
+    new (ptr()) value_type( std::forward<U>(x) );
+  }
 
-    new (ptr()) T( std::get<Ints>(args)... );
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::release_constructor( std::true_type )
+    const noexcept
+  {
+    m_functions.first().release();
   }
 
-  template<typename T>
-  inline void Lazy<T>::destruct( ) const
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::release_constructor( std::false_type )
+    const noexcept
   {
-    if( m_is_initialized )
-    {
-      if( m_destructor )
-      {
-        m_destructor(*ptr());
-      }
-      ptr()->~T();
-      m_is_initialized = false;
-    }
+
   }
 
-  template<typename T>
-  inline void Lazy<T>::assign( const value_type& rhs )
+  //--------------------------------------------------------------------------
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::relocate( this_type& other )
+    const noexcept
+  {
+    other.construct_value( std::move(*ptr()), detail::is_sentinel_policy<Policy>() );
+    other.m_state.set_initialized(true);
+
+    // The value now belongs to 'other', so only the moved-from T is
+    // destroyed here; the destruction function must not run on it
+    ptr()->~T();
+    m_state.set_initialized(false);
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::assign( const value_type& rhs )
     const noexcept( std::is_nothrow_copy_assignable<T>::value )
   {
     (*ptr()) = rhs;
   }
 
-  template<typename T>
-  inline void Lazy<T>::assign( value_type&& rhs )
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  inline void BasicLazy<T,CtorFunc,DtorFunc,Policy>::assign( value_type&& rhs )
     const noexcept( std::is_nothrow_move_assignable<T>::value )
   {
     (*ptr()) = std::forward<value_type>(rhs);
@@ -931,11 +3975,29 @@ namespace lazy{
   template<typename T, typename...Args>
   Lazy<T> make_lazy(Args&&...args)
   {
-    return Lazy<T>(typename Lazy<T>::ctor_va_args_tag(), std::forward<Args>(args)...);
+    return Lazy<T>(detail::erased_function<T>(detail::ctor_va_args_tag(), std::forward<Args>(args)...));
   }
 
-  template<typename T>
-  void swap(Lazy<T>& lhs, Lazy<T>& rhs) noexcept
+  template<typename T, std::size_t InlineBytes, typename...Args>
+  InlineLazy<T,InlineBytes> make_lazy(Args&&...args)
+  {
+    using constructor_type = detail::erased_function<T,InlineBytes>;
+
+    return InlineLazy<T,InlineBytes>(constructor_type(detail::ctor_va_args_tag(), std::forward<Args>(args)...));
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename>
+  BasicLazy<T,typename std::decay<CtorFunc>::type,typename std::decay<DtorFunc>::type>
+    make_basic_lazy( CtorFunc&& constructor, DtorFunc&& destructor )
+  {
+    using result_type = BasicLazy<T,typename std::decay<CtorFunc>::type,typename std::decay<DtorFunc>::type>;
+
+    return result_type(std::forward<CtorFunc>(constructor),std::forward<DtorFunc>(destructor));
+  }
+
+  template<typename T, typename CtorFunc, typename DtorFunc, typename Policy>
+  void swap(BasicLazy<T,CtorFunc,DtorFunc,Policy>& lhs,
+            BasicLazy<T,CtorFunc,DtorFunc,Policy>& rhs) noexcept
   {
     lhs.swap(rhs);
   }
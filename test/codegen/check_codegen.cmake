@@ -0,0 +1,43 @@
+# Checks the steady-state access path of functions in an assembly listing
+#
+# The fast path of each function (the instructions up to its first return)
+# must contain no calls, and no more than MAX_INSTRUCTIONS instructions.
+#
+# Usage:
+#   cmake -DASSEMBLY=<file.s> -DFUNCTIONS=<name;...> -DMAX_INSTRUCTIONS=<n>
+#         -P check_codegen.cmake
+
+file(STRINGS "${ASSEMBLY}" lines)
+
+foreach(function ${FUNCTIONS})
+  set(in_function FALSE)
+  set(found FALSE)
+  set(count 0)
+
+  foreach(line IN LISTS lines)
+    if(NOT in_function)
+      if(line MATCHES "^_?${function}:")
+        set(in_function TRUE)
+        set(found TRUE)
+      endif()
+    elseif(line MATCHES "^[ \t]+[a-z]")
+      # Instructions are indented and begin with a lowercase mnemonic;
+      # assembler directives begin with '.'
+      math(EXPR count "${count} + 1")
+      if(line MATCHES "^[ \t]+(call|bl)[ \t]")
+        message(FATAL_ERROR "${function}: fast path calls a function:\n${line}")
+      endif()
+      if(line MATCHES "^[ \t]+retq?([ \t]|$)")
+        break()
+      endif()
+    endif()
+  endforeach()
+
+  if(NOT found)
+    message(FATAL_ERROR "${function}: not found in ${ASSEMBLY}")
+  endif()
+  if(count GREATER MAX_INSTRUCTIONS)
+    message(FATAL_ERROR "${function}: fast path is ${count} instructions (max ${MAX_INSTRUCTIONS})")
+  endif()
+  message(STATUS "${function}: fast path is ${count} instructions")
+endforeach()
@@ -0,0 +1,31 @@
+/**
+ * \file lazy_access.cpp
+ *
+ * \brief Accessors compiled by the codegen test, to check that steady-state
+ *        access to a Lazy is only a few instructions
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include <lazy/Lazy.hpp>
+
+#include <string>
+
+extern "C" int lazy_access_int( const lazy::Lazy<int>& lazy )
+{
+  return *lazy;
+}
+
+extern "C" std::size_t lazy_access_string( const lazy::Lazy<std::string>& lazy )
+{
+  return lazy->size();
+}
+
+extern "C" int lazy_unchecked_access_int( const lazy::Lazy<int>& lazy )
+{
+  return *lazy.unchecked_get();
+}
+
+extern "C" int concurrent_lazy_access_int( const lazy::ConcurrentLazy<int>& lazy )
+{
+  return *lazy;
+}
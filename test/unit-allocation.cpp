@@ -0,0 +1,100 @@
+/**
+ * \file unit-allocation.cpp
+ *
+ * \brief Catch unit tests for the allocation behavior of Lazy
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+namespace {
+
+  std::atomic<std::size_t> g_allocations(0);
+
+  struct payload
+  {
+    explicit payload( const char(&)[48] ){}
+  };
+
+} // anonymous namespace
+
+void* operator new( std::size_t size )
+{
+  ++g_allocations;
+  if( auto p = std::malloc(size ? size : 1) ) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete( void* p ) noexcept
+{
+  std::free(p);
+}
+
+void operator delete( void* p, std::size_t ) noexcept
+{
+  std::free(p);
+}
+
+TEST_CASE("allocation")
+{
+  SECTION("make_lazy<T>(args...)")
+  {
+    SECTION("does not allocate for small arguments")
+    {
+      auto before      = g_allocations.load();
+      auto lazy_string = lazy::make_lazy<std::string>("hello",5);
+      auto after       = g_allocations.load();
+
+      REQUIRE( before == after );
+    }
+
+    SECTION("allocates for arguments that don't fit inline")
+    {
+      const char buffer[48] = {};
+
+      auto before       = g_allocations.load();
+      auto lazy_payload = lazy::make_lazy<payload>(buffer);
+      auto after        = g_allocations.load();
+
+      REQUIRE( before != after );
+    }
+  }
+
+
+  SECTION("make_lazy<T,InlineBytes>(args...)")
+  {
+    SECTION("does not allocate for arguments that fit inline")
+    {
+      const char buffer[48] = {};
+
+      auto before       = g_allocations.load();
+      auto lazy_payload = lazy::make_lazy<payload,64>(buffer);
+      auto copy         = lazy_payload;
+      auto after        = g_allocations.load();
+
+      REQUIRE( before == after );
+    }
+  }
+
+
+  SECTION("Lazy<T>(const T&)")
+  {
+    SECTION("does not allocate for small values")
+    {
+      auto value = 42;
+
+      auto before   = g_allocations.load();
+      auto lazy_int = lazy::Lazy<int>(value);
+      auto after    = g_allocations.load();
+
+      REQUIRE( before == after );
+      REQUIRE( *lazy_int == 42 );
+    }
+  }
+}
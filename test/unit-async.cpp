@@ -0,0 +1,351 @@
+/**
+ * \file unit-async.cpp
+ *
+ * \brief Catch unit tests for constructing the value of an AsyncLazy on an
+ *        executor
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+#include <lazy/AsyncLazy.hpp>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  const auto thread_count = 8;
+
+  /// An executor that runs each task immediately, on the calling thread
+  struct inline_executor
+  {
+    template<typename Function>
+    void execute( Function&& function )
+    {
+      ++tasks;
+      function();
+    }
+
+    int tasks = 0;
+  };
+
+  /// An executor that runs each task on a new thread
+  struct thread_executor
+  {
+    ~thread_executor()
+    {
+      for( auto& thread : threads ) {
+        thread.join();
+      }
+    }
+
+    template<typename Function>
+    void execute( Function&& function )
+    {
+      threads.emplace_back(std::forward<Function>(function));
+    }
+
+    std::vector<std::thread> threads;
+  };
+
+  /// An executor that refuses every task
+  struct full_executor
+  {
+    template<typename Function>
+    void execute( Function&& )
+    {
+      throw std::runtime_error("full");
+    }
+  };
+
+  /// An executor that keeps each task until it is run
+  struct queued_executor
+  {
+    template<typename Function>
+    void execute( Function&& function )
+    {
+      tasks.emplace_back(std::forward<Function>(function));
+    }
+
+    void run()
+    {
+      for( auto& task : tasks ) {
+        task();
+      }
+      tasks.clear();
+    }
+
+    std::vector<std::function<void()>> tasks;
+  };
+
+#if LAZY_HAS_COROUTINES
+
+  /// A coroutine that runs eagerly, and is never awaited
+  struct detached_task
+  {
+    struct promise_type
+    {
+      detached_task get_return_object() noexcept{ return {}; }
+      std::suspend_never initial_suspend() noexcept{ return {}; }
+      std::suspend_never final_suspend() noexcept{ return {}; }
+      void return_void() noexcept{}
+      void unhandled_exception() noexcept{ std::terminate(); }
+    };
+  };
+
+  detached_task await_value( const lazy::AsyncLazy<int>& lazy, int& result )
+  {
+    result = co_await lazy;
+  }
+
+  detached_task await_exception( const lazy::AsyncLazy<int>& lazy, bool& caught )
+  {
+    try {
+      co_await lazy;
+    } catch( const std::runtime_error& ) {
+      caught = true;
+    }
+  }
+
+#endif
+
+} // anonymous namespace
+
+TEST_CASE("async")
+{
+  SECTION("AsyncLazy<T>(Executor&)")
+  {
+    SECTION("does not start construction")
+    {
+      inline_executor executor;
+      lazy::AsyncLazy<std::string> lazy_string(executor);
+
+      REQUIRE( executor.tasks == 0 );
+      REQUIRE_FALSE( lazy_string.is_ready() );
+    }
+
+    SECTION("default-constructs the value")
+    {
+      inline_executor executor;
+      lazy::AsyncLazy<std::string> lazy_string(executor);
+
+      REQUIRE( lazy_string.get() == "" );
+    }
+  }
+
+
+  SECTION("AsyncLazy<T>(Executor&,Func)")
+  {
+    SECTION("constructs on the executor once")
+    {
+      inline_executor executor;
+      lazy::AsyncLazy<std::string> lazy_string(executor,[](){
+        return std::make_tuple(3,'a');
+      });
+
+      lazy_string.start();
+      lazy_string.start();
+
+      REQUIRE( executor.tasks == 1 );
+      REQUIRE( lazy_string.is_ready() );
+      REQUIRE( lazy_string.get() == "aaa" );
+      REQUIRE( lazy_string.get_future().get() == "aaa" );
+      REQUIRE( executor.tasks == 1 );
+    }
+
+    SECTION("starts construction on get_future")
+    {
+      thread_executor executor;
+      std::promise<void> release;
+      auto released = release.get_future().share();
+
+      lazy::AsyncLazy<int> lazy_int(executor,[released](){
+        released.wait();
+        return std::make_tuple(42);
+      });
+
+      auto future = lazy_int.get_future();
+
+      REQUIRE( executor.threads.size() == 1u );
+      REQUIRE_FALSE( lazy_int.is_ready() );
+
+      release.set_value();
+
+      REQUIRE( future.get() == 42 );
+      REQUIRE( &future.get() == &lazy_int.get() );
+    }
+
+    SECTION("gives every thread the same value")
+    {
+      thread_executor executor;
+      std::atomic<int> constructions(0);
+
+      lazy::AsyncLazy<int> lazy_int(executor,[&constructions](){
+        return std::make_tuple(++constructions);
+      });
+
+      std::atomic<int> ready(0);
+      std::vector<int*> values(thread_count);
+      auto threads = std::vector<std::thread>();
+      for( auto i = 0; i < thread_count; ++i ) {
+        threads.emplace_back([&,i](){
+          ++ready;
+          while( ready < thread_count ) {
+            std::this_thread::yield();
+          }
+          values[i] = &lazy_int.get();
+        });
+      }
+      for( auto& thread : threads ) {
+        thread.join();
+      }
+
+      REQUIRE( constructions == 1 );
+      REQUIRE( executor.threads.size() == 1u );
+      for( auto value : values ) {
+        REQUIRE( value == &lazy_int.get() );
+      }
+    }
+
+    SECTION("rethrows the exception from construction")
+    {
+      inline_executor executor;
+      lazy::AsyncLazy<int> lazy_int(executor,[]() -> std::tuple<int> {
+        throw std::runtime_error("failed");
+      });
+
+      REQUIRE_THROWS_AS( lazy_int.get(), const std::runtime_error& );
+      REQUIRE_THROWS_AS( lazy_int.get(), const std::runtime_error& );
+      REQUIRE( executor.tasks == 1 );
+    }
+
+    SECTION("rethrows the exception from the executor")
+    {
+      full_executor executor;
+      lazy::AsyncLazy<int> lazy_int(executor,[](){
+        return std::make_tuple(42);
+      });
+
+      lazy_int.start();
+
+      REQUIRE( lazy_int.is_ready() );
+      REQUIRE_THROWS_AS( lazy_int.get(), const std::runtime_error& );
+      REQUIRE_THROWS_AS( lazy_int.get_future().get(), const std::runtime_error& );
+    }
+  }
+
+
+  SECTION("AsyncLazy<T>(Executor&,Func,Func)")
+  {
+    SECTION("destroys the value once")
+    {
+      auto destructions = 0;
+      {
+        thread_executor executor;
+        lazy::AsyncLazy<int> lazy_int(executor,[](){
+          return std::make_tuple(42);
+        },[&destructions](int&){
+          ++destructions;
+        });
+
+        lazy_int.start();
+      }
+
+      REQUIRE( destructions == 1 );
+    }
+
+    SECTION("destroys nothing if never started")
+    {
+      auto destructions = 0;
+      {
+        inline_executor executor;
+        lazy::AsyncLazy<int> lazy_int(executor,[](){
+          return std::make_tuple(42);
+        },[&destructions](int&){
+          ++destructions;
+        });
+      }
+
+      REQUIRE( destructions == 0 );
+    }
+  }
+
+
+  SECTION("AsyncLazy<T>(Executor&,const T&)")
+  {
+    SECTION("copies the value")
+    {
+      inline_executor executor;
+      lazy::AsyncLazy<std::string> lazy_string(executor,std::string("aaa"));
+
+      REQUIRE( lazy_string.get() == "aaa" );
+    }
+  }
+
+
+#if LAZY_HAS_COROUTINES
+
+  SECTION("co_await AsyncLazy<T>")
+  {
+    SECTION("completes immediately if constructed")
+    {
+      inline_executor executor;
+      lazy::AsyncLazy<int> lazy_int(executor,[](){
+        return std::make_tuple(42);
+      });
+      lazy_int.start();
+
+      auto result = 0;
+      await_value(lazy_int,result);
+
+      REQUIRE( result == 42 );
+      REQUIRE( executor.tasks == 1 );
+    }
+
+    SECTION("resumes every awaiter once constructed")
+    {
+      queued_executor executor;
+      lazy::AsyncLazy<int> lazy_int(executor,[](){
+        return std::make_tuple(42);
+      });
+
+      auto first  = 0;
+      auto second = 0;
+      await_value(lazy_int,first);
+      await_value(lazy_int,second);
+
+      REQUIRE( first == 0 );
+      REQUIRE( second == 0 );
+      REQUIRE( executor.tasks.size() == 1u );
+
+      executor.run();
+
+      REQUIRE( first == 42 );
+      REQUIRE( second == 42 );
+    }
+
+    SECTION("rethrows the exception from construction")
+    {
+      queued_executor executor;
+      lazy::AsyncLazy<int> lazy_int(executor,[]() -> std::tuple<int> {
+        throw std::runtime_error("failed");
+      });
+
+      auto caught = false;
+      await_exception(lazy_int,caught);
+      executor.run();
+
+      REQUIRE( caught );
+    }
+  }
+
+#endif
+}
@@ -0,0 +1,500 @@
+/**
+ * \file unit-concurrency.cpp
+ *
+ * \brief Catch unit tests for initializing a ConcurrentLazy from multiple
+ *        threads
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+// std::call_once deadlocks if its function throws when built with
+// ThreadSanitizer, or with libstdc++ before GCC 11
+#if defined(__SANITIZE_THREAD__)
+# define LAZY_TEST_CALL_ONCE_RETRIES 0
+#elif defined(__has_feature)
+# if __has_feature(thread_sanitizer)
+#  define LAZY_TEST_CALL_ONCE_RETRIES 0
+# endif
+#endif
+#if !defined(LAZY_TEST_CALL_ONCE_RETRIES)
+# if defined(__GLIBCXX__) && (!defined(_GLIBCXX_RELEASE) || _GLIBCXX_RELEASE < 11)
+#  define LAZY_TEST_CALL_ONCE_RETRIES 0
+# else
+#  define LAZY_TEST_CALL_ONCE_RETRIES 1
+# endif
+#endif
+
+namespace {
+
+  /// Runs \p function on \p thread_count threads, all starting at once
+  template<typename Function>
+  void run_concurrently( int thread_count, Function function )
+  {
+    std::atomic<int> ready(0);
+    auto threads = std::vector<std::thread>();
+
+    for( auto i = 0; i < thread_count; ++i ) {
+      threads.emplace_back([&ready,&function,thread_count](){
+        ++ready;
+        while( ready.load() < thread_count ) {
+          std::this_thread::yield();
+        }
+        function();
+      });
+    }
+    for( auto& thread : threads ) {
+      thread.join();
+    }
+  }
+
+  /// Runs \p function on 8 threads, all starting at once
+  template<typename Function>
+  void run_concurrently( Function function )
+  {
+    run_concurrently(8,function);
+  }
+
+  /// A string whose first move throws, after a delay
+  struct fragile_move
+  {
+    fragile_move( std::string value, std::atomic<int>* moves )
+      : value(std::move(value)),
+        moves(moves)
+    {
+
+    }
+
+    fragile_move( fragile_move&& other )
+      : value(other.value),
+        moves(other.moves)
+    {
+      if( (*moves)++ == 0 ) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        throw std::runtime_error("first move");
+      }
+    }
+
+    std::string       value;
+    std::atomic<int>* moves;
+  };
+
+  /// A ConcurrentLazy whose waiting threads park immediately
+  template<typename T>
+  using ParkingLazy = lazy::BasicLazy<T,lazy::detail::erased_function<T>,lazy::detail::erased_function<T>,lazy::basic_double_checked<0>>;
+
+  /// An executor that runs each task immediately, on the calling thread
+  struct inline_executor
+  {
+    template<typename Function>
+    void execute( Function&& function )
+    {
+      ++tasks;
+      function();
+    }
+
+    int tasks = 0;
+  };
+
+  /// An executor that runs each task on a new thread
+  struct thread_executor
+  {
+    ~thread_executor()
+    {
+      for( auto& thread : threads ) {
+        thread.join();
+      }
+    }
+
+    template<typename Function>
+    void execute( Function&& function )
+    {
+      threads.emplace_back(std::forward<Function>(function));
+    }
+
+    std::vector<std::thread> threads;
+  };
+
+} // anonymous namespace
+
+TEST_CASE("concurrency")
+{
+  SECTION("ConcurrentLazy<T>(Func)")
+  {
+    SECTION("constructs exactly once when accessed concurrently")
+    {
+      std::atomic<int> constructions(0);
+      auto lazy_string = lazy::ConcurrentLazy<std::string>([&constructions](){
+        ++constructions;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      std::atomic<int> mismatches(0);
+      run_concurrently([&](){
+        if( *lazy_string != "aaaaa" ) ++mismatches;
+      });
+
+      REQUIRE( constructions == 1 );
+      REQUIRE( mismatches == 0 );
+    }
+
+    SECTION("retries construction after an exception")
+    {
+      std::atomic<int> attempts(0);
+      auto lazy_string = lazy::ConcurrentLazy<std::string>([&attempts](){
+        if( ++attempts == 1 ) throw std::runtime_error("first attempt");
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      std::atomic<int> failures(0);
+      run_concurrently([&](){
+        try {
+          *lazy_string;
+        } catch( const std::runtime_error& ) {
+          ++failures;
+        }
+      });
+
+      REQUIRE( failures == 1 );
+      REQUIRE( attempts == 2 );
+      REQUIRE( *lazy_string == "aaaaa" );
+    }
+  }
+
+
+  SECTION("ConcurrentLazy<T>(Func) with many waiting threads")
+  {
+    SECTION("constructs exactly once when waiting threads spin and park")
+    {
+      std::atomic<int> constructions(0);
+      auto lazy_string = lazy::ConcurrentLazy<std::string>([&constructions](){
+        ++constructions;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      std::atomic<int> mismatches(0);
+      run_concurrently(64,[&](){
+        if( *lazy_string != "aaaaa" ) ++mismatches;
+      });
+
+      REQUIRE( constructions == 1 );
+      REQUIRE( mismatches == 0 );
+    }
+
+    SECTION("wakes parked threads after an exception")
+    {
+      std::atomic<int> attempts(0);
+      auto lazy_string = ParkingLazy<std::string>([&attempts](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        if( ++attempts == 1 ) throw std::runtime_error("first attempt");
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      std::atomic<int> failures(0);
+      run_concurrently(64,[&](){
+        try {
+          *lazy_string;
+        } catch( const std::runtime_error& ) {
+          ++failures;
+        }
+      });
+
+      REQUIRE( failures == 1 );
+      REQUIRE( attempts == 2 );
+    }
+  }
+
+
+  SECTION("Lazy<T,call_once>(Func)")
+  {
+    SECTION("constructs exactly once when accessed concurrently")
+    {
+      std::atomic<int> constructions(0);
+      auto lazy_string = lazy::Lazy<std::string,lazy::call_once>([&constructions](){
+        ++constructions;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      std::atomic<int> mismatches(0);
+      run_concurrently([&](){
+        if( *lazy_string != "aaaaa" ) ++mismatches;
+      });
+
+      REQUIRE( constructions == 1 );
+      REQUIRE( mismatches == 0 );
+    }
+
+#if LAZY_TEST_CALL_ONCE_RETRIES
+    SECTION("retries construction after an exception")
+    {
+      std::atomic<int> attempts(0);
+      auto lazy_string = lazy::Lazy<std::string,lazy::call_once>([&attempts](){
+        if( ++attempts == 1 ) throw std::runtime_error("first attempt");
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      REQUIRE_THROWS_AS( *lazy_string, const std::runtime_error& );
+      REQUIRE( *lazy_string == "aaaaa" );
+      REQUIRE( attempts == 2 );
+    }
+#endif
+
+    SECTION("constructs again after being reset")
+    {
+      std::atomic<int> constructions(0);
+      auto create_string = [&constructions](){
+        ++constructions;
+        return std::make_tuple(std::size_t(5),'a');
+      };
+      auto lazy_string = lazy::Lazy<std::string,lazy::call_once>(create_string);
+      auto uninitialized = lazy::Lazy<std::string,lazy::call_once>(create_string);
+
+      *lazy_string;
+      lazy_string.swap(uninitialized);
+
+      REQUIRE_FALSE( lazy_string.is_initialized() );
+      REQUIRE( *lazy_string == "aaaaa" );
+      REQUIRE( constructions == 2 );
+    }
+  }
+
+
+  SECTION("Lazy<T,racy_idempotent>(Func,Func)")
+  {
+    SECTION("publishes one value, and destroys the others")
+    {
+      std::atomic<int> constructions(0);
+      std::atomic<int> destructions(0);
+      auto lazy_string = lazy::Lazy<std::string,lazy::racy_idempotent>([&constructions](){
+        ++constructions;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return std::make_tuple(std::size_t(5),'a');
+      },[&destructions](std::string&){
+        ++destructions;
+      });
+
+      std::atomic<int> mismatches(0);
+      run_concurrently([&](){
+        if( *lazy_string != "aaaaa" ) ++mismatches;
+      });
+
+      REQUIRE( constructions >= 1 );
+      REQUIRE( destructions == constructions - 1 );
+      REQUIRE( mismatches == 0 );
+    }
+
+    SECTION("is left uninitialized after an exception")
+    {
+      std::atomic<int> attempts(0);
+      auto lazy_string = lazy::Lazy<std::string,lazy::racy_idempotent>([&attempts](){
+        if( ++attempts == 1 ) throw std::runtime_error("first attempt");
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      REQUIRE_THROWS_AS( *lazy_string, const std::runtime_error& );
+      REQUIRE_FALSE( lazy_string.is_initialized() );
+      REQUIRE( *lazy_string == "aaaaa" );
+    }
+
+    SECTION("publishes another value if moving the winning value throws")
+    {
+      std::atomic<int> moves(0);
+      auto lazy_value = lazy::Lazy<fragile_move,lazy::racy_idempotent>([&moves](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return std::make_tuple(std::string("hello"),&moves);
+      });
+
+      std::atomic<int> failures(0);
+      std::atomic<int> mismatches(0);
+      run_concurrently([&](){
+        try {
+          if( lazy_value->value != "hello" ) ++mismatches;
+        } catch( const std::runtime_error& ) {
+          ++failures;
+        }
+      });
+
+      REQUIRE( failures == 1 );
+      REQUIRE( mismatches == 0 );
+      REQUIRE( lazy_value.is_initialized() );
+    }
+  }
+
+
+  SECTION("Lazy<T,racy_idempotent>(args...)")
+  {
+    SECTION("keeps the arguments for other threads")
+    {
+      auto lazy_string = lazy::Lazy<std::string,lazy::racy_idempotent>(std::string("hello"));
+
+      std::atomic<int> mismatches(0);
+      run_concurrently([&](){
+        if( *lazy_string != "hello" ) ++mismatches;
+      });
+
+      REQUIRE( mismatches == 0 );
+    }
+  }
+
+
+  SECTION("Lazy<T,cache_failures<double_checked,...>>(Func)")
+  {
+    SECTION("rethrows a cached exception without constructing again")
+    {
+      std::atomic<int> attempts(0);
+      auto lazy_string = lazy::Lazy<std::string,lazy::cache_failures<lazy::double_checked,60000>>([&attempts](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ++attempts;
+        throw std::runtime_error("resource unavailable");
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      std::atomic<int> failures(0);
+      run_concurrently(64,[&](){
+        try {
+          *lazy_string;
+        } catch( const std::runtime_error& ) {
+          ++failures;
+        }
+      });
+
+      REQUIRE( failures == 64 );
+      REQUIRE( attempts == 1 );
+      REQUIRE_FALSE( lazy_string.is_initialized() );
+    }
+
+    SECTION("retries construction once the delay has passed")
+    {
+      auto attempts = 0;
+      auto lazy_string = lazy::Lazy<std::string,lazy::cache_failures<lazy::double_checked,1>>([&attempts](){
+        if( ++attempts == 1 ) throw std::runtime_error("first attempt");
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      REQUIRE_THROWS_AS( *lazy_string, const std::runtime_error& );
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+      REQUIRE( *lazy_string == "aaaaa" );
+      REQUIRE( attempts == 2 );
+    }
+
+    SECTION("doubles the delay after each consecutive failure")
+    {
+      auto attempts = 0;
+      auto lazy_int = lazy::Lazy<int,lazy::cache_failures<lazy::double_checked,200,10000>>([&attempts](){
+        ++attempts;
+        throw std::runtime_error("resource unavailable");
+        return std::make_tuple(0);
+      });
+
+      REQUIRE_THROWS_AS( *lazy_int, const std::runtime_error& );
+      std::this_thread::sleep_for(std::chrono::milliseconds(250));
+      REQUIRE_THROWS_AS( *lazy_int, const std::runtime_error& ); // retried; now cached for 400ms
+      std::this_thread::sleep_for(std::chrono::milliseconds(250));
+      REQUIRE_THROWS_AS( *lazy_int, const std::runtime_error& );
+
+      REQUIRE( attempts == 2 );
+    }
+  }
+
+
+  SECTION("Lazy<T,cache_failures<racy_idempotent,...>>(Func)")
+  {
+    SECTION("rethrows a cached exception without constructing again")
+    {
+      std::atomic<int> attempts(0);
+      auto lazy_int = lazy::Lazy<int,lazy::cache_failures<lazy::racy_idempotent,60000>>([&attempts](){
+        ++attempts;
+        throw std::runtime_error("resource unavailable");
+        return std::make_tuple(0);
+      });
+
+      REQUIRE_THROWS_AS( *lazy_int, const std::runtime_error& );
+      REQUIRE_THROWS_AS( *lazy_int, const std::runtime_error& );
+
+      REQUIRE( attempts == 1 );
+    }
+  }
+
+
+  SECTION("ConcurrentLazy<T>::prefetch(Executor&)")
+  {
+    SECTION("joins the construction started on the executor")
+    {
+      std::atomic<int>  constructions(0);
+      std::atomic<bool> released(false);
+      auto lazy_string = lazy::ConcurrentLazy<std::string>([&](){
+        ++constructions;
+        while( !released ) {
+          std::this_thread::yield();
+        }
+        return std::make_tuple("hello world");
+      });
+      thread_executor executor; // joined before lazy_string is destroyed
+
+      lazy_string.prefetch(executor);
+      while( constructions == 0 ) {
+        std::this_thread::yield();
+      }
+
+      auto accessor = std::thread([&](){
+        *lazy_string;
+      });
+      released = true;
+      accessor.join();
+
+      REQUIRE( *lazy_string == "hello world" );
+      REQUIRE( constructions == 1 );
+    }
+
+    SECTION("does nothing if already constructed")
+    {
+      inline_executor executor;
+      auto lazy_string = lazy::ConcurrentLazy<std::string>(std::string("hello world"));
+
+      *lazy_string;
+      lazy_string.prefetch(executor);
+
+      REQUIRE( executor.tasks == 0 );
+    }
+
+    SECTION("leaves an exception for the next access")
+    {
+      auto attempts = 0;
+      inline_executor executor;
+      auto lazy_string = lazy::ConcurrentLazy<std::string>([&attempts](){
+        if( ++attempts == 1 ) throw std::runtime_error("failed");
+        return std::make_tuple("hello world");
+      });
+
+      lazy_string.prefetch(executor);
+
+      REQUIRE_FALSE( lazy_string.is_initialized() );
+      REQUIRE( *lazy_string == "hello world" );
+      REQUIRE( attempts == 2 );
+    }
+  }
+
+
+  SECTION("ConcurrentLazy<T>(args...)")
+  {
+    SECTION("is constant-initialized and uninitialized")
+    {
+      static LAZY_CONSTINIT lazy::ConcurrentLazy<std::string> lazy_string;
+
+      REQUIRE_FALSE( lazy_string.is_initialized() );
+    }
+  }
+}
@@ -8,8 +8,64 @@
 #include "catch.hpp"
 #include <lazy/Lazy.hpp>
 
+#include <memory>
+#include <stdexcept>
 #include <tuple>
 #include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+  struct copy_counter
+  {
+    explicit copy_counter( int* copies ) : copies(copies){}
+    copy_counter( const copy_counter& other ) : copies(other.copies){ ++(*copies); }
+    copy_counter( copy_counter&& other ) noexcept : copies(other.copies){}
+
+    int* copies;
+  };
+
+  /// A copy_counter taken by a constructor that may throw
+  struct counter_holder
+  {
+    explicit counter_holder( copy_counter counter )
+      : counter(std::move(counter))
+    {
+
+    }
+
+    copy_counter counter;
+  };
+
+  /// A string whose construction throws the first time
+  struct throwing_text
+  {
+    throwing_text( const std::string& text, int* attempts )
+      : text(text)
+    {
+      if( (*attempts)++ == 0 ) throw std::runtime_error("first attempt");
+    }
+
+    std::string text;
+  };
+
+  struct answer_constructor
+  {
+    std::tuple<int> operator()() const
+    {
+      return std::make_tuple(42);
+    }
+  };
+
+  // These are all constant-initialized, and add no dynamic initializers
+  constexpr lazy::BasicLazy<int> g_lazy_int{};
+  constexpr lazy::BasicLazy<int,answer_constructor> g_lazy_answer{answer_constructor()};
+
+  LAZY_CONSTINIT lazy::Lazy<std::string> g_lazy_string;
+  LAZY_CONSTINIT lazy::CompactLazy<int> g_compact_int;
+
+} // anonymous namespace
 
 TEST_CASE("constructors")
 {
@@ -28,6 +84,22 @@ TEST_CASE("constructors")
   }
 
 
+  SECTION("Lazy<T>() at namespace scope")
+  {
+    SECTION("is constant-initialized and uninitialized")
+    {
+      REQUIRE_FALSE( g_lazy_string.is_initialized() );
+      REQUIRE_FALSE( g_compact_int.is_initialized() );
+    }
+
+    SECTION("default-constructs the underlying object on first use")
+    {
+      REQUIRE( g_lazy_string->empty() );
+      REQUIRE( g_lazy_string.retained_bytes() == 0 );
+    }
+  }
+
+
   SECTION("Lazy<T>(Func,Func)")
   {
     SECTION("creates an uninitialized lazy object")
@@ -42,6 +114,23 @@ TEST_CASE("constructors")
 
       REQUIRE_FALSE( lazy_string.is_initialized() );
     }
+
+    SECTION("calls the destruction function on destruction")
+    {
+      auto destroyed = false;
+      {
+        auto lazy_string = lazy::Lazy<std::string>([](){
+          return std::make_tuple(std::size_t(5),'a');
+        },[&destroyed](std::string&){
+          destroyed = true;
+        });
+        *lazy_string;
+
+        REQUIRE_FALSE( destroyed );
+      }
+
+      REQUIRE( destroyed );
+    }
   }
 
 
@@ -110,6 +199,34 @@ TEST_CASE("constructors")
 
       REQUIRE( lazy_new.is_initialized() );
     }
+
+    SECTION("constructs into its own storage")
+    {
+      auto lazy_original = new lazy::Lazy<std::string>("hello world");
+      auto lazy_new      = lazy::Lazy<std::string>(std::move(*lazy_original));
+      delete lazy_original;
+
+      REQUIRE( (*lazy_new) == "hello world" );
+    }
+
+    SECTION("is used when relocating in containers")
+    {
+      static_assert(std::is_nothrow_move_constructible<lazy::Lazy<std::string>>::value,
+                    "Lazy<T> must be nothrow-movable to be relocated by containers");
+
+      auto lazies = std::vector<lazy::Lazy<std::string>>();
+      for( auto i = 0; i < 100; ++i )
+      {
+        lazies.push_back(lazy::make_lazy<std::string>(std::size_t(i),'a'));
+      }
+
+      auto is_constructed = true;
+      for( auto i = 0u; i < lazies.size(); ++i )
+      {
+        is_constructed = is_constructed && (lazies[i]->size() == i);
+      }
+      REQUIRE( is_constructed );
+    }
   }
 
 
@@ -122,6 +239,145 @@ TEST_CASE("constructors")
 
       REQUIRE_FALSE( lazy_string.is_initialized() );
     }
+
+    SECTION("moves arguments into the constructor without copying")
+    {
+      auto copies = 0;
+      auto lazy_counter = lazy::make_lazy<copy_counter>(copy_counter(&copies));
+      auto moved = std::move(lazy_counter);
+      *moved;
+
+      REQUIRE( copies == 0 );
+    }
+
+    SECTION("moves arguments into a constructor that may throw without copying")
+    {
+      auto copies = 0;
+      auto lazy_holder = lazy::make_lazy<counter_holder>(copy_counter(&copies));
+      *lazy_holder;
+
+      REQUIRE( copies == 0 );
+    }
+
+    SECTION("accepts move-only arguments")
+    {
+      auto lazy_pointer = lazy::make_lazy<std::unique_ptr<int>>(std::unique_ptr<int>(new int(42)));
+
+      REQUIRE( **lazy_pointer == 42 );
+    }
+
+    SECTION("copies arguments that are lvalues")
+    {
+      auto vector = std::vector<int>(3,1);
+      auto lazy_vector = lazy::make_lazy<std::vector<int>>(vector);
+      *lazy_vector;
+
+      REQUIRE( vector.size() == 3 );
+      REQUIRE( lazy_vector->size() == 3 );
+    }
+
+    SECTION("retries construction with arguments that were not moved from")
+    {
+      auto attempts = 0;
+      auto lazy_text = lazy::make_lazy<throwing_text>(std::string("hello world"),&attempts);
+
+      REQUIRE_THROWS_AS( *lazy_text, const std::runtime_error& );
+      REQUIRE( lazy_text->text == "hello world" );
+    }
+
+    SECTION("throws bad_lazy_copy when copying move-only arguments")
+    {
+      auto lazy_pointer = lazy::make_lazy<std::shared_ptr<int>>(std::unique_ptr<int>(new int(42)));
+
+      REQUIRE_THROWS_AS( lazy::Lazy<std::shared_ptr<int>>{lazy_pointer}, const lazy::bad_lazy_copy& );
+    }
+
+    SECTION("copies once move-only arguments have been used")
+    {
+      auto lazy_pointer = lazy::make_lazy<std::shared_ptr<int>>(std::unique_ptr<int>(new int(42)));
+      *lazy_pointer;
+
+      auto copy = lazy_pointer;
+
+      REQUIRE( **copy == 42 );
+    }
+  }
+
+  //--------------------------------------------------------------------------
+  // BasicLazy<T,CtorFunc,DtorFunc>
+  //--------------------------------------------------------------------------
+
+  SECTION("BasicLazy<T>()")
+  {
+    SECTION("creates an uninitialized lazy object")
+    {
+      auto lazy_string = lazy::BasicLazy<std::string>();
+
+      REQUIRE_FALSE( lazy_string.is_initialized() );
+    }
+
+    SECTION("default-constructs the underlying object")
+    {
+      auto lazy_string = lazy::BasicLazy<std::string>();
+
+      REQUIRE( lazy_string->empty() );
+    }
+  }
+
+
+  SECTION("constexpr BasicLazy<T>")
+  {
+    SECTION("constructs on first use")
+    {
+      REQUIRE( *g_lazy_int == 0 );
+      REQUIRE( *g_lazy_answer == 42 );
+    }
+  }
+
+
+  SECTION("make_basic_lazy<T>(Func,Func)")
+  {
+    SECTION("creates an uninitialized lazy object")
+    {
+      auto lazy_string = lazy::make_basic_lazy<std::string>([](){
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      REQUIRE_FALSE( lazy_string.is_initialized() );
+    }
+
+    SECTION("constructs with the construction function")
+    {
+      auto lazy_string = lazy::make_basic_lazy<std::string>([](){
+        return std::make_tuple(std::size_t(5),'a');
+      });
+
+      REQUIRE( (*lazy_string) == "aaaaa" );
+    }
+
+    SECTION("calls the destruction function on destruction")
+    {
+      auto destroyed = false;
+      {
+        auto lazy_string = lazy::make_basic_lazy<std::string>([](){
+          return std::make_tuple(std::size_t(5),'a');
+        },[&destroyed](std::string&){
+          destroyed = true;
+        });
+        *lazy_string;
+      }
+
+      REQUIRE( destroyed );
+    }
+
+    SECTION("stores stateless functions without overhead")
+    {
+      auto lazy_int = lazy::make_basic_lazy<int>([](){
+        return std::make_tuple(5);
+      });
+
+      REQUIRE( sizeof(lazy_int) == sizeof(lazy::BasicLazy<int>) );
+    }
   }
 
   //--------------------------------------------------------------------------
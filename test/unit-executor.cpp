@@ -0,0 +1,142 @@
+/**
+ * \file unit-executor.cpp
+ *
+ * \brief Catch unit tests for running tasks on a WorkStealingExecutor
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+#include <lazy/AsyncLazy.hpp>
+#include <lazy/WorkStealingExecutor.hpp>
+#include <lazy/prefetch.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+  const auto task_count = 1000;
+
+  static_assert(lazy::detail::is_executor<lazy::WorkStealingExecutor>::value,
+                "A WorkStealingExecutor is an executor");
+  static_assert(!lazy::detail::is_executor<int>::value,
+                "An int is not an executor");
+
+} // anonymous namespace
+
+TEST_CASE("executor")
+{
+  SECTION("WorkStealingExecutor(std::size_t)")
+  {
+    SECTION("starts at least one thread")
+    {
+      lazy::WorkStealingExecutor executor(0);
+
+      REQUIRE( executor.thread_count() == 1u );
+    }
+
+    SECTION("runs every task before being destroyed")
+    {
+      std::atomic<int> runs(0);
+      {
+        lazy::WorkStealingExecutor executor(4);
+
+        for( auto i = 0; i < task_count; ++i ) {
+          executor.execute([&runs](){
+            ++runs;
+          });
+        }
+      }
+
+      REQUIRE( runs == task_count );
+    }
+
+    SECTION("runs the tasks submitted by tasks")
+    {
+      std::atomic<int> runs(0);
+      {
+        lazy::WorkStealingExecutor executor(4);
+
+        executor.execute([&](){
+          for( auto i = 0; i < task_count; ++i ) {
+            executor.execute([&runs](){
+              ++runs;
+            });
+          }
+        });
+      }
+
+      REQUIRE( runs == task_count );
+    }
+
+    SECTION("runs tasks of high priority first")
+    {
+      std::atomic<bool> released(false);
+      std::atomic<bool> blocked(false);
+      std::mutex mutex;
+      auto order = std::vector<int>();
+      {
+        lazy::WorkStealingExecutor executor(1);
+
+        executor.execute([&](){
+          blocked = true;
+          while( !released ) {
+            std::this_thread::yield();
+          }
+        });
+        while( !blocked ) {
+          std::this_thread::yield();
+        }
+
+        executor.execute([&](){
+          std::lock_guard<std::mutex> lock(mutex);
+          order.push_back(1);
+        });
+        executor.execute([&](){
+          std::lock_guard<std::mutex> lock(mutex);
+          order.push_back(2);
+        },lazy::WorkStealingExecutor::priority::high);
+
+        released = true;
+      }
+
+      REQUIRE( order.size() == 2u );
+      REQUIRE( order[0] == 2 );
+      REQUIRE( order[1] == 1 );
+    }
+  }
+
+
+  SECTION("default_executor()")
+  {
+    SECTION("is the same executor every time")
+    {
+      REQUIRE( &lazy::default_executor() == &lazy::default_executor() );
+      REQUIRE( lazy::default_executor().thread_count() >= 1u );
+    }
+
+    SECTION("constructs AsyncLazy values by default")
+    {
+      lazy::AsyncLazy<int> lazy_int([](){
+        return std::make_tuple(42);
+      });
+
+      REQUIRE( lazy_int.get() == 42 );
+    }
+
+    SECTION("prefetches ConcurrentLazy values by default")
+    {
+      // The prefetched construction may outlive this scope
+      static auto lazy_int = lazy::ConcurrentLazy<int>([](){
+        return std::make_tuple(42);
+      });
+
+      lazy::prefetch(lazy_int);
+
+      REQUIRE( *lazy_int == 42 );
+    }
+  }
+}
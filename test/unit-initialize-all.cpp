@@ -0,0 +1,159 @@
+/**
+ * \file unit-initialize-all.cpp
+ *
+ * \brief Catch unit tests for initializing many lazy objects in parallel
+ *        with initialize_all
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+#include <lazy/WorkStealingExecutor.hpp>
+#include <lazy/initialize_all.hpp>
+
+#include <atomic>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  const auto lazy_count = 100;
+
+  /// Makes \c lazy_count lazy integers, each counting its construction
+  std::vector<lazy::Lazy<int>> make_lazies( std::atomic<int>& constructions )
+  {
+    auto lazies = std::vector<lazy::Lazy<int>>();
+    lazies.reserve(lazy_count);
+    for( auto i = 0; i < lazy_count; ++i ) {
+      lazies.emplace_back([&constructions,i](){
+        ++constructions;
+        return std::make_tuple(i);
+      });
+    }
+    return lazies;
+  }
+
+} // anonymous namespace
+
+TEST_CASE("initialize_all")
+{
+  SECTION("initialize_all(Range&&,Executor&)")
+  {
+    SECTION("initializes every lazy object")
+    {
+      std::atomic<int> constructions(0);
+      auto lazies = make_lazies(constructions);
+      lazy::WorkStealingExecutor executor(4);
+
+      lazy::initialize_all(lazies,executor);
+
+      REQUIRE( constructions == lazy_count );
+      for( auto i = 0; i < lazy_count; ++i ) {
+        REQUIRE( lazies[i].is_initialized() );
+        REQUIRE( *lazies[i] == i );
+      }
+    }
+
+    SECTION("skips initialized lazy objects")
+    {
+      std::atomic<int> constructions(0);
+      auto lazies = make_lazies(constructions);
+      lazy::WorkStealingExecutor executor(4);
+
+      *lazies[0];
+      *lazies[1];
+      lazy::initialize_all(lazies,executor);
+
+      REQUIRE( constructions == lazy_count );
+    }
+
+    SECTION("does nothing for an empty range")
+    {
+      auto lazies = std::vector<lazy::Lazy<int>>();
+      lazy::WorkStealingExecutor executor(4);
+
+      lazy::initialize_all(lazies,executor);
+    }
+
+    SECTION("throws every exception from construction")
+    {
+      auto lazies = std::vector<lazy::ConcurrentLazy<std::string>>(lazy_count);
+      for( auto i = 0; i < lazy_count; i += 10 ) {
+        lazies[i] = lazy::ConcurrentLazy<std::string>([]() -> std::tuple<const char*> {
+          throw std::runtime_error("failed");
+        });
+      }
+      lazy::WorkStealingExecutor executor(4);
+
+      auto errors = std::size_t(0);
+      try {
+        lazy::initialize_all(lazies,executor);
+      } catch( const lazy::initialization_error& e ) {
+        errors = e.errors().size();
+      }
+
+      REQUIRE( errors == static_cast<std::size_t>(lazy_count / 10) );
+      for( auto i = 0; i < lazy_count; ++i ) {
+        REQUIRE( lazies[i].is_initialized() == (i % 10 != 0) );
+      }
+    }
+
+    SECTION("completes from a task on the only thread of the executor")
+    {
+      std::atomic<int> constructions(0);
+      std::atomic<bool> finished(false);
+      auto lazies = make_lazies(constructions);
+      {
+        lazy::WorkStealingExecutor executor(1);
+
+        executor.execute([&](){
+          lazy::initialize_all(lazies,executor);
+          finished = true;
+        });
+      }
+
+      REQUIRE( finished );
+      REQUIRE( constructions == lazy_count );
+    }
+  }
+
+
+  SECTION("initialize_all(Range&&)")
+  {
+    SECTION("initializes every lazy object on the default executor")
+    {
+      std::atomic<int> constructions(0);
+      auto lazies = make_lazies(constructions);
+
+      lazy::initialize_all(lazies);
+
+      REQUIRE( constructions == lazy_count );
+    }
+  }
+
+
+  SECTION("initialize_all(Range&&,Executor&,Visitor)")
+  {
+    SECTION("visits lazy objects of different types")
+    {
+      auto lazy_int    = lazy::Lazy<int>(42);
+      auto lazy_string = lazy::Lazy<std::string>(std::string("hello world"));
+      auto warmups     = std::vector<std::function<void()>>{
+        [&](){ *lazy_int; },
+        [&](){ *lazy_string; }
+      };
+      lazy::WorkStealingExecutor executor(4);
+
+      lazy::initialize_all(warmups,executor,[](const std::function<void()>& warmup){
+        warmup();
+      });
+
+      REQUIRE( lazy_int.is_initialized() );
+      REQUIRE( lazy_string.is_initialized() );
+    }
+  }
+}
@@ -0,0 +1,149 @@
+/**
+ * \file unit-layout.cpp
+ *
+ * \brief Catch unit tests for the memory footprint of Lazy
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+  constexpr std::size_t round_up( std::size_t size, std::size_t alignment )
+  {
+    return ((size + alignment - 1) / alignment) * alignment;
+  }
+
+  /// The expected size of an InlineLazy<T,InlineBytes>, for types no more
+  /// aligned than a pointer: the storage and flag, padded to a pointer,
+  /// followed by one pointer to the shared operations and the inline buffer
+  template<typename T, std::size_t InlineBytes>
+  constexpr std::size_t expected_size()
+  {
+    return round_up(sizeof(T) + 1, alignof(void*)) + sizeof(void*) +
+           round_up(InlineBytes < sizeof(void*) ? sizeof(void*) : InlineBytes, alignof(void*));
+  }
+
+  // Stateless functions take no space in a BasicLazy, and the flag fits
+  // in the padding of the T
+  static_assert(sizeof(lazy::BasicLazy<int>) == 2 * sizeof(int), "");
+  static_assert(sizeof(lazy::BasicLazy<char>) <= 3, "");
+
+  static_assert(sizeof(lazy::Lazy<int>) == expected_size<int,LAZY_DEFAULT_INLINE_BYTES>(), "");
+  static_assert(sizeof(lazy::Lazy<char>) == expected_size<char,LAZY_DEFAULT_INLINE_BYTES>(), "");
+  static_assert(sizeof(lazy::Lazy<std::string>) == expected_size<std::string,LAZY_DEFAULT_INLINE_BYTES>(), "");
+
+  static_assert(sizeof(lazy::CompactLazy<int>) == expected_size<int,sizeof(void*)>(), "");
+  static_assert(sizeof(lazy::CompactLazy<int>) == 3 * sizeof(void*) || sizeof(int) >= sizeof(void*), "");
+  static_assert(sizeof(lazy::InlineLazy<int,64>) == expected_size<int,64>(), "");
+
+  // The sizes listed in the README, for LP64 platforms with libstdc++
+#if defined(__LP64__) && defined(__GLIBCXX__) && _GLIBCXX_USE_CXX11_ABI
+  static_assert(sizeof(lazy::Lazy<char>) == 48, "");
+  static_assert(sizeof(lazy::Lazy<int>) == 48, "");
+  static_assert(sizeof(lazy::Lazy<double>) == 56, "");
+  static_assert(sizeof(lazy::Lazy<std::string>) == 80, "");
+
+  static_assert(sizeof(lazy::CompactLazy<char>) == 24, "");
+  static_assert(sizeof(lazy::CompactLazy<int>) == 24, "");
+  static_assert(sizeof(lazy::CompactLazy<double>) == 32, "");
+  static_assert(sizeof(lazy::CompactLazy<std::string>) == 56, "");
+
+  static_assert(sizeof(lazy::BasicLazy<char>) == 3, "");
+  static_assert(sizeof(lazy::BasicLazy<int>) == 8, "");
+  static_assert(sizeof(lazy::BasicLazy<double>) == 16, "");
+  static_assert(sizeof(lazy::BasicLazy<std::string>) == 40, "");
+#endif
+
+  // There is nothing to destroy for trivial types with the default
+  // destruction function, so the BasicLazy itself is trivially destructible
+  static_assert(std::is_trivially_destructible<lazy::BasicLazy<int>>::value, "");
+  static_assert(!std::is_trivially_destructible<lazy::BasicLazy<std::string>>::value, "");
+  static_assert(!std::is_trivially_destructible<lazy::BasicLazy<int,lazy::default_constructor<int>,void(*)(int&)>>::value, "");
+  static_assert(!std::is_trivially_destructible<lazy::Lazy<int>>::value, "");
+
+  // A cache-aligned policy pads each BasicLazy to whole cache lines
+  static_assert(alignof(lazy::BasicLazy<int,lazy::default_constructor<int>,lazy::default_destructor<int>,lazy::cache_aligned<>>) == LAZY_CACHE_LINE_SIZE, "");
+  static_assert(sizeof(lazy::Lazy<char,lazy::cache_aligned<>>) % LAZY_CACHE_LINE_SIZE == 0, "");
+  static_assert(sizeof(lazy::Lazy<char,lazy::cache_aligned<lazy::double_checked>>) % LAZY_CACHE_LINE_SIZE == 0, "");
+  static_assert(std::is_trivially_destructible<lazy::BasicLazy<int,lazy::default_constructor<int>,lazy::default_destructor<int>,lazy::cache_aligned<>>>::value, "");
+
+} // anonymous namespace
+
+TEST_CASE("layout")
+{
+  SECTION("CompactLazy<T>")
+  {
+    SECTION("stores small values without allocating")
+    {
+      auto lazy_int = lazy::CompactLazy<int>(42);
+
+      REQUIRE( lazy_int.retained_bytes() == sizeof(int) );
+      REQUIRE( *lazy_int == 42 );
+      REQUIRE( lazy_int.retained_bytes() == 0 );
+    }
+
+    SECTION("stores larger functions on the heap")
+    {
+      auto lazy_string = lazy::CompactLazy<std::string>(std::string("Hello world"));
+
+      REQUIRE( *lazy_string == "Hello world" );
+    }
+  }
+
+  SECTION("BasicLazy<T>")
+  {
+    SECTION("reinitializes a trivially destructible lazy object")
+    {
+      auto lazy_int = lazy::BasicLazy<int>();
+      *lazy_int;
+
+      auto copy = lazy_int;
+      copy = 7;
+      lazy_int = copy;
+
+      REQUIRE( *lazy_int == 7 );
+    }
+  }
+
+  SECTION("Lazy<T,cache_aligned<Policy>>")
+  {
+    SECTION("places each element of an array on its own cache lines")
+    {
+      lazy::Lazy<int,lazy::cache_aligned<lazy::double_checked>> slots[4];
+
+      for( auto& slot : slots ) {
+        auto address = reinterpret_cast<std::uintptr_t>(&slot);
+
+        REQUIRE( address % LAZY_CACHE_LINE_SIZE == 0 );
+      }
+
+      *slots[1] = 42;
+
+      REQUIRE_FALSE( slots[0].is_initialized() );
+      REQUIRE( *slots[1] == 42 );
+    }
+  }
+
+  SECTION("Lazy<T>(Func,Func)")
+  {
+    SECTION("retains only the destruction function after initialization")
+    {
+      auto count       = 0;
+      auto lazy_string = lazy::Lazy<std::string>([](){
+        return std::make_tuple(std::size_t(5),'a');
+      },[&count](std::string&){
+        ++count;
+      });
+      *lazy_string;
+
+      REQUIRE( lazy_string.retained_bytes() == sizeof(int*) );
+    }
+  }
+}
@@ -46,6 +46,33 @@ TEST_CASE("operators")
 
       REQUIRE(is_swapped);
     }
+
+    SECTION("swaps an initialized lazy with an uninitialized lazy")
+    {
+      lazy::Lazy<std::string> lazy_string1("Hello world");
+      lazy::Lazy<std::string> lazy_string2("Goodbye world");
+      *lazy_string1;
+
+      lazy_string1.swap(lazy_string2);
+
+      REQUIRE_FALSE(lazy_string1.is_initialized());
+      REQUIRE(lazy_string2.is_initialized());
+      REQUIRE((*lazy_string1) == "Goodbye world");
+      REQUIRE((*lazy_string2) == "Hello world");
+    }
+
+    SECTION("swaps uninitialized lazies without initializing")
+    {
+      lazy::Lazy<std::string> lazy_string1("Hello world");
+      lazy::Lazy<std::string> lazy_string2("Goodbye world");
+
+      lazy_string1.swap(lazy_string2);
+
+      REQUIRE_FALSE(lazy_string1.is_initialized());
+      REQUIRE_FALSE(lazy_string2.is_initialized());
+      REQUIRE((*lazy_string1) == "Goodbye world");
+      REQUIRE((*lazy_string2) == "Hello world");
+    }
   }
 
 
@@ -92,6 +119,58 @@ TEST_CASE("operators")
   }
 
 
+  SECTION("Lazy<T>::try_get()")
+  {
+    SECTION("returns nullptr without initializing")
+    {
+      lazy::Lazy<std::string> lazy_string("Hello world");
+
+      REQUIRE(lazy_string.try_get() == nullptr);
+      REQUIRE_FALSE(lazy_string.is_initialized());
+    }
+
+    SECTION("retrieves pointer to initialized lazy instance")
+    {
+      lazy::Lazy<std::string> lazy_string("Hello world");
+      *lazy_string;
+
+      REQUIRE(lazy_string.try_get() == lazy_string.get());
+    }
+  }
+
+
+  SECTION("Lazy<T>::unchecked_get()")
+  {
+    SECTION("retrieves pointer to initialized lazy instance")
+    {
+      lazy::Lazy<std::string> lazy_string("Hello world");
+      *lazy_string;
+
+      REQUIRE(lazy_string.unchecked_get() == lazy_string.get());
+    }
+  }
+
+
+  SECTION("Lazy<T>::value_or(U&&)")
+  {
+    SECTION("returns fallback without initializing")
+    {
+      lazy::Lazy<std::string> lazy_string("Hello world");
+
+      REQUIRE(lazy_string.value_or("Goodbye world") == "Goodbye world");
+      REQUIRE_FALSE(lazy_string.is_initialized());
+    }
+
+    SECTION("returns value of initialized lazy")
+    {
+      lazy::Lazy<std::string> lazy_string("Hello world");
+      *lazy_string;
+
+      REQUIRE(lazy_string.value_or("Goodbye world") == "Hello world");
+    }
+  }
+
+
   SECTION("Lazy<T>::operator*()")
   {
     SECTION("lazy initializes entry")
@@ -136,4 +215,30 @@ TEST_CASE("operators")
       REQUIRE(*str == "Hello world");
     }
   }
+
+
+  SECTION("Lazy<T>::retained_bytes()")
+  {
+    SECTION("is non-zero for uninitialized lazy with stored value")
+    {
+      lazy::Lazy<std::string> lazy_string(std::string("Hello world"));
+
+      REQUIRE(lazy_string.retained_bytes() >= sizeof(std::string));
+    }
+
+    SECTION("is zero after initialization")
+    {
+      lazy::Lazy<std::string> lazy_string(std::string("Hello world"));
+      *lazy_string;
+
+      REQUIRE(lazy_string.retained_bytes() == 0);
+    }
+
+    SECTION("is zero for stateless construction functions")
+    {
+      auto lazy_string = lazy::BasicLazy<std::string>();
+
+      REQUIRE(lazy_string.retained_bytes() == 0);
+    }
+  }
 }
@@ -0,0 +1,137 @@
+/**
+ * \file unit-racy.cpp
+ *
+ * \brief Catch unit tests for publishing the value of a RacyLazy
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+#include <lazy/RacyLazy.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  const auto thread_count = 8;
+
+  /// A type that can be neither copied nor moved
+  struct immovable
+  {
+    explicit immovable( int value ) : value(value){}
+    immovable( const immovable& ) = delete;
+    immovable& operator=( const immovable& ) = delete;
+
+    int value;
+  };
+
+} // anonymous namespace
+
+TEST_CASE("racy")
+{
+  SECTION("RacyLazy<T>()")
+  {
+    SECTION("is constant-initialized and uninitialized")
+    {
+      static LAZY_CONSTINIT lazy::RacyLazy<std::string> lazy_string;
+
+      REQUIRE_FALSE( lazy_string.is_initialized() );
+      REQUIRE( lazy_string.try_get() == nullptr );
+    }
+  }
+
+
+  SECTION("RacyLazy<T>(Func)")
+  {
+    SECTION("constructs on first access")
+    {
+      auto constructions = 0;
+      lazy::RacyLazy<immovable> lazy_value([&constructions](){
+        return std::make_tuple(++constructions);
+      });
+
+      REQUIRE( constructions == 0 );
+      REQUIRE( lazy_value->value == 1 );
+      REQUIRE( lazy_value->value == 1 );
+      REQUIRE( lazy_value.try_get() == lazy_value.get() );
+    }
+
+    SECTION("gives every thread the published value")
+    {
+      lazy::RacyLazy<int> lazy_int([](){
+        return std::make_tuple(42);
+      });
+
+      std::atomic<int> ready(0);
+      std::vector<int*> values(thread_count);
+      auto threads = std::vector<std::thread>();
+      for( auto i = 0; i < thread_count; ++i ) {
+        threads.emplace_back([&,i](){
+          ++ready;
+          while( ready < thread_count ) {
+            std::this_thread::yield();
+          }
+          values[i] = lazy_int.get();
+        });
+      }
+      for( auto& thread : threads ) {
+        thread.join();
+      }
+
+      for( auto value : values ) {
+        REQUIRE( value == lazy_int.get() );
+      }
+    }
+  }
+
+
+  SECTION("RacyLazy<T>(Func,Func)")
+  {
+    SECTION("destroys the values that lose the race")
+    {
+      std::atomic<int> constructions(0);
+      std::atomic<int> destructions(0);
+      {
+        lazy::RacyLazy<int> lazy_int([&constructions](){
+          return std::make_tuple(++constructions);
+        },[&destructions](int&){
+          ++destructions;
+        });
+
+        std::atomic<int> ready(0);
+        auto threads = std::vector<std::thread>();
+        for( auto i = 0; i < thread_count; ++i ) {
+          threads.emplace_back([&](){
+            ++ready;
+            while( ready < thread_count ) {
+              std::this_thread::yield();
+            }
+            *lazy_int;
+          });
+        }
+        for( auto& thread : threads ) {
+          thread.join();
+        }
+
+        REQUIRE( destructions == constructions - 1 );
+      }
+
+      REQUIRE( destructions == constructions );
+    }
+  }
+
+
+  SECTION("RacyLazy<T>(const T&)")
+  {
+    SECTION("copies the value")
+    {
+      lazy::RacyLazy<std::string> lazy_string(std::string("aaa"));
+
+      REQUIRE( *lazy_string == "aaa" );
+    }
+  }
+}
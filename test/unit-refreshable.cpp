@@ -0,0 +1,233 @@
+/**
+ * \file unit-refreshable.cpp
+ *
+ * \brief Catch unit tests for refreshing and invalidating a RefreshableLazy
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+#include <lazy/RefreshableLazy.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  const auto thread_count = 4;
+  const auto refreshes    = 200;
+
+  /// A value that records whether it has been destroyed
+  struct tracked
+  {
+    explicit tracked( int generation )
+      : generation(generation),
+        alive(true)
+    {
+
+    }
+
+    ~tracked()
+    {
+      alive = false;
+    }
+
+    int               generation;
+    std::atomic<bool> alive;
+  };
+
+} // anonymous namespace
+
+TEST_CASE("refreshable")
+{
+  SECTION("RefreshableLazy<T>(Func)")
+  {
+    SECTION("does not construct until accessed")
+    {
+      std::atomic<int> constructions(0);
+      lazy::RefreshableLazy<int> lazy_int([&constructions](){
+        return std::make_tuple(++constructions);
+      });
+
+      REQUIRE_FALSE( lazy_int.is_initialized() );
+      REQUIRE( constructions == 0 );
+
+      auto value = *lazy_int.get();
+
+      REQUIRE( lazy_int.is_initialized() );
+      REQUIRE( value == 1 );
+      REQUIRE( constructions == 1 );
+    }
+
+    SECTION("constructs once for concurrent first accesses")
+    {
+      std::atomic<int> constructions(0);
+      lazy::RefreshableLazy<int> lazy_int([&constructions](){
+        return std::make_tuple(++constructions);
+      });
+
+      auto threads = std::vector<std::thread>();
+      for( auto i = 0; i < thread_count; ++i ) {
+        threads.emplace_back([&](){
+          *lazy_int.get();
+        });
+      }
+      for( auto& thread : threads ) {
+        thread.join();
+      }
+
+      REQUIRE( constructions == 1 );
+    }
+  }
+
+
+  SECTION("refresh")
+  {
+    SECTION("publishes a newly constructed value")
+    {
+      auto generation = 0;
+      lazy::RefreshableLazy<int> lazy_int([&generation](){
+        return std::make_tuple(++generation);
+      });
+
+      auto first = *lazy_int.get();
+      lazy_int.refresh();
+      auto second = *lazy_int.get();
+
+      REQUIRE( first == 1 );
+      REQUIRE( second == 2 );
+    }
+
+    SECTION("keeps the current value if construction throws")
+    {
+      auto fail = false;
+      lazy::RefreshableLazy<std::string> lazy_string([&fail](){
+        if( fail ) throw std::runtime_error("refresh failed");
+        return std::make_tuple("aaa");
+      });
+
+      lazy_string.get();
+      fail = true;
+
+      REQUIRE_THROWS_AS( lazy_string.refresh(), const std::runtime_error& );
+      REQUIRE( *lazy_string.get() == "aaa" );
+    }
+
+    SECTION("keeps the old value alive for readers")
+    {
+      std::atomic<int> generation(0);
+      std::atomic<int> destructions(0);
+      lazy::RefreshableLazy<tracked> lazy_value([&generation](){
+        return std::make_tuple(++generation);
+      },[&destructions](tracked&){
+        ++destructions;
+      });
+
+      std::atomic<bool> taken(false);
+      std::atomic<bool> refreshed(false);
+      std::atomic<bool> alive(false);
+      std::atomic<int> old_generation(0);
+
+      std::thread reader([&](){
+        auto snapshot = lazy_value.get();
+        taken = true;
+        while( !refreshed ) {
+          std::this_thread::yield();
+        }
+        old_generation = snapshot->generation;
+        alive = snapshot->alive.load();
+      });
+
+      while( !taken ) {
+        std::this_thread::yield();
+      }
+      std::thread writer([&](){
+        lazy_value.refresh();
+      });
+
+      // The writer can't finish until the reader has released its snapshot
+      while( lazy_value.get()->generation != 2 ) {
+        std::this_thread::yield();
+      }
+      refreshed = true;
+      writer.join();
+      reader.join();
+
+      REQUIRE( old_generation == 1 );
+      REQUIRE( alive );
+      REQUIRE( destructions == 1 );
+    }
+
+    SECTION("never exposes a destroyed value to concurrent readers")
+    {
+      std::atomic<int> generation(0);
+      lazy::RefreshableLazy<tracked> lazy_value([&generation](){
+        return std::make_tuple(++generation);
+      });
+
+      std::atomic<bool> done(false);
+      std::atomic<int> destroyed_reads(0);
+      auto readers = std::vector<std::thread>();
+      for( auto i = 0; i < thread_count; ++i ) {
+        readers.emplace_back([&](){
+          while( !done ) {
+            if( !lazy_value->alive ) ++destroyed_reads;
+          }
+        });
+      }
+      for( auto i = 0; i < refreshes; ++i ) {
+        lazy_value.refresh();
+        if( i % 10 == 0 ) lazy_value.invalidate();
+      }
+      done = true;
+      for( auto& reader : readers ) {
+        reader.join();
+      }
+
+      REQUIRE( destroyed_reads == 0 );
+    }
+  }
+
+
+  SECTION("invalidate")
+  {
+    SECTION("destroys the value, and constructs a new one on next access")
+    {
+      auto constructions = 0;
+      auto destructions  = 0;
+      lazy::RefreshableLazy<int> lazy_int([&constructions](){
+        return std::make_tuple(++constructions);
+      },[&destructions](int&){
+        ++destructions;
+      });
+
+      lazy_int.get();
+      lazy_int.invalidate();
+
+      REQUIRE_FALSE( lazy_int.is_initialized() );
+      REQUIRE( destructions == 1 );
+
+      auto value = *lazy_int.get();
+
+      REQUIRE( value == 2 );
+    }
+  }
+
+
+  SECTION("RefreshableLazy<T>(const T&)")
+  {
+    SECTION("copies the value on every refresh")
+    {
+      lazy::RefreshableLazy<std::string> lazy_string(std::string("aaa"));
+
+      lazy_string.refresh();
+      lazy_string.refresh();
+
+      REQUIRE( *lazy_string.get() == "aaa" );
+    }
+  }
+}
@@ -0,0 +1,223 @@
+/**
+ * \file unit-sentinel.cpp
+ *
+ * \brief Catch unit tests for BasicLazy objects that encode their state in a
+ *        sentinel value
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  const auto thread_count = 8;
+
+  using handle_sentinel = lazy::value_sentinel<int,-1>;
+
+  std::atomic<int> g_opened(0);
+  std::atomic<int> g_closed(0);
+
+  /// Opens a handle, numbered from 1
+  struct open_handle
+  {
+    std::tuple<int> operator()() const
+    {
+      return std::make_tuple(++g_opened);
+    }
+  };
+
+  /// Closes a handle
+  struct close_handle
+  {
+    void operator()( int& ) const
+    {
+      ++g_closed;
+    }
+  };
+
+  using lazy_handle = lazy::BasicLazy<int,open_handle,close_handle,lazy::atomic_sentinel<handle_sentinel>>;
+
+  int g_live_names = 0;
+
+  /// A name that counts the instances alive, with 0 as its sentinel
+  struct counted_name
+  {
+    explicit counted_name( int id ) : id(id){ ++g_live_names; }
+    counted_name( const counted_name& other ) : id(other.id){ ++g_live_names; }
+    ~counted_name(){ --g_live_names; }
+
+    int id;
+  };
+
+  struct counted_name_sentinel
+  {
+    static counted_name empty(){ return counted_name(0); }
+    static bool is_empty( const counted_name& name ) noexcept{ return name.id == 0; }
+  };
+
+  using lazy_name = lazy::Lazy<counted_name,lazy::sentinel<counted_name_sentinel>>;
+
+  //--------------------------------------------------------------------------
+
+  static_assert(sizeof(lazy::Lazy<int*,lazy::sentinel<>>) + sizeof(void*) == sizeof(lazy::Lazy<int*>),
+                "A sentinel Lazy stores no initialized flag");
+  static_assert(sizeof(lazy_handle) <= 2 * sizeof(int),
+                "An atomic sentinel BasicLazy stores no initialized flag");
+
+#if __cplusplus > 201703L
+  static_assert(sizeof(lazy::BasicLazy<int*,lazy::default_constructor<int*>,lazy::default_destructor<int*>,lazy::sentinel<>>) == sizeof(int*),
+                "A sentinel BasicLazy with empty functions is no larger than T");
+  static_assert(sizeof(lazy_handle) == sizeof(int),
+                "A sentinel BasicLazy with empty functions is no larger than T");
+#endif
+
+} // anonymous namespace
+
+TEST_CASE("sentinel")
+{
+  SECTION("sentinel<>")
+  {
+    SECTION("is uninitialized while holding nullptr")
+    {
+      static LAZY_CONSTINIT lazy::Lazy<int*,lazy::sentinel<>> lazy_pointer;
+
+      REQUIRE_FALSE( lazy_pointer.is_initialized() );
+    }
+
+    SECTION("is initialized once constructed")
+    {
+      auto value = 5;
+      auto constructions = 0;
+      lazy::Lazy<int*,lazy::sentinel<>> lazy_pointer([&](){
+        ++constructions;
+        return std::make_tuple(&value);
+      });
+
+      REQUIRE( *lazy_pointer == &value );
+      REQUIRE( *lazy_pointer == &value );
+      REQUIRE( lazy_pointer.is_initialized() );
+      REQUIRE( constructions == 1 );
+    }
+
+    SECTION("constructs again after constructing the sentinel")
+    {
+      auto value = 5;
+      auto constructions = 0;
+      lazy::Lazy<int*,lazy::sentinel<>> lazy_pointer([&](){
+        return std::make_tuple(++constructions == 1 ? nullptr : &value);
+      });
+
+      REQUIRE( *lazy_pointer == nullptr );
+      REQUIRE_FALSE( lazy_pointer.is_initialized() );
+      REQUIRE( *lazy_pointer == &value );
+      REQUIRE( lazy_pointer.is_initialized() );
+      REQUIRE( constructions == 2 );
+    }
+
+    SECTION("is uninitialized after moving out of a unique_ptr")
+    {
+      lazy::Lazy<std::unique_ptr<int>,lazy::sentinel<>> lazy_unique([](){
+        return std::make_tuple(new int(5));
+      });
+
+      REQUIRE( **lazy_unique == 5 );
+      REQUIRE( lazy_unique.is_initialized() );
+
+      auto value = std::move(*lazy_unique);
+
+      REQUIRE_FALSE( lazy_unique.is_initialized() );
+      REQUIRE( *value == 5 );
+    }
+
+    SECTION("is uninitialized after assigning the sentinel")
+    {
+      auto value = 5;
+      lazy::Lazy<int*,lazy::sentinel<>> lazy_pointer(&value);
+
+      REQUIRE( *lazy_pointer == &value );
+
+      lazy_pointer = static_cast<int*>(nullptr);
+
+      REQUIRE_FALSE( lazy_pointer.is_initialized() );
+    }
+
+    SECTION("destroys the sentinel that the T replaces")
+    {
+      {
+        lazy_name name([](){ return std::make_tuple(5); });
+
+        REQUIRE( name->id == 5 );
+        REQUIRE( g_live_names == 1 );
+      }
+      REQUIRE( g_live_names == 0 );
+    }
+
+    SECTION("keeps the sentinel if constructing the T throws")
+    {
+      {
+        auto attempts = 0;
+        lazy_name name([&attempts](){
+          if( ++attempts == 1 ) throw std::runtime_error("first attempt");
+          return std::make_tuple(5);
+        });
+
+        REQUIRE_THROWS_AS( *name, const std::runtime_error& );
+        REQUIRE_FALSE( name.is_initialized() );
+        REQUIRE( g_live_names == 1 );
+        REQUIRE( name->id == 5 );
+      }
+      REQUIRE( g_live_names == 0 );
+    }
+  }
+
+
+  SECTION("atomic_sentinel<Traits>")
+  {
+    SECTION("is constant-initialized and uninitialized")
+    {
+      static LAZY_CONSTINIT lazy_handle handle;
+
+      REQUIRE_FALSE( handle.is_initialized() );
+    }
+
+    SECTION("closes the handles that lose the race")
+    {
+      g_opened = 0;
+      g_closed = 0;
+      {
+        lazy_handle handle;
+
+        std::atomic<int> ready(0);
+        std::vector<int> values(thread_count);
+        auto threads = std::vector<std::thread>();
+        for( auto i = 0; i < thread_count; ++i ) {
+          threads.emplace_back([&,i](){
+            ++ready;
+            while( ready < thread_count ) {
+              std::this_thread::yield();
+            }
+            values[i] = *handle;
+          });
+        }
+        for( auto& thread : threads ) {
+          thread.join();
+        }
+
+        for( auto value : values ) {
+          REQUIRE( value == *handle );
+        }
+        REQUIRE( g_closed == g_opened - 1 );
+      }
+
+      REQUIRE( g_closed == g_opened );
+    }
+  }
+}
@@ -0,0 +1,189 @@
+/**
+ * \file unit-sharded.cpp
+ *
+ * \brief Catch unit tests for the per-CPU shards of ShardedLazy
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+#include <lazy/ShardedLazy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  const auto thread_count = 4;
+  const auto increments   = 1000;
+
+} // anonymous namespace
+
+TEST_CASE("sharded")
+{
+  SECTION("ShardedLazy<T>()")
+  {
+    SECTION("has a power of two shards")
+    {
+      lazy::ShardedLazy<int> lazy_int;
+
+      auto count = lazy_int.shard_count();
+
+      REQUIRE( count != 0 );
+      REQUIRE( (count & (count - 1)) == 0 );
+    }
+
+    SECTION("does not construct until accessed")
+    {
+      lazy::ShardedLazy<int> lazy_int;
+
+      auto shards = lazy_int.combine(0,[]( int count, int& ){
+        return count + 1;
+      });
+
+      REQUIRE( shards == 0 );
+    }
+
+    SECTION("aligns each shard to a cache line")
+    {
+      lazy::ShardedLazy<char> lazy_char;
+
+      auto address = reinterpret_cast<std::uintptr_t>(lazy_char.get());
+
+      REQUIRE( address % LAZY_CACHE_LINE_SIZE == 0 );
+    }
+  }
+
+
+  SECTION("ShardedLazy<T>(shards)")
+  {
+    SECTION("has the given number of shards")
+    {
+      lazy::ShardedLazy<int> lazy_int(lazy::shards(16));
+
+      REQUIRE( lazy_int.shard_count() == 16 );
+    }
+
+    SECTION("rounds the number of shards up to a power of two")
+    {
+      lazy::ShardedLazy<int> lazy_int(lazy::shards(5));
+      lazy::ShardedLazy<int> lazy_single(lazy::shards(0));
+
+      REQUIRE( lazy_int.shard_count() == 8 );
+      REQUIRE( lazy_single.shard_count() == 1 );
+    }
+  }
+
+
+  SECTION("ShardedLazy<T>(shards,Func)")
+  {
+    SECTION("constructs the accessed shard with the function")
+    {
+      lazy::ShardedLazy<int> lazy_int(lazy::shards(2),[](){
+        return std::make_tuple(42);
+      });
+
+      REQUIRE( lazy_int.shard_count() == 2 );
+      REQUIRE( *lazy_int == 42 );
+    }
+  }
+
+
+  SECTION("ShardedLazy<T>(Func)")
+  {
+    SECTION("constructs only the shards that are accessed")
+    {
+      std::atomic<int> constructions(0);
+      lazy::ShardedLazy<int> lazy_int([&constructions](){
+        return std::make_tuple(++constructions);
+      });
+
+      *lazy_int;
+
+      auto shards = lazy_int.combine(0,[]( int count, int& ){
+        return count + 1;
+      });
+
+      REQUIRE( constructions >= 1 );
+      REQUIRE( shards == constructions );
+      REQUIRE( static_cast<std::size_t>(constructions) <= lazy_int.shard_count() );
+    }
+
+    SECTION("combines the shards of every thread")
+    {
+      lazy::ShardedLazy<std::atomic<int>> counter([](){
+        return std::make_tuple(0);
+      });
+
+      auto threads = std::vector<std::thread>();
+      for( auto i = 0; i < thread_count; ++i ) {
+        threads.emplace_back([&](){
+          for( auto j = 0; j < increments; ++j ) {
+            ++*counter;
+          }
+        });
+      }
+      for( auto& thread : threads ) {
+        thread.join();
+      }
+
+      auto total = counter.combine(0,[]( int sum, std::atomic<int>& count ){
+        return sum + count.load();
+      });
+
+      REQUIRE( total == thread_count * increments );
+    }
+  }
+
+
+  SECTION("ShardedLazy<T>(Func,Func)")
+  {
+    SECTION("destroys each constructed shard on destruction")
+    {
+      std::atomic<int> constructions(0);
+      std::atomic<int> destructions(0);
+      {
+        lazy::ShardedLazy<int> lazy_int([&constructions](){
+          return std::make_tuple(++constructions);
+        },[&destructions](int&){
+          ++destructions;
+        });
+
+        *lazy_int;
+      }
+
+      REQUIRE( destructions == constructions );
+    }
+  }
+
+
+  SECTION("ShardedLazy<T>(const T&)")
+  {
+    SECTION("copies the value into each shard")
+    {
+      lazy::ShardedLazy<int> lazy_int(42);
+
+      REQUIRE( *lazy_int == 42 );
+    }
+  }
+
+  SECTION("current_thread_index")
+  {
+    SECTION("spreads threads over the low bits")
+    {
+      auto shards = std::vector<std::size_t>();
+      for( auto i = 0; i < thread_count; ++i ) {
+        std::thread([&shards](){
+          shards.push_back(lazy::detail::current_thread_index() % thread_count);
+        }).join();
+      }
+      std::sort(shards.begin(), shards.end());
+
+      REQUIRE( std::unique(shards.begin(), shards.end()) == shards.end() );
+    }
+  }
+}
@@ -0,0 +1,229 @@
+/**
+ * \file unit-thread-local.cpp
+ *
+ * \brief Catch unit tests for the per-thread instances of ThreadLocalLazy
+ *
+ * \author Matthew Rodusek (matthew.rodusek@gmail.com)
+ */
+#include "catch.hpp"
+#include <lazy/Lazy.hpp>
+#include <lazy/ThreadLocalLazy.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+  const auto thread_count = 4;
+
+  /// Runs \p function on \c thread_count threads, joining them all
+  template<typename Function>
+  void run_on_threads( Function function )
+  {
+    auto threads = std::vector<std::thread>();
+
+    for( auto i = 0; i < thread_count; ++i ) {
+      threads.emplace_back(function);
+    }
+    for( auto& thread : threads ) {
+      thread.join();
+    }
+  }
+
+} // anonymous namespace
+
+TEST_CASE("thread_local")
+{
+  SECTION("ThreadLocalLazy<T>(Func)")
+  {
+    SECTION("constructs one instance per thread")
+    {
+      std::atomic<int> constructions(0);
+      lazy::ThreadLocalLazy<int> lazy_int([&constructions](){
+        return std::make_tuple(++constructions);
+      });
+
+      *lazy_int;
+      auto main_value = *lazy_int;
+      run_on_threads([&](){
+        *lazy_int;
+        *lazy_int;
+      });
+
+      REQUIRE( constructions == thread_count + 1 );
+      REQUIRE( *lazy_int == main_value );
+    }
+
+    SECTION("gives each thread its own instance")
+    {
+      lazy::ThreadLocalLazy<int> lazy_int([](){
+        return std::make_tuple(0);
+      });
+
+      *lazy_int = 42;
+      run_on_threads([&](){
+        *lazy_int += 1;
+      });
+
+      REQUIRE( *lazy_int == 42 );
+    }
+
+    SECTION("does not construct until accessed")
+    {
+      std::atomic<int> constructions(0);
+      lazy::ThreadLocalLazy<int> lazy_int([&constructions](){
+        return std::make_tuple(++constructions);
+      });
+
+      std::atomic<int> initialized(0);
+      run_on_threads([&](){
+        if( lazy_int.is_initialized() ) ++initialized;
+      });
+
+      REQUIRE( initialized == 0 );
+      REQUIRE( lazy_int.try_get() == nullptr );
+      REQUIRE( constructions == 0 );
+    }
+  }
+
+
+  SECTION("ThreadLocalLazy<T>(Func,Func)")
+  {
+    SECTION("destroys each instance when its thread exits")
+    {
+      std::atomic<int> destructions(0);
+      lazy::ThreadLocalLazy<int> lazy_int([](){
+        return std::make_tuple(1);
+      },[&destructions](int&){
+        ++destructions;
+      });
+
+      run_on_threads([&](){
+        *lazy_int;
+      });
+
+      REQUIRE( destructions == thread_count );
+    }
+
+    SECTION("destroys the remaining instances on destruction")
+    {
+      std::atomic<int> destructions(0);
+      {
+        lazy::ThreadLocalLazy<int> lazy_int([](){
+          return std::make_tuple(1);
+        },[&destructions](int&){
+          ++destructions;
+        });
+
+        *lazy_int;
+      }
+
+      REQUIRE( destructions == 1 );
+    }
+
+    SECTION("lets a destruction function access another instance at thread exit")
+    {
+      std::atomic<int> constructions(0);
+      std::atomic<int> destructions(0);
+      std::atomic<int> accesses(0);
+      lazy::ThreadLocalLazy<int> other([&constructions](){
+        ++constructions;
+        return std::make_tuple(42);
+      },[&destructions](int&){
+        ++destructions;
+      });
+      lazy::ThreadLocalLazy<int> lazy_int([](){
+        return std::make_tuple(1);
+      },[&](int&){
+        if( *other == 42 ) ++accesses;
+      });
+
+      run_on_threads([&](){
+        *other;
+        *lazy_int;
+      });
+
+      REQUIRE( accesses == thread_count );
+      REQUIRE( destructions == constructions );
+    }
+  }
+
+
+  SECTION("ThreadLocalLazy<T>(const T&)")
+  {
+    SECTION("copies the value for each thread")
+    {
+      lazy::ThreadLocalLazy<std::string> lazy_string(std::string("aaa"));
+
+      std::atomic<int> mismatches(0);
+      run_on_threads([&](){
+        *lazy_string += "b";
+        if( *lazy_string != "aaab" ) ++mismatches;
+      });
+
+      REQUIRE( *lazy_string == "aaa" );
+      REQUIRE( mismatches == 0 );
+    }
+  }
+
+
+  SECTION("for_each_instance")
+  {
+    SECTION("visits the instance of every thread that constructed one")
+    {
+      lazy::ThreadLocalLazy<std::atomic<int>> counter([](){
+        return std::make_tuple(0);
+      });
+
+      std::atomic<int> ready(0);
+      std::atomic<bool> done(false);
+      auto threads = std::vector<std::thread>();
+      for( auto i = 0; i < thread_count; ++i ) {
+        threads.emplace_back([&](){
+          *counter += 5;
+          ++ready;
+          while( !done ) {
+            std::this_thread::yield();
+          }
+        });
+      }
+      while( ready < thread_count ) {
+        std::this_thread::yield();
+      }
+
+      auto instances = 0;
+      auto total     = 0;
+      counter.for_each_instance([&]( std::atomic<int>& count ){
+        ++instances;
+        total += count;
+      });
+
+      done = true;
+      for( auto& thread : threads ) {
+        thread.join();
+      }
+
+      REQUIRE( instances == thread_count );
+      REQUIRE( total == thread_count * 5 );
+    }
+
+    SECTION("no longer visits the instances of exited threads")
+    {
+      lazy::ThreadLocalLazy<int> lazy_int;
+
+      run_on_threads([&](){
+        *lazy_int;
+      });
+
+      auto instances = 0;
+      lazy_int.for_each_instance([&]( int& ){
+        ++instances;
+      });
+
+      REQUIRE( instances == 0 );
+    }
+  }
+}